@@ -28,11 +28,33 @@ namespace SPH {
 	//=================================================================================================//
 	void  LevelSetDataPackage::initializeBasicData(Shape& shape)
 	{
+		if (!shape.isProbedInBatches())
+		{
+			for (int i = 0; i != PackageSize(); ++i)
+				for (int j = 0; j != PackageSize(); ++j)
+				{
+					Vec2d position = data_lower_bound_ + Vec2d((Real)i * grid_spacing_, (Real)j * grid_spacing_);
+					phi_[i][j] = shape.findSignedDistance(position);
+					near_interface_id_[i][j] = phi_[i][j] < 0.0 ? -2 : 2;
+				}
+			return;
+		}
+
+		//- the shape is probed for the whole package in a batch
+		StdVec<Vecd> positions;
 		for (int i = 0; i != PackageSize(); ++i)
 			for (int j = 0; j != PackageSize(); ++j)
 			{
-				Vec2d position = data_lower_bound_ + Vec2d((Real)i * grid_spacing_, (Real)j * grid_spacing_);
-				phi_[i][j] = shape.findSignedDistance(position);
+				positions.push_back(data_lower_bound_ + Vec2d((Real)i * grid_spacing_, (Real)j * grid_spacing_));
+			}
+		StdVec<Real> signed_distances;
+		shape.findSignedDistances(positions, signed_distances);
+
+		size_t count = 0;
+		for (int i = 0; i != PackageSize(); ++i)
+			for (int j = 0; j != PackageSize(); ++j)
+			{
+				phi_[i][j] = signed_distances[count++];
 				near_interface_id_[i][j] = phi_[i][j] < 0.0 ? -2 : 2;
 			}
 	}
@@ -148,8 +170,9 @@ namespace SPH {
 		int j = (int)cell_index[1];
 
 		Vecd cell_position = CellPositionFromIndex(cell_index);
-		Real signed_distance = shape_.findSignedDistance(cell_position);
-		Vecd normal_direction = shape_.findNormalDirection(cell_position);
+		Real signed_distance = 0.0;
+		Vecd normal_direction(0);
+		probeShapeAtACell(cell_index, signed_distance, normal_direction);
 		Real measure = getMaxAbsoluteElement(normal_direction * signed_distance);
 		if (measure < grid_spacing_) {
 			mutex_my_pool.lock();
@@ -40,7 +40,7 @@ namespace SPH
 						cell_linked_lists_[i][j].real_particle_indexes_.clear();
 					}
 			},
-			ap);
+			affinity_partitioner_);
 	}
 	//=================================================================================================//
 	void CellLinkedList::UpdateCellListData()
@@ -62,7 +62,7 @@ namespace SPH
 						}
 					}
 			},
-			ap);
+			affinity_partitioner_);
 	}
 	//=================================================================================================//
 	void CellLinkedList::updateSplitCellLists(SplitCellLists &split_cell_lists)
@@ -87,7 +87,7 @@ namespace SPH
 						}
 					}
 			},
-			ap);
+			affinity_partitioner_);
 	}
 	//=================================================================================================//
 	void CellLinkedList ::insertACellLinkedParticleIndex(size_t particle_index, const Vecd &particle_position)
@@ -42,6 +42,16 @@ namespace SPH
 		return image_->findNormalAtPoint(input_pnt);
 	}
 	//=================================================================================================//
+	void ImageShape::findSignedDistances(const StdVec<Vec3d> &input_pnts, StdVec<Real> &signed_distances)
+	{
+		image_->findValuesAtPoints(input_pnts, signed_distances);
+	}
+	//=================================================================================================//
+	void ImageShape::findNormalDirections(const StdVec<Vec3d> &input_pnts, StdVec<Vec3d> &normal_directions)
+	{
+		image_->findNormalsAtPoints(input_pnts, normal_directions);
+	}
+	//=================================================================================================//
 	bool ImageShape::checkNotFar(const Vec3d &input_pnt, Real threshold)
 	{
 		return checkContain(input_pnt) || checkNearSurface(input_pnt, threshold) ? true : false;
@@ -53,10 +63,75 @@ namespace SPH
 	}
 	//=================================================================================================//
 	ImageShapeFromFile::
-		ImageShapeFromFile(const std::string &file_path_name, const std::string &shape_name)
+		ImageShapeFromFile(const std::string &file_path_name, const std::string &shape_name,
+						   Storage_Mode storage_mode)
 		: ImageShape(shape_name)
 	{
+		image_.reset(new ImageMHD<float, 3>(file_path_name, storage_mode));
+	}
+	//=================================================================================================//
+	ImageShapeFromFile::
+		ImageShapeFromFile(const std::string &file_path_name, int label,
+						   const std::string &cache_file_path, const std::string &shape_name)
+		: ImageShape(shape_name)
+	{
+		std::string cache_key = signedDistanceCacheKey(file_path_name, label);
+		if (!cache_file_path.empty() && fs::exists(cache_file_path + ".mhd") && fs::exists(cache_file_path + ".key"))
+		{
+			std::ifstream key_file(cache_file_path + ".key");
+			std::stringstream cached_key;
+			cached_key << key_file.rdbuf();
+			if (cached_key.str() == cache_key)
+			{
+				image_.reset(new ImageMHD<float, 3>(cache_file_path + ".mhd"));
+				return;
+			}
+		}
+
 		image_.reset(new ImageMHD<float, 3>(file_path_name));
+		image_->transformToSignedDistance(label);
+		if (!cache_file_path.empty())
+		{
+			image_->write(cache_file_path);
+			std::ofstream key_file(cache_file_path + ".key", std::ios::trunc);
+			key_file << cache_key;
+		}
+	}
+	//=================================================================================================//
+	std::string ImageShapeFromFile::signedDistanceCacheKey(const std::string &file_path_name, int label)
+	{
+		StdVec<std::string> source_files(1, file_path_name);
+		std::ifstream header_file(file_path_name);
+		std::string line;
+		while (std::getline(header_file, line))
+		{
+			size_t separator = line.find('=');
+			size_t name_begin = separator == std::string::npos ? separator : line.find_first_not_of(" \t\r", separator + 1);
+			if (line.compare(0, 15, "ElementDataFile") == 0 && name_begin != std::string::npos)
+			{
+				std::string raw_file_name = line.substr(name_begin, line.find_last_not_of(" \t\r") + 1 - name_begin);
+				fs::path directory = fs::path(file_path_name).parent_path();
+				source_files.push_back(directory.empty() ? raw_file_name : (directory / raw_file_name).string());
+			}
+		}
+
+		std::stringstream cache_key;
+		cache_key << "Label = " << label << "\n";
+		for (const std::string &source_file : source_files)
+		{
+			cache_key << "Source = " << fs::absolute(source_file).string();
+			if (fs::exists(source_file))
+			{
+				cache_key << " " << fs::file_size(source_file) << " ";
+#ifdef __APPLE__
+				cache_key << fs::last_write_time(source_file);
+#else
+				cache_key << fs::last_write_time(source_file).time_since_epoch().count();
+#endif
+			}
+			cache_key << "\n";
+		}
+		return cache_key.str();
 	}
 	//=================================================================================================//
 	ImageShapeSphere::
@@ -41,6 +41,7 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <sstream>
 
 /** Macro for APPLE compilers*/
 #ifdef __APPLE__
@@ -68,6 +69,8 @@ namespace SPH
 		virtual bool checkNearSurface(const Vec3d &input_pnt, Real threshold) override;
 		virtual Real findSignedDistance(const Vec3d &input_pnt) override;
 		virtual Vec3d findNormalDirection(const Vec3d &input_pnt) override;
+		virtual void findSignedDistances(const StdVec<Vec3d> &input_pnts, StdVec<Real> &signed_distances) override;
+		virtual void findNormalDirections(const StdVec<Vec3d> &input_pnts, StdVec<Vec3d> &normal_directions) override;
 
 	protected:
 		//- distance map has to be float type image
@@ -84,8 +87,22 @@ namespace SPH
 	public:
 		//constructor for load mhd/raw file from out side
 		explicit ImageShapeFromFile(const std::string &file_path_name,
-									const std::string &shape_name = "ImageShapeFromFile");
+									const std::string &shape_name = "ImageShapeFromFile",
+									Storage_Mode storage_mode = IN_MEMORY);
+		//constructor for binary or label mhd/raw file, the signed distance map is computed
+		//and cached in the given file (without extension) if the path is not empty,
+		//the cache is reused only for the same label and unchanged source files
+		ImageShapeFromFile(const std::string &file_path_name, int label,
+						   const std::string &cache_file_path = "",
+						   const std::string &shape_name = "ImageShapeFromFile");
 		virtual ~ImageShapeFromFile(){};
+
+		//the voxels of a large image are read in memory order by the batched probes
+		virtual bool isProbedInBatches() override { return true; };
+
+	protected:
+		//the source file names, sizes and modification times and the label of a cached distance map
+		std::string signedDistanceCacheKey(const std::string &file_path_name, int label);
 	};
 
 	class ImageShapeSphere : public ImageShape
@@ -28,13 +28,38 @@ namespace SPH {
 	//=================================================================================================//
 	void  LevelSetDataPackage::initializeBasicData(Shape& shape)
 	{
+		if (!shape.isProbedInBatches())
+		{
+			for (int i = 0; i != PackageSize(); ++i)
+				for (int j = 0; j != PackageSize(); ++j)
+					for (int k = 0; k != PackageSize(); ++k)
+					{
+						Vec3d position = data_lower_bound_ 
+									   + Vec3d((Real)i * grid_spacing_, (Real)j * grid_spacing_, (Real)k * grid_spacing_);
+						phi_[i][j][k] = shape.findSignedDistance(position);
+						near_interface_id_[i][j][k] = phi_[i][j][k] < 0.0 ? -2 : 2;
+					}
+			return;
+		}
+
+		//- the shape is probed for the whole package in a batch
+		StdVec<Vecd> positions;
+		for (int i = 0; i != PackageSize(); ++i)
+			for (int j = 0; j != PackageSize(); ++j)
+				for (int k = 0; k != PackageSize(); ++k)
+				{
+					positions.push_back(data_lower_bound_
+								   + Vec3d((Real)i * grid_spacing_, (Real)j * grid_spacing_, (Real)k * grid_spacing_));
+				}
+		StdVec<Real> signed_distances;
+		shape.findSignedDistances(positions, signed_distances);
+
+		size_t count = 0;
 		for (int i = 0; i != PackageSize(); ++i)
 			for (int j = 0; j != PackageSize(); ++j)
 				for (int k = 0; k != PackageSize(); ++k)
 				{
-					Vec3d position = data_lower_bound_ 
-								   + Vec3d((Real)i * grid_spacing_, (Real)j * grid_spacing_, (Real)k * grid_spacing_);
-					phi_[i][j][k] = shape.findSignedDistance(position);
+					phi_[i][j][k] = signed_distances[count++];
 					near_interface_id_[i][j][k] = phi_[i][j][k] < 0.0 ? -2 : 2;
 				}
 	}
@@ -172,8 +197,9 @@ namespace SPH {
 		int k = (int)cell_index[2];
 
 		Vecd cell_position = CellPositionFromIndex(cell_index);
-		Real signed_distance = shape_.findSignedDistance(cell_position);
-		Vecd normal_direction = shape_.findNormalDirection(cell_position);
+		Real signed_distance = 0.0;
+		Vecd normal_direction(0);
+		probeShapeAtACell(cell_index, signed_distance, normal_direction);
 		Real measure = getMaxAbsoluteElement(normal_direction * signed_distance);
 		if (measure < grid_spacing_) {
 			mutex_my_pool.lock();
@@ -36,7 +36,7 @@ namespace SPH
 							cell_linked_lists_[i][j][k].real_particle_indexes_.clear();
 						}
 			},
-			ap);
+			affinity_partitioner_);
 	}
 	//=================================================================================================//
 	void CellLinkedList::UpdateCellListData()
@@ -59,7 +59,7 @@ namespace SPH
 							}
 						}
 			},
-			ap);
+			affinity_partitioner_);
 	}
 	//=================================================================================================//
 	void CellLinkedList::updateSplitCellLists(SplitCellLists &split_cell_lists)
@@ -86,7 +86,7 @@ namespace SPH
 							}
 						}
 			},
-			ap);
+			affinity_partitioner_);
 	}
 	//=================================================================================================//
 	void CellLinkedList ::insertACellLinkedParticleIndex(size_t particle_index, const Vecd &particle_position)
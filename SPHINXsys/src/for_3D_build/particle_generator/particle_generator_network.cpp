@@ -17,7 +17,14 @@ namespace SPH
 		ParticleGeneratorNetwork(Vecd starting_pnt, Vecd second_pnt, int iterator, Real grad_factor)
 		: ParticleGenerator(), starting_pnt_(starting_pnt), second_pnt_(second_pnt),
 		  n_it_(iterator), fascicles_(true), segments_in_branch_(10), segment_length_(0),
-		  grad_factor_(grad_factor), body_shape_(nullptr), cell_linked_list_(nullptr), tree_(nullptr) {}
+		  grad_factor_(grad_factor), body_shape_(nullptr), cell_linked_list_(nullptr), tree_(nullptr),
+		  parallel_growth_(false) {}
+	//=================================================================================================//
+	void ParticleGeneratorNetwork::useParallelGrowth(unsigned int seed)
+	{
+		parallel_growth_ = true;
+		random_engine_.seed(seed);
+	}
 	//=================================================================================================//
 	void ParticleGeneratorNetwork::initialize(SPHBody *sph_body)
 	{
@@ -157,6 +164,122 @@ namespace SPH
 		return is_valid;
 	}
 	//=================================================================================================//
+	void ParticleGeneratorNetwork::proposeABranch(Real repulsivity, size_t number_segments, BranchProposal &proposal)
+	{
+		proposal.points_.clear();
+		proposal.end_directions_.clear();
+		proposal.is_terminated_ = false;
+
+		GenerativeTree::Branch *parent_branch = tree_->branches_[proposal.parent_id_];
+		Vecd init_point = tree_->pos_n_[parent_branch->inner_particles_.back()];
+		Vecd init_direction = parent_branch->end_direction_;
+
+		Vecd surface_norm = body_shape_->findNormalDirection(init_point);
+		surface_norm /= surface_norm.norm() + TinyReal;
+		Vecd in_plane = -SimTK::cross(init_direction, surface_norm);
+
+		Real delta = grad_factor_ * segment_length_;
+		Vecd grad = getGradientFromNearestPoints(init_point, delta);
+		Vecd dir = cos(proposal.angle_) * init_direction + sin(proposal.angle_) * in_plane;
+		dir /= dir.norm() + TinyReal;
+		Vecd end_direction = (repulsivity * grad + dir) / ((repulsivity * grad + dir).norm() + TinyReal);
+		Vecd end_point = init_point;
+
+		Vecd new_point = createATentativeNewBranchPoint(end_point, end_direction);
+		if (isCollision(new_point, cell_linked_list_->findNearestListDataEntry(new_point), proposal.parent_id_))
+			return;
+
+		proposal.points_.push_back(new_point);
+		proposal.end_directions_.push_back(end_direction);
+		for (size_t i = 1; i < number_segments; i++)
+		{
+			surface_norm = body_shape_->findNormalDirection(new_point);
+			surface_norm /= surface_norm.norm() + TinyReal;
+			/** Project grad to surface. */
+			grad = getGradientFromNearestPoints(new_point, delta);
+			grad -= dot(grad, surface_norm) * surface_norm;
+			dir = (repulsivity * grad + end_direction) / ((repulsivity * grad + end_direction).norm() + TinyReal);
+			end_direction = dir;
+			end_point = new_point;
+
+			new_point = createATentativeNewBranchPoint(end_point, end_direction);
+			if (isCollision(new_point, cell_linked_list_->findNearestListDataEntry(new_point), proposal.parent_id_) ||
+				(new_point - end_point).norm() < 0.5 * segment_length_)
+			{
+				proposal.is_terminated_ = true;
+				break;
+			}
+			proposal.points_.push_back(new_point);
+			proposal.end_directions_.push_back(end_direction);
+		}
+	}
+	//=================================================================================================//
+	bool ParticleGeneratorNetwork::acceptABranchProposal(BranchProposal &proposal)
+	{
+		if (proposal.points_.empty() ||
+			isCollision(proposal.points_[0], cell_linked_list_->findNearestListDataEntry(proposal.points_[0]), proposal.parent_id_))
+			return false;
+
+		GenerativeTree::Branch *new_branch = tree_->createANewBranch(proposal.parent_id_);
+		new_branch->is_terminated_ = proposal.is_terminated_;
+		tree_->growAParticleOnBranch(new_branch, proposal.points_[0], proposal.end_directions_[0]);
+		for (size_t i = 1; i < proposal.points_.size(); i++)
+		{
+			/** Check against the branches accepted earlier in this generation. */
+			const Vecd &new_point = proposal.points_[i];
+			if (isCollision(new_point, cell_linked_list_->findNearestListDataEntry(new_point), proposal.parent_id_))
+			{
+				new_branch->is_terminated_ = true;
+				break;
+			}
+			tree_->growAParticleOnBranch(new_branch, new_point, proposal.end_directions_[i]);
+		}
+
+		StdLargeVec<Vecd> &tree_points = tree_->pos_n_;
+		for (const size_t &particle_idx : new_branch->inner_particles_)
+		{
+			cell_linked_list_->InsertACellLinkedListDataEntry(particle_idx, tree_points[particle_idx]);
+		}
+		return true;
+	}
+	//=================================================================================================//
+	void ParticleGeneratorNetwork::
+		growAGenerationInParallel(IndexVector &branches_to_grow, IndexVector &new_branches_to_grow)
+	{
+		std::shuffle(branches_to_grow.begin(), branches_to_grow.end(), random_engine_);
+		std::uniform_real_distribution<Real> random_number(-0.5, 0.5);
+		StdVec<BranchProposal> proposals(2 * branches_to_grow.size());
+		for (size_t j = 0; j != branches_to_grow.size(); j++)
+		{
+			Real angle_to_use = angle_ + random_number(random_engine_) * 0.05;
+			for (size_t k = 0; k != 2; k++)
+			{
+				proposals[2 * j + k].parent_id_ = branches_to_grow[j];
+				proposals[2 * j + k].angle_ = angle_to_use;
+				angle_to_use *= -1.0;
+			}
+		}
+
+		/** The tree and the cell linked list are only read when proposing. */
+		parallel_for(
+			blocked_range<size_t>(0, proposals.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t n = r.begin(); n != r.end(); ++n)
+				{
+					proposeABranch(repulsivity_, segments_in_branch_, proposals[n]);
+				}
+			});
+
+		for (BranchProposal &proposal : proposals)
+		{
+			if (acceptABranchProposal(proposal) && !tree_->LastBranch()->is_terminated_)
+			{
+				new_branches_to_grow.push_back(tree_->last_branch_id_);
+			}
+		}
+	}
+	//=================================================================================================//
 	void ParticleGeneratorNetwork::createBaseParticles(BaseParticles *base_particles)
 	{
 		In_Output *in_output = sph_body_->getSPHSystem().in_output_;
@@ -200,6 +323,17 @@ namespace SPH
 		for (size_t i = 0; i != n_it_; i++)
 		{
 			new_branches_to_grow.clear();
+			if (parallel_growth_)
+			{
+				growAGenerationInParallel(branches_to_grow, new_branches_to_grow);
+				branches_to_grow = new_branches_to_grow;
+
+				ite++;
+				sph_body_->setNewlyUpdated();
+				write_states.writeToFile(ite);
+				continue;
+			}
+
 			random_shuffle(branches_to_grow.begin(), branches_to_grow.end());
 			for (size_t j = 0; j != branches_to_grow.size(); j++)
 			{
@@ -34,6 +34,8 @@
 #include "base_particle_generator.h"
 #include "generative_structures.h"
 
+#include <random>
+
 namespace SPH
 {
 	class BaseLevelSet;
@@ -59,8 +61,27 @@ namespace SPH
 		 *@param[in] base_particles(BaseParticles) Pointer to baseparticle link to a SPHBody.
 		 */
 		virtual void createBaseParticles(BaseParticles *base_particles) override;
+		/**
+		 *@brief Grow all branches of a generation concurrently, 
+		 * the resulted network is reproducible for a given seed.
+		 *@param[in] seed(unsigned int) Seed of the random numbers for the growing angles.
+		 */
+		void useParallelGrowth(unsigned int seed = 0);
 
 	protected:
+		/**
+		 * @struct BranchProposal
+		 * @brief A tentative branch computed concurrently before it is accepted into the tree.
+		 */
+		struct BranchProposal
+		{
+			size_t parent_id_;
+			Real angle_;
+			StdVec<Vecd> points_;
+			StdVec<Vecd> end_directions_;
+			bool is_terminated_;
+		};
+
 		Vecd starting_pnt_;									/**< Starting point for net work. */
 		Vecd second_pnt_;									/**< Second point, approximate the growing direction. */
 		size_t n_it_;										/**< Number of iterations (generations of branch. */
@@ -75,6 +96,8 @@ namespace SPH
 		ComplexShape *body_shape_;
 		BaseCellLinkedList *cell_linked_list_;
 		GenerativeTree *tree_;
+		bool parallel_growth_;			   /**< Grow the branches of a generation concurrently? */
+		std::mt19937 random_engine_;	   /**< Random numbers for parallel growth. */
 		/**
 		 *@brief Get the gradient from nearest points, for imposing repulsive force. 
 		 *@param[in] pt(Vecd) Inquiry point.
@@ -90,6 +113,25 @@ namespace SPH
 		 *@param[in] number_segments(size_t) Number of segments in this branch.
 		 */
 		bool createABranchIfValid(size_t parent_id, Real angle, Real repulsivity, size_t number_segments);
+		/**
+		 *@brief Compute a branch proposal without modifying the tree and the cell linked list.
+		 *@param[in] repulsivity(Real) The repulsivity for creating new points.
+		 *@param[in] number_segments(size_t) Number of segments in this branch.
+		 *@param[out] proposal(BranchProposal) The proposal with parent id and angle given.
+		 */
+		void proposeABranch(Real repulsivity, size_t number_segments, BranchProposal &proposal);
+		/**
+		 *@brief Accept a proposal into the tree after checking collision with the current points,
+		 * the proposal is truncated at the first collision.
+		 *@param[in] proposal(BranchProposal) The branch proposal.
+		 */
+		bool acceptABranchProposal(BranchProposal &proposal);
+		/**
+		 *@brief Grow a generation of branches by concurrent proposals and serial acceptance in a fixed order.
+		 *@param[in] branches_to_grow(IndexVector) Parent branches of this generation.
+		 *@param[out] new_branches_to_grow(IndexVector) Parent branches of the next generation.
+		 */
+		void growAGenerationInParallel(IndexVector &branches_to_grow, IndexVector &new_branches_to_grow);
 		/**
 		 *@brief Functions that creates a new node in the mesh surface and it to the queue is it lies in the surface.
 		 *@param[in] init_node vector that contains the coordinates of the last node added in the branch.
@@ -115,7 +115,8 @@ namespace SPH
 	RealBody::RealBody(SPHSystem &sph_system, const std::string &body_name,
 					   SharedPtr<SPHAdaptation> sph_adaptation_ptr)
 		: SPHBody(sph_system, body_name, sph_adaptation_ptr),
-		  particle_sorting_(this)
+		  particle_sorting_(this), cell_linked_list_updates_(0),
+		  is_periodic_(false), periodic_translation_(0), use_verlet_skin_(false), real_body_index_(0)
 	{
 		sph_system.addARealBody(this);
 		cell_linked_list_ = cell_linked_list_keeper_.movePtr(sph_adaptation_->createCellLinkedList());
@@ -140,6 +141,7 @@ namespace SPH
 	//=================================================================================================//
 	void RealBody::updateCellLinkedList()
 	{
+		cell_linked_list_updates_++;
 		cell_linked_list_->UpdateCellLists();
 	}
 	//=================================================================================================//
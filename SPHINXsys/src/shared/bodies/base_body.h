@@ -141,6 +141,11 @@ namespace SPH
 	public:
 		ParticleSorting particle_sorting_;
 		BaseCellLinkedList *cell_linked_list_; /**< Cell linked mesh of this body. */
+		size_t cell_linked_list_updates_;	   /**< the number of cell linked list updates, i.e. of particle moves seen by the relations. */
+		bool is_periodic_;					   /**< whether a periodic condition images the particles across the body domain bounds. */
+		Vecd periodic_translation_;			   /**< the translation of the periodic images, zero in the non-periodic axes. */
+		bool use_verlet_skin_;				   /**< whether a relation reuses neighbor lists searched with a skin. */
+		size_t real_body_index_;			   /**< the index of this body among the real bodies of the SPH system. */
 
 		RealBody(SPHSystem &sph_system, const std::string &body_name,
 				 SharedPtr<SPHAdaptation> sph_adaptation_ptr);
@@ -9,12 +9,144 @@
 #include "base_kernel.h"
 #include "base_particles.h"
 #include "cell_linked_list.hpp"
+#include "sph_system.h"
 
 namespace SPH
 {
+	//=================================================================================================//
+	void ParticleDisplacementRecord::recordParticles()
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
+		StdLargeVec<size_t> &unsorted_id = base_particles_->unsorted_id_;
+		recorded_pos_.resize(total_real_particles);
+		recorded_id_.resize(total_real_particles);
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+				{
+					recorded_pos_[index_i] = pos_n[index_i];
+					recorded_id_[index_i] = unsorted_id[index_i];
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	Real ParticleDisplacementRecord::MaximumDisplacement()
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		if (total_real_particles != recorded_pos_.size())
+			return Infinity;
+
+		StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
+		StdLargeVec<size_t> &unsorted_id = base_particles_->unsorted_id_;
+		return parallel_reduce(
+			blocked_range<size_t>(0, total_real_particles),
+			Real(0),
+			[&](const blocked_range<size_t> &r, Real displacement_max) -> Real
+			{
+				for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+				{
+					Real displacement = unsorted_id[index_i] == recorded_id_[index_i]
+											? (pos_n[index_i] - recorded_pos_[index_i]).norm()
+											: Infinity;
+					displacement_max = SMAX(displacement_max, displacement);
+				}
+				return displacement_max;
+			},
+			[](Real x, Real y) -> Real
+			{ return SMAX(x, y); });
+	}
+	//=================================================================================================//
+	VerletSkinConfiguration::
+		VerletSkinConfiguration(BaseParticles *source_particles, BaseParticles *target_particles,
+								CellLinkedList *target_cell_linked_list, Real cutoff_radius, Real skin_thickness)
+		: source_particles_(source_particles), target_particles_(target_particles),
+		  target_cell_linked_list_(target_cell_linked_list), skin_thickness_(skin_thickness),
+		  source_record_(source_particles), target_record_(target_particles),
+		  get_search_depth_(cutoff_radius + skin_thickness, target_cell_linked_list),
+		  get_neighbor_candidate_(cutoff_radius + skin_thickness, source_particles == target_particles) {}
+	//=================================================================================================//
+	bool VerletSkinConfiguration::isSearchNeeded()
+	{
+		Real source_displacement = source_record_.MaximumDisplacement();
+		Real target_displacement = source_particles_ == target_particles_
+									   ? source_displacement
+									   : target_record_.MaximumDisplacement();
+		return source_displacement + target_displacement > skin_thickness_;
+	}
+	//=================================================================================================//
+	void VerletSkinConfiguration::searchCandidates(size_t total_real_particles)
+	{
+		size_t updated_size = source_particles_->real_particles_bound_;
+		if (candidate_configuration_.size() < updated_size)
+			candidate_configuration_.resize(updated_size, Neighborhood());
+
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t num = r.begin(); num != r.end(); ++num)
+				{
+					candidate_configuration_[num].current_size_ = 0;
+				}
+			},
+			ap);
+
+		target_cell_linked_list_
+			->searchNeighborsByParticles(total_real_particles,
+										 *source_particles_, candidate_configuration_,
+										 get_particle_index_, get_search_depth_,
+										 get_neighbor_candidate_);
+
+		source_record_.recordParticles();
+		if (source_particles_ != target_particles_)
+			target_record_.recordParticles();
+	}
+	//=================================================================================================//
+	template <typename GetNeighborRelation>
+	void VerletSkinConfiguration::
+		refreshConfiguration(size_t total_real_particles, ParticleConfiguration &particle_configuration,
+							 GetNeighborRelation &get_neighbor_relation)
+	{
+		StdLargeVec<Vecd> &source_pos_n = source_particles_->pos_n_;
+		StdLargeVec<Vecd> &target_pos_n = target_particles_->pos_n_;
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+				{
+					const Neighborhood &candidates = candidate_configuration_[index_i];
+					Neighborhood &neighborhood = particle_configuration[index_i];
+					neighborhood.current_size_ = 0;
+					for (size_t n = 0; n != candidates.current_size_; ++n)
+					{
+						size_t index_j = candidates.j_[n];
+						//displacement pointing from neighboring particle to origin particle
+						Vecd displacement = source_pos_n[index_i] - target_pos_n[index_j];
+						get_neighbor_relation(neighborhood, displacement, index_i, index_j);
+					}
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	void checkVerletSkinSupport(RealBody &real_body)
+	{
+		if (real_body.is_periodic_)
+		{
+			std::cout << "\n Error: Verlet skin is not supported for the periodic body " << real_body.getBodyName() << "!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		real_body.use_verlet_skin_ = true;
+	}
 	//=================================================================================================//
 	SPHBodyRelation::SPHBodyRelation(SPHBody &sph_body)
-		: sph_body_(&sph_body), base_particles_(sph_body.base_particles_) {}
+		: sph_body_(&sph_body), base_particles_(sph_body.base_particles_), configuration_updates_(0) {}
 	//=================================================================================================//
 	BaseBodyRelationInner::BaseBodyRelationInner(RealBody &real_body)
 		: SPHBodyRelation(real_body), real_body_(&real_body)
@@ -43,12 +175,112 @@ namespace SPH
 			ap);
 	}
 	//=================================================================================================//
+	void BaseBodyRelationInner::setStoragePolicy(const NeighborStoragePolicy &storage_policy)
+	{
+		std::cout << "\n Error: the storage policy is not supported by " << typeid(*this).name() << "!" << std::endl;
+		std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+		exit(1);
+	}
+	//=================================================================================================//
+	void BaseBodyRelationInner::recordConfigurationPositions()
+	{
+		StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
+		if (configuration_pos_.size() < pos_n.size())
+			configuration_pos_.resize(pos_n.size(), Vecd(0));
+
+		parallel_for(
+			blocked_range<size_t>(0, base_particles_->total_real_particles_),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+				{
+					configuration_pos_[index_i] = pos_n[index_i];
+				}
+			},
+			ap);
+
+		/** the ghost particles are neighbors too */
+		size_t ghost_particles_begin = base_particles_->real_particles_bound_;
+		size_t ghost_particles_end = ghost_particles_begin + base_particles_->total_ghost_particles_;
+		for (size_t index_i = ghost_particles_begin; index_i != ghost_particles_end; ++index_i)
+		{
+			configuration_pos_[index_i] = pos_n[index_i];
+		}
+	}
+	//=================================================================================================//
+	void BaseBodyRelationInner::registerPairFieldReader(const void *dynamics, bool through_accessor)
+	{
+		pair_field_readers_[dynamics] = through_accessor;
+	}
+	//=================================================================================================//
+	void BaseBodyRelationInner::unregisterPairFieldReader(const void *dynamics)
+	{
+		pair_field_readers_.erase(dynamics);
+	}
+	//=================================================================================================//
+	size_t BaseBodyRelationInner::DirectPairFieldReaders()
+	{
+		size_t direct_readers = 0;
+		for (auto &reader : pair_field_readers_)
+			if (!reader.second)
+				direct_readers++;
+		return direct_readers;
+	}
+	//=================================================================================================//
+	void BaseBodyRelationInner::checkStoredFieldReaders()
+	{
+		size_t direct_readers = DirectPairFieldReaders();
+		if (!storage_policy_.isStoringAll() && direct_readers != 0)
+		{
+			std::cout << "\n Error: " << direct_readers << " particle dynamics of " << sph_body_->getBodyName()
+					  << " read the pair fields not stored by the storage policy of the inner relation!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+	}
+	//=================================================================================================//
 	BodyRelationInner::BodyRelationInner(RealBody &real_body)
 		: BaseBodyRelationInner(real_body), get_inner_neighbor_(&real_body),
-		  cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.cell_linked_list_)) {}
+		  cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.cell_linked_list_)),
+		  verlet_skin_configuration_(nullptr) {}
+	//=================================================================================================//
+	void BodyRelationInner::useVerletSkin(Real skin_thickness)
+	{
+		checkVerletSkinSupport(*real_body_);
+		Real cutoff_radius = sph_body_->sph_adaptation_->getKernel()->CutOffRadius();
+		verlet_skin_configuration_ = verlet_skin_configuration_ptr_keeper_.createPtr<VerletSkinConfiguration>(
+			base_particles_, base_particles_, cell_linked_list_, cutoff_radius, skin_thickness);
+	}
+	//=================================================================================================//
+	void BodyRelationInner::setStoragePolicy(const NeighborStoragePolicy &storage_policy)
+	{
+		storage_policy_ = storage_policy;
+		get_inner_neighbor_.setStoragePolicy(storage_policy);
+		for (size_t index_i = 0; index_i != inner_configuration_.size(); ++index_i)
+		{
+			inner_configuration_[index_i] = Neighborhood();
+		}
+	}
 	//=================================================================================================//
 	void BodyRelationInner::updateConfiguration()
 	{
+		configuration_updates_++;
+		if (!storage_policy_.isStoringAll())
+		{
+			checkStoredFieldReaders();
+			recordConfigurationPositions();
+		}
+
+		if (verlet_skin_configuration_ != nullptr)
+		{
+			size_t total_real_particles = base_particles_->total_real_particles_;
+			if (verlet_skin_configuration_->isSearchNeeded())
+				verlet_skin_configuration_->searchCandidates(total_real_particles);
+			verlet_skin_configuration_->refreshConfiguration(total_real_particles,
+															 inner_configuration_, get_inner_neighbor_);
+			return;
+		}
+
 		resetNeighborhoodCurrentSize();
 		cell_linked_list_
 			->searchNeighborsByParticles(base_particles_->total_real_particles_,
@@ -76,6 +308,7 @@ namespace SPH
 	//=================================================================================================//
 	void BodyRelationInnerVariableSmoothingLength::updateConfiguration()
 	{
+		configuration_updates_++;
 		resetNeighborhoodCurrentSize();
 		for (size_t l = 0; l != total_levels_; ++l)
 		{
@@ -113,6 +346,7 @@ namespace SPH
 	//=================================================================================================//
 	void SolidBodyRelationSelfContact::updateConfiguration()
 	{
+		configuration_updates_++;
 		resetNeighborhoodCurrentSize();
 		size_t total_real_particles = body_part_particles_.size();
 		cell_linked_list_
@@ -144,6 +378,7 @@ namespace SPH
 	{
 		size_t updated_size = sph_body_->base_particles_->real_particles_bound_;
 		contact_configuration_.resize(contact_bodies_.size());
+		overlap_region_particles_.resize(contact_bodies_.size());
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
 		{
 			contact_configuration_[k].resize(updated_size, Neighborhood());
@@ -167,6 +402,26 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	bool BaseBodyRelationContact::isBroadPhaseUsed()
+	{
+		SPHSystem &sph_system = sph_body_->getSPHSystem();
+		if (sph_system.broad_phase_culling_)
+			sph_system.updateBroadPhaseIfOutdated();
+		return sph_system.broad_phase_culling_;
+	}
+	//=================================================================================================//
+	bool BaseBodyRelationContact::isContactBodyCulled(size_t contact_body_index)
+	{
+		SPHSystem &sph_system = sph_body_->getSPHSystem();
+		return sph_system.broad_phase_culling_ &&
+			   !sph_system.isOverlapping(sph_body_, contact_bodies_[contact_body_index]);
+	}
+	//=================================================================================================//
+	BoundingBox BaseBodyRelationContact::OverlapRegion(size_t contact_body_index)
+	{
+		return sph_body_->getSPHSystem().OverlapRegion(sph_body_, contact_bodies_[contact_body_index]);
+	}
+	//=================================================================================================//
 	BodyRelationContact::BodyRelationContact(SPHBody &sph_body, RealBodyVector contact_sph_bodies)
 		: BaseBodyRelationContact(sph_body, contact_sph_bodies)
 	{
@@ -193,17 +448,60 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	void BodyRelationContact::useVerletSkin(Real skin_thickness)
+	{
+		Real source_cutoff_radius = sph_body_->sph_adaptation_->getKernel()->CutOffRadius();
+		for (size_t k = 0; k != contact_bodies_.size(); ++k)
+			checkVerletSkinSupport(*contact_bodies_[k]);
+		verlet_skin_configurations_.clear();
+		for (size_t k = 0; k != contact_bodies_.size(); ++k)
+		{
+			Real target_cutoff_radius = contact_bodies_[k]->sph_adaptation_->getKernel()->CutOffRadius();
+			verlet_skin_configurations_.push_back(
+				verlet_skin_configuration_ptr_vector_keeper_.createPtr<VerletSkinConfiguration>(
+					base_particles_, contact_bodies_[k]->base_particles_, target_cell_linked_lists_[k],
+					SMAX(source_cutoff_radius, target_cutoff_radius), skin_thickness));
+		}
+	}
+	//=================================================================================================//
 	void BodyRelationContact::updateConfiguration()
 	{
-		resetNeighborhoodCurrentSize();
+		configuration_updates_++;
 		size_t total_real_particles = base_particles_->total_real_particles_;
+		if (!verlet_skin_configurations_.empty())
+		{
+			for (size_t k = 0; k != contact_bodies_.size(); ++k)
+			{
+				if (verlet_skin_configurations_[k]->isSearchNeeded())
+					verlet_skin_configurations_[k]->searchCandidates(total_real_particles);
+				verlet_skin_configurations_[k]->refreshConfiguration(total_real_particles,
+																	 contact_configuration_[k], *get_contact_neighbors_[k]);
+			}
+			return;
+		}
+
+		resetNeighborhoodCurrentSize();
+		bool broad_phase_culling = isBroadPhaseUsed();
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
 		{
-			target_cell_linked_lists_[k]
-				->searchNeighborsByParticles(total_real_particles,
-											 *base_particles_, contact_configuration_[k],
-											 get_particle_index_, *get_search_depths_[k],
-											 *get_contact_neighbors_[k]);
+			if (!broad_phase_culling)
+			{
+				target_cell_linked_lists_[k]
+					->searchNeighborsByParticles(total_real_particles,
+												 *base_particles_, contact_configuration_[k],
+												 get_particle_index_, *get_search_depths_[k],
+												 *get_contact_neighbors_[k]);
+			}
+			else if (!isContactBodyCulled(k))
+			{
+				IndexVector &particles = collectOverlapRegionParticles(k, total_real_particles, get_particle_index_);
+				BodyPartParticlesIndex get_overlap_particle_index(particles);
+				target_cell_linked_lists_[k]
+					->searchNeighborsByParticles(particles.size(),
+												 *base_particles_, contact_configuration_[k],
+												 get_overlap_particle_index, *get_search_depths_[k],
+												 *get_contact_neighbors_[k]);
+			}
 		}
 	}
 	//=================================================================================================//
@@ -261,20 +559,36 @@ namespace SPH
 	//=================================================================================================//
 	void SolidBodyRelationContact::updateConfiguration()
 	{
+		configuration_updates_++;
 		resetNeighborhoodCurrentSize();
 		size_t total_real_particles = body_part_particles_.size();
+		bool broad_phase_culling = isBroadPhaseUsed();
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
 		{
-			target_cell_linked_lists_[k]
-				->searchNeighborsByParticles(total_real_particles,
-											 *base_particles_, contact_configuration_[k],
-											 get_body_part_particle_index_, *get_search_depths_[k],
-											 *get_contact_neighbors_[k]);
+			if (!broad_phase_culling)
+			{
+				target_cell_linked_lists_[k]
+					->searchNeighborsByParticles(total_real_particles,
+												 *base_particles_, contact_configuration_[k],
+												 get_body_part_particle_index_, *get_search_depths_[k],
+												 *get_contact_neighbors_[k]);
+			}
+			else if (!isContactBodyCulled(k))
+			{
+				IndexVector &particles = collectOverlapRegionParticles(k, total_real_particles, get_body_part_particle_index_);
+				BodyPartParticlesIndex get_overlap_particle_index(particles);
+				target_cell_linked_lists_[k]
+					->searchNeighborsByParticles(particles.size(),
+												 *base_particles_, contact_configuration_[k],
+												 get_overlap_particle_index, *get_search_depths_[k],
+												 *get_contact_neighbors_[k]);
+			}
 		}
 	}
 	//=================================================================================================//
 	void GenerativeBodyRelationInner::updateConfiguration()
 	{
+		configuration_updates_++;
 		generative_structure_->buildParticleConfiguration(*base_particles_, inner_configuration_);
 	}
 	//=================================================================================================//
@@ -285,8 +599,16 @@ namespace SPH
 	{
 	}
 	//=================================================================================================//
+	void BodyPartRelationContact::useVerletSkin(Real skin_thickness)
+	{
+		std::cout << "\n Error: Verlet skin is not supported for BodyPartRelationContact!" << std::endl;
+		std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+		exit(1);
+	}
+	//=================================================================================================//
 	void BodyPartRelationContact::updateConfiguration()
 	{
+		configuration_updates_++;
 		size_t number_of_particles = body_part_particles_.size();
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
 		{
@@ -309,8 +631,16 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	void BodyRelationContactToBodyPart::useVerletSkin(Real skin_thickness)
+	{
+		std::cout << "\n Error: Verlet skin is not supported for BodyRelationContactToBodyPart!" << std::endl;
+		std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+		exit(1);
+	}
+	//=================================================================================================//
 	void BodyRelationContactToBodyPart::updateConfiguration()
 	{
+		configuration_updates_++;
 		size_t number_of_particles = base_particles_->total_real_particles_;
 		for (size_t k = 0; k != contact_body_parts_.size(); ++k)
 		{
@@ -371,6 +701,12 @@ namespace SPH
 		updateConfigurationMemories();
 	}
 	//=================================================================================================//
+	void ComplexBodyRelation::useVerletSkin(Real skin_thickness)
+	{
+		DynamicCast<BodyRelationInner>(this, inner_relation_).useVerletSkin(skin_thickness);
+		DynamicCast<BodyRelationContact>(this, contact_relation_).useVerletSkin(skin_thickness);
+	}
+	//=================================================================================================//
 	void ComplexBodyRelation::updateConfigurationMemories()
 	{
 		inner_relation_.updateConfigurationMemories();
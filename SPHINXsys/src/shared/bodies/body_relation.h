@@ -37,8 +37,12 @@
 #include "neighbor_relation.h"
 #include "base_geometry.h"
 
+#include <map>
+
 namespace SPH
 {
+	class SPHSystem;
+
 	/** a small functor for obtaining particle index for container index */
 	struct SPHBodyParticlesIndex
 	{
@@ -94,6 +98,85 @@ namespace SPH
 		};
 	};
 
+	/** @brief a small functor for obtaining search depth for a search radius with a skin 
+	 * @details Note that the search depth is defined on the target cell linked list.
+	 */
+	struct SearchDepthWithSkin
+	{
+		int search_depth_;
+		SearchDepthWithSkin(Real search_radius, CellLinkedList *target_cell_linked_list)
+			: search_depth_((int)ceil(search_radius / target_cell_linked_list->GridSpacing())){};
+		int operator()(size_t particle_index) const { return search_depth_; };
+	};
+
+	/**
+	 * @class ParticleDisplacementRecord
+	 * @brief Recording the positions and the original ids of the particles of a body
+	 * so that the maximum particle displacement since the record can be obtained.
+	 */
+	class ParticleDisplacementRecord
+	{
+	protected:
+		BaseParticles *base_particles_;
+		StdLargeVec<Vecd> recorded_pos_;
+		StdLargeVec<size_t> recorded_id_;
+
+	public:
+		explicit ParticleDisplacementRecord(BaseParticles *base_particles)
+			: base_particles_(base_particles){};
+		virtual ~ParticleDisplacementRecord(){};
+
+		void recordParticles();
+		/** Infinity is returned if the particle number or sequence has been changed since the record. */
+		Real MaximumDisplacement();
+	};
+
+	/** 
+	 * Verlet skin is refused for a periodic body, because the periodic images, 
+	 * i.e. shifted cell linked list entries or ghost particles, are re-created at each update 
+	 * and only for the particles within the cut-off layer at the body domain bounds, 
+	 * so that the candidates would miss the images within the skin and refresh with unshifted positions.
+	 * The body is marked, so that a periodic condition created later refuses the skin as well.
+	 */
+	void checkVerletSkinSupport(RealBody &real_body);
+
+	/**
+	 * @class VerletSkinConfiguration
+	 * @brief Neighbor candidate lists built with the cutoff radius plus a skin.
+	 * @details The candidate lists are reused until the maximum particle displacements of 
+	 * the source and target bodies sum up over the skin thickness, 
+	 * i.e. the maximum displacement exceeds half of the skin for an inner relation, 
+	 * or the particles have been sorted, inserted or deleted.
+	 * Between two searches, the particle configuration is only refreshed,
+	 * i.e. kernel values, distances and directions are updated for the candidate pairs.
+	 */
+	class VerletSkinConfiguration
+	{
+	protected:
+		BaseParticles *source_particles_;
+		BaseParticles *target_particles_;
+		CellLinkedList *target_cell_linked_list_;
+		Real skin_thickness_;
+		ParticleDisplacementRecord source_record_;
+		ParticleDisplacementRecord target_record_;
+		SPHBodyParticlesIndex get_particle_index_;
+		SearchDepthWithSkin get_search_depth_;
+		NeighborCandidate get_neighbor_candidate_;
+
+	public:
+		ParticleConfiguration candidate_configuration_;
+
+		VerletSkinConfiguration(BaseParticles *source_particles, BaseParticles *target_particles,
+								CellLinkedList *target_cell_linked_list, Real cutoff_radius, Real skin_thickness);
+		virtual ~VerletSkinConfiguration(){};
+
+		bool isSearchNeeded();
+		void searchCandidates(size_t total_real_particles);
+		template <typename GetNeighborRelation>
+		void refreshConfiguration(size_t total_real_particles, ParticleConfiguration &particle_configuration,
+								  GetNeighborRelation &get_neighbor_relation);
+	};
+
 	/**
 	 * @class SPHBodyRelation
 	 * @brief The abstract class for all relations within a SPH body or with its contact SPH bodies
@@ -103,6 +186,7 @@ namespace SPH
 	public:
 		SPHBody *sph_body_;
 		BaseParticles *base_particles_;
+		size_t configuration_updates_; /**< number of the configuration updates, for rebuilding the data derived from it */
 
 		explicit SPHBodyRelation(SPHBody &sph_body);
 		virtual ~SPHBodyRelation(){};
@@ -120,15 +204,108 @@ namespace SPH
 	{
 	protected:
 		virtual void resetNeighborhoodCurrentSize();
+		/** record the particle positions for evaluating the pair fields not stored */
+		void recordConfigurationPositions();
+		/** the registered particle dynamics and whether they read the pair fields through an accessor */
+		std::map<const void *, bool> pair_field_readers_;
+		/** stop if a particle dynamics reads the pair fields directly while they are not all stored */
+		void checkStoredFieldReaders();
 
 	public:
 		RealBody *real_body_;
 		ParticleConfiguration inner_configuration_; /**< inner configuration for the neighbor relations. */
+		NeighborStoragePolicy storage_policy_;		/**< pair fields stored in the inner configuration. */
+		StdLargeVec<Vecd> configuration_pos_;		/**< particle positions at the last configuration update. */
 
 		explicit BaseBodyRelationInner(RealBody &real_body);
 		virtual ~BaseBodyRelationInner(){};
 
+		/** a particle dynamics reads the pair fields either directly from the neighborhoods
+		 * or through a NeighborFieldAccessor, registered until the dynamics is destroyed */
+		void registerPairFieldReader(const void *dynamics, bool through_accessor);
+		void unregisterPairFieldReader(const void *dynamics);
+		/** number of the registered dynamics reading the pair fields directly */
+		size_t DirectPairFieldReaders();
+
 		virtual void updateConfigurationMemories() override;
+		/** Note that the stored neighborhoods are cleared, so the configuration should be updated afterwards. */
+		virtual void setStoragePolicy(const NeighborStoragePolicy &storage_policy);
+	};
+
+	/**
+	 * @class NeighborFieldAccessor
+	 * @brief Accessing the pair fields of an inner configuration.
+	 * According to the storage policy of the relation, a field is either read from the neighborhood 
+	 * or evaluated on the fly from the particle positions at the last configuration update,
+	 * so that both give the same value, up to round-off for the pairs across periodic bounds.
+	 * A particle dynamics reading all the pair fields through an accessor registers itself as such,
+	 * see DataDelegateInner::readPairFieldsThroughAccessor.
+	 */
+	class NeighborFieldAccessor
+	{
+	protected:
+		Kernel *kernel_;
+		NeighborStoragePolicy &storage_policy_;
+		StdLargeVec<Vecd> &configuration_pos_;
+		bool &is_periodic_;
+		Vecd &periodic_translation_;
+
+		/** the periodic images are found within the cell linked list by the nearest image across the bounds */
+		Vecd getDisplacement(const Neighborhood &neighborhood, size_t index_i, size_t n) const
+		{
+			Vecd displacement = configuration_pos_[index_i] - configuration_pos_[neighborhood.j_[n]];
+			if (is_periodic_)
+			{
+				for (int k = 0; k != displacement.size(); ++k)
+				{
+					if (displacement[k] > 0.5 * periodic_translation_[k] && periodic_translation_[k] > 0.0)
+						displacement[k] -= periodic_translation_[k];
+					if (displacement[k] < -0.5 * periodic_translation_[k] && periodic_translation_[k] > 0.0)
+						displacement[k] += periodic_translation_[k];
+				}
+			}
+			return displacement;
+		};
+
+	public:
+		explicit NeighborFieldAccessor(BaseBodyRelationInner &inner_relation)
+			: kernel_(inner_relation.sph_body_->sph_adaptation_->getKernel()),
+			  storage_policy_(inner_relation.storage_policy_),
+			  configuration_pos_(inner_relation.configuration_pos_),
+			  is_periodic_(inner_relation.real_body_->is_periodic_),
+			  periodic_translation_(inner_relation.real_body_->periodic_translation_){};
+		~NeighborFieldAccessor(){};
+
+		Real W(const Neighborhood &neighborhood, size_t index_i, size_t n) const
+		{
+			if (storage_policy_.store_W_ij_)
+				return neighborhood.W_ij_[n];
+			Vecd displacement = getDisplacement(neighborhood, index_i, n);
+			return kernel_->W(displacement.norm(), displacement);
+		};
+
+		Real dW(const Neighborhood &neighborhood, size_t index_i, size_t n) const
+		{
+			if (storage_policy_.store_dW_ij_)
+				return neighborhood.dW_ij_[n];
+			Vecd displacement = getDisplacement(neighborhood, index_i, n);
+			return kernel_->dW(displacement.norm(), displacement);
+		};
+
+		Real r(const Neighborhood &neighborhood, size_t index_i, size_t n) const
+		{
+			if (storage_policy_.store_r_ij_)
+				return neighborhood.r_ij_[n];
+			return getDisplacement(neighborhood, index_i, n).norm();
+		};
+
+		Vecd e(const Neighborhood &neighborhood, size_t index_i, size_t n) const
+		{
+			if (storage_policy_.store_e_ij_)
+				return neighborhood.e_ij_[n];
+			Vecd displacement = getDisplacement(neighborhood, index_i, n);
+			return displacement / (displacement.norm() + TinyReal);
+		};
 	};
 
 	/**
@@ -137,16 +314,23 @@ namespace SPH
 	 */
 	class BodyRelationInner : public BaseBodyRelationInner
 	{
+	private:
+		UniquePtrKeeper<VerletSkinConfiguration> verlet_skin_configuration_ptr_keeper_;
+
 	protected:
 		SPHBodyParticlesIndex get_particle_index_;
 		SearchDepthSingleResolution get_single_search_depth_;
 		NeighborRelationInner get_inner_neighbor_;
 		CellLinkedList *cell_linked_list_;
+		VerletSkinConfiguration *verlet_skin_configuration_;
 
 	public:
 		explicit BodyRelationInner(RealBody &real_body);
 		virtual ~BodyRelationInner(){};
 
+		/** reuse the neighbor lists, searched with a skin, across time steps */
+		void useVerletSkin(Real skin_thickness);
+		virtual void setStoragePolicy(const NeighborStoragePolicy &storage_policy) override;
 		virtual void updateConfiguration() override;
 	};
 
@@ -211,8 +395,66 @@ namespace SPH
 		StdVec<CellLinkedList *> target_cell_linked_lists_;
 		StdVec<SearchDepthMultiResolution *> get_search_depths_;
 		StdVec<NeighborRelationContact *> get_contact_neighbors_;
+		StdVec<IndexVector> overlap_region_particles_; /**< source particles in the broad-phase overlap region */
 
 		virtual void resetNeighborhoodCurrentSize();
+		/** 
+		 * whether the broad phase of the SPH system is used, 
+		 * the broad phase is refreshed here if the cell linked list of any body has been updated since
+		 */
+		bool isBroadPhaseUsed();
+		/** whether the contact body is culled by the broad phase of the SPH system */
+		bool isContactBodyCulled(size_t contact_body_index);
+		BoundingBox OverlapRegion(size_t contact_body_index);
+		/** collect the source particles located in the overlap region with a contact body,
+		 * in parallel by chunks of particles and in the order of their indexes */
+		template <typename GetParticleIndex>
+		IndexVector &collectOverlapRegionParticles(size_t contact_body_index, size_t total_particles,
+												   GetParticleIndex &get_particle_index)
+		{
+			BoundingBox overlap_region = OverlapRegion(contact_body_index);
+			StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
+			size_t chunk_size = 4096;
+			size_t number_of_chunks = (total_particles + chunk_size - 1) / chunk_size;
+			IndexVector chunk_offsets(number_of_chunks + 1, 0);
+			parallel_for(
+				blocked_range<size_t>(0, number_of_chunks),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t chunk = r.begin(); chunk != r.end(); ++chunk)
+					{
+						size_t chunk_end = SMIN((chunk + 1) * chunk_size, total_particles);
+						for (size_t num = chunk * chunk_size; num != chunk_end; ++num)
+							if (checkIfPointInBoundingBox(pos_n[get_particle_index(num)], overlap_region))
+								chunk_offsets[chunk + 1]++;
+					}
+				},
+				ap);
+
+			for (size_t chunk = 0; chunk != number_of_chunks; ++chunk)
+				chunk_offsets[chunk + 1] += chunk_offsets[chunk];
+			IndexVector &particles = overlap_region_particles_[contact_body_index];
+			particles.resize(chunk_offsets[number_of_chunks]);
+
+			parallel_for(
+				blocked_range<size_t>(0, number_of_chunks),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t chunk = r.begin(); chunk != r.end(); ++chunk)
+					{
+						size_t offset = chunk_offsets[chunk];
+						size_t chunk_end = SMIN((chunk + 1) * chunk_size, total_particles);
+						for (size_t num = chunk * chunk_size; num != chunk_end; ++num)
+						{
+							size_t index_i = get_particle_index(num);
+							if (checkIfPointInBoundingBox(pos_n[index_i], overlap_region))
+								particles[offset++] = index_i;
+						}
+					}
+				},
+				ap);
+			return particles;
+		};
 
 	public:
 		RealBodyVector contact_bodies_;
@@ -231,8 +473,12 @@ namespace SPH
 	 */
 	class BodyRelationContact : public BaseBodyRelationContact
 	{
+	private:
+		UniquePtrVectorKeeper<VerletSkinConfiguration> verlet_skin_configuration_ptr_vector_keeper_;
+
 	protected:
 		SPHBodyParticlesIndex get_particle_index_;
+		StdVec<VerletSkinConfiguration *> verlet_skin_configurations_;
 
 		void initialization();
 
@@ -240,6 +486,9 @@ namespace SPH
 		BodyRelationContact(SPHBody &sph_body, RealBodyVector contact_bodies);
 		BodyRelationContact(SPHBody &sph_body, BodyPartVector contact_body_parts);
 		virtual ~BodyRelationContact(){};
+
+		/** reuse the neighbor lists, searched with a skin, across time steps */
+		virtual void useVerletSkin(Real skin_thickness);
 		virtual void updateConfiguration() override;
 	};
 
@@ -303,6 +552,7 @@ namespace SPH
 		BodyPartRelationContact(BodyPart &body_part, RealBodyVector contact_bodies);
 		virtual ~BodyPartRelationContact(){};
 
+		virtual void useVerletSkin(Real skin_thickness) override;
 		virtual void updateConfiguration() override;
 	};
 
@@ -322,6 +572,7 @@ namespace SPH
 		BodyRelationContactToBodyPart(RealBody &real_body, BodyPartVector contact_body_parts);
 		virtual ~BodyRelationContactToBodyPart(){};
 
+		virtual void useVerletSkin(Real skin_thickness) override;
 		virtual void updateConfiguration() override;
 	};
 
@@ -350,6 +601,8 @@ namespace SPH
 		ComplexBodyRelation(RealBody &real_body, BodyPartVector contact_body_parts);
 		virtual ~ComplexBodyRelation(){};
 
+		/** reuse the inner and contact neighbor lists, searched with a skin, across time steps */
+		void useVerletSkin(Real skin_thickness);
 		virtual void updateConfigurationMemories() override;
 		virtual void updateConfiguration() override;
 	};
@@ -18,6 +18,7 @@ namespace SPH {
 		//sorting is carried out once for 100 iterations
 		if (iteration_count_ % 100 == 0) sortParticleWithCellLinkedList();
 		iteration_count_++;
+		cell_linked_list_updates_++;
 		cell_linked_list_->UpdateCellLists();
 	}
 	//=================================================================================================//
@@ -0,0 +1,241 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+* @file 	component_major_data.h
+* @brief 	Component-major, i.e. structure-of-arrays, storage of vector and matrix
+*			particle variables, with proxy accessors and bulk update kernels.
+* @details	Each component is a scalar array, so that loops over particles
+*			run on contiguous data and can be vectorized by the compiler.
+* @author	Xiangyu Hu
+*/
+
+#ifndef COMPONENT_MAJOR_DATA_H
+#define COMPONENT_MAJOR_DATA_H
+
+#include "base_data_package.h"
+
+namespace SPH
+{
+	/** the components of a particle variable type */
+	template <typename VariableType>
+	struct ComponentMajorTraits;
+
+	template <>
+	struct ComponentMajorTraits<Vecd>
+	{
+		static const int number_of_components = Dimensions;
+		static Real &component(Vecd &value, int k) { return value[k]; };
+		static Real component(const Vecd &value, int k) { return value[k]; };
+	};
+
+	template <>
+	struct ComponentMajorTraits<Matd>
+	{
+		static const int number_of_components = Dimensions * Dimensions;
+		static Real &component(Matd &value, int k) { return value(k / Dimensions, k % Dimensions); };
+		static Real component(const Matd &value, int k) { return value(k / Dimensions, k % Dimensions); };
+	};
+
+	template <typename VariableType>
+	class ComponentMajorVariable;
+
+	/**
+	 * @class ComponentMajorReference
+	 * @brief Proxy of the value of one particle in a component-major variable.
+	 */
+	template <typename VariableType>
+	class ComponentMajorReference
+	{
+		typedef ComponentMajorTraits<VariableType> Traits;
+		ComponentMajorVariable<VariableType> &variable_;
+		size_t index_i_;
+
+	public:
+		ComponentMajorReference(ComponentMajorVariable<VariableType> &variable, size_t index_i)
+			: variable_(variable), index_i_(index_i){};
+
+		operator VariableType() const { return variable_.get(index_i_); };
+		ComponentMajorReference &operator=(const VariableType &value)
+		{
+			variable_.set(index_i_, value);
+			return *this;
+		};
+		ComponentMajorReference &operator=(const ComponentMajorReference &other)
+		{
+			variable_.set(index_i_, other.variable_.get(other.index_i_));
+			return *this;
+		};
+		ComponentMajorReference &operator+=(const VariableType &value)
+		{
+			for (int k = 0; k != Traits::number_of_components; ++k)
+				variable_.component(k)[index_i_] += Traits::component(value, k);
+			return *this;
+		};
+		ComponentMajorReference &operator-=(const VariableType &value)
+		{
+			for (int k = 0; k != Traits::number_of_components; ++k)
+				variable_.component(k)[index_i_] -= Traits::component(value, k);
+			return *this;
+		};
+	};
+
+	/**
+	 * @class ComponentMajorVariable
+	 * @brief A vector or matrix particle variable stored as one scalar array per component.
+	 * When registered in BaseParticles, each component is a scalar particle variable,
+	 * so that adding, copying, sorting and writing particles apply to it as usual.
+	 * The value of a particle is accessed by get and set, or by the proxy from operator[],
+	 * which converts to the variable type in typed expressions such as Vecd pos_i = pos[index_i].
+	 */
+	template <typename VariableType>
+	class ComponentMajorVariable
+	{
+		typedef ComponentMajorTraits<VariableType> Traits;
+
+	public:
+		static const int number_of_components = Traits::number_of_components;
+
+		ComponentMajorVariable(){};
+		~ComponentMajorVariable(){};
+
+		std::string name_;
+
+		size_t size() const { return components_[0].size(); };
+		void resize(size_t new_size, const VariableType &value = VariableType(0))
+		{
+			for (int k = 0; k != number_of_components; ++k)
+				components_[k].resize(new_size, Traits::component(value, k));
+		};
+		void push_back(const VariableType &value)
+		{
+			for (int k = 0; k != number_of_components; ++k)
+				components_[k].push_back(Traits::component(value, k));
+		};
+
+		StdLargeVec<Real> &component(int k) { return components_[k]; };
+		const StdLargeVec<Real> &component(int k) const { return components_[k]; };
+
+		VariableType get(size_t index_i) const
+		{
+			VariableType value;
+			for (int k = 0; k != number_of_components; ++k)
+				Traits::component(value, k) = components_[k][index_i];
+			return value;
+		};
+		void set(size_t index_i, const VariableType &value)
+		{
+			for (int k = 0; k != number_of_components; ++k)
+				components_[k][index_i] = Traits::component(value, k);
+		};
+		ComponentMajorReference<VariableType> operator[](size_t index_i)
+		{
+			return ComponentMajorReference<VariableType>(*this, index_i);
+		};
+		VariableType operator[](size_t index_i) const { return get(index_i); };
+
+		/** copy the values of the first particles from and to the array-of-structures storage */
+		void copyFrom(const StdLargeVec<VariableType> &variable, size_t number_of_particles)
+		{
+			for (int k = 0; k != number_of_components; ++k)
+			{
+				Real *component_k = components_[k].data();
+				for (size_t i = 0; i != number_of_particles; ++i)
+					component_k[i] = Traits::component(variable[i], k);
+			}
+		};
+		void copyTo(StdLargeVec<VariableType> &variable, size_t number_of_particles) const
+		{
+			for (int k = 0; k != number_of_components; ++k)
+			{
+				const Real *component_k = components_[k].data();
+				for (size_t i = 0; i != number_of_particles; ++i)
+					Traits::component(variable[i], k) = component_k[i];
+			}
+		};
+
+	protected:
+		std::array<StdLargeVec<Real>, Traits::number_of_components> components_;
+	};
+
+	/** variable += factor * change for the particles in [begin, end), e.g. the integration
+	 *  of the position by the velocity or of the deformation gradient by its rate of change. */
+	template <typename VariableType>
+	void addScaledComponents(ComponentMajorVariable<VariableType> &variable, Real factor,
+							 const ComponentMajorVariable<VariableType> &change, size_t begin, size_t end)
+	{
+		for (int k = 0; k != ComponentMajorVariable<VariableType>::number_of_components; ++k)
+		{
+			Real *variable_k = variable.component(k).data();
+			const Real *change_k = change.component(k).data();
+			for (size_t i = begin; i != end; ++i)
+				variable_k[i] += factor * change_k[i];
+		}
+	}
+
+	/** variable += factor * (first_change + second_change) for the particles in [begin, end),
+	 *  e.g. the integration of the velocity by the inner and prior accelerations. */
+	template <typename VariableType>
+	void addScaledComponents(ComponentMajorVariable<VariableType> &variable, Real factor,
+							 const ComponentMajorVariable<VariableType> &first_change,
+							 const ComponentMajorVariable<VariableType> &second_change, size_t begin, size_t end)
+	{
+		for (int k = 0; k != ComponentMajorVariable<VariableType>::number_of_components; ++k)
+		{
+			Real *variable_k = variable.component(k).data();
+			const Real *first_change_k = first_change.component(k).data();
+			const Real *second_change_k = second_change.component(k).data();
+			for (size_t i = begin; i != end; ++i)
+				variable_k[i] += factor * (first_change_k[i] + second_change_k[i]);
+		}
+	}
+
+	/** the bulk update in parallel over all the given particles */
+	template <typename VariableType>
+	void addScaledComponents_parallel(ComponentMajorVariable<VariableType> &variable, Real factor,
+									  const ComponentMajorVariable<VariableType> &change, size_t total_particles)
+	{
+		parallel_for(
+			blocked_range<size_t>(0, total_particles, 1024),
+			[&](const blocked_range<size_t> &r)
+			{
+				addScaledComponents(variable, factor, change, r.begin(), r.end());
+			},
+			tbb::static_partitioner());
+	}
+
+	/** the bulk update with two changes in parallel over all the given particles */
+	template <typename VariableType>
+	void addScaledComponents_parallel(ComponentMajorVariable<VariableType> &variable, Real factor,
+									  const ComponentMajorVariable<VariableType> &first_change,
+									  const ComponentMajorVariable<VariableType> &second_change, size_t total_particles)
+	{
+		parallel_for(
+			blocked_range<size_t>(0, total_particles, 1024),
+			[&](const blocked_range<size_t> &r)
+			{
+				addScaledComponents(variable, factor, first_change, second_change, r.begin(), r.end());
+			},
+			tbb::static_partitioner());
+	}
+}
+#endif //COMPONENT_MAJOR_DATA_H
@@ -0,0 +1,84 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+ * @file 	counter_based_random.h
+ * @brief 	Counter-based random numbers by the Philox4x32-10 generator.
+ * @details A random number is a pure function of the key (seed and stream)
+ *			and the counter (step, particle index and draw). There is no state shared between threads,
+ *			so that the random numbers are reproducible regardless of the parallel scheduling.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef COUNTER_BASED_RANDOM_H
+#define COUNTER_BASED_RANDOM_H
+
+#include "base_data_type.h"
+
+#include <array>
+#include <cstdint>
+
+namespace SPH
+{
+	/**
+	 * @class CounterBasedRandom
+	 * @brief Philox4x32-10 random numbers keyed by a seed and a stream,
+	 * and counted by step, index and draw.
+	 */
+	class CounterBasedRandom
+	{
+	public:
+		explicit CounterBasedRandom(uint32_t seed = 0, uint32_t stream = 0)
+			: key_{{seed, stream}} {};
+		~CounterBasedRandom(){};
+
+		/** four random 32-bit integers of a 128-bit counter */
+		std::array<uint32_t, 4> generate(const std::array<uint32_t, 4> &counter) const
+		{
+			std::array<uint32_t, 4> x = counter;
+			std::array<uint32_t, 2> key = key_;
+			for (int round = 0; round != 10; ++round)
+			{
+				uint64_t product_0 = uint64_t(0xD2511F53) * x[0];
+				uint64_t product_1 = uint64_t(0xCD9E8D57) * x[2];
+				x = {{uint32_t(product_1 >> 32) ^ x[1] ^ key[0], uint32_t(product_1),
+					  uint32_t(product_0 >> 32) ^ x[3] ^ key[1], uint32_t(product_0)}};
+				key[0] += 0x9E3779B9;
+				key[1] += 0xBB67AE85;
+			}
+			return x;
+		};
+
+		/** uniform random number in (0, 1) for a step, an index and a draw of the same index */
+		Real uniform(size_t step, size_t index, size_t draw = 0) const
+		{
+			uint64_t index_64 = index;
+			std::array<uint32_t, 4> counter = {{uint32_t(index_64), uint32_t(index_64 >> 32),
+												uint32_t(step), uint32_t(draw / 4)}};
+			return (Real(generate(counter)[draw % 4]) + 0.5) * 2.3283064365386963e-10;
+		};
+
+	protected:
+		std::array<uint32_t, 2> key_;
+	};
+}
+#endif //COUNTER_BASED_RANDOM_H
@@ -0,0 +1,145 @@
+/**
+ * @file 	execution_policy.cpp
+ * @author	Xiangyu Hu
+ */
+#include "execution_policy.h"
+
+#include <fstream>
+//=============================================================================================//
+namespace SPH
+{
+	//=============================================================================================//
+	std::map<std::string, std::pair<PartitionerType, size_t>> ExecutionPolicy::tuned_policies_;
+	std::mutex ExecutionPolicy::tuned_policies_mutex_;
+	//=============================================================================================//
+	ExecutionPolicy::ExecutionPolicy(PartitionerType partitioner_type, size_t grain_size)
+		: partitioner_type_(partitioner_type), grain_size_(grain_size),
+		  is_tuning_(false), samples_per_candidate_(0), samples_(0), current_candidate_(0) {}
+	//=============================================================================================//
+	ExecutionPolicy::ExecutionPolicy(const ExecutionPolicy &other)
+		: ExecutionPolicy(other.partitioner_type_, other.grain_size_) {}
+	//=============================================================================================//
+	ExecutionPolicy &ExecutionPolicy::operator=(const ExecutionPolicy &other)
+	{
+		setPolicy(other.partitioner_type_, other.grain_size_);
+		return *this;
+	}
+	//=============================================================================================//
+	void ExecutionPolicy::setPolicy(PartitionerType partitioner_type, size_t grain_size)
+	{
+		partitioner_type_ = partitioner_type;
+		grain_size_ = grain_size;
+		is_tuning_ = false;
+	}
+	//=============================================================================================//
+	void ExecutionPolicy::autotune(const std::string &name, size_t samples_per_candidate)
+	{
+		name_ = name;
+		{
+			std::lock_guard<std::mutex> lock(tuned_policies_mutex_);
+			auto tuned = tuned_policies_.find(name_);
+			if (tuned != tuned_policies_.end())
+			{
+				setPolicy(tuned->second.first, tuned->second.second);
+				return;
+			}
+		}
+
+		candidates_.clear();
+		candidates_.push_back(std::make_pair(PartitionerType::Affinity, size_t(1)));
+		candidates_.push_back(std::make_pair(PartitionerType::Auto, size_t(1)));
+		candidates_.push_back(std::make_pair(PartitionerType::Static, size_t(1)));
+		candidates_.push_back(std::make_pair(PartitionerType::Simple, size_t(64)));
+		candidates_.push_back(std::make_pair(PartitionerType::Simple, size_t(512)));
+		candidates_.push_back(std::make_pair(PartitionerType::Sequential, size_t(1)));
+		candidate_times_.assign(candidates_.size(), 0.0);
+
+		samples_per_candidate_ = SMAX(samples_per_candidate, size_t(1));
+		samples_ = 0;
+		current_candidate_ = 0;
+		partitioner_type_ = candidates_[0].first;
+		grain_size_ = candidates_[0].second;
+		is_tuning_ = true;
+	}
+	//=============================================================================================//
+	void ExecutionPolicy::startExecution()
+	{
+		if (is_tuning_)
+			execution_start_ = tick_count::now();
+	}
+	//=============================================================================================//
+	void ExecutionPolicy::finishExecution()
+	{
+		if (is_tuning_)
+			recordSample((tick_count::now() - execution_start_).seconds());
+	}
+	//=============================================================================================//
+	void ExecutionPolicy::recordSample(Real time_interval)
+	{
+		/** the first sample of each candidate only warms up the caches and the affinity history */
+		if (samples_ != 0)
+			candidate_times_[current_candidate_] += time_interval;
+		++samples_;
+		if (samples_ <= samples_per_candidate_)
+			return;
+
+		samples_ = 0;
+		++current_candidate_;
+		if (current_candidate_ < candidates_.size())
+		{
+			partitioner_type_ = candidates_[current_candidate_].first;
+			grain_size_ = candidates_[current_candidate_].second;
+			return;
+		}
+
+		size_t fastest = 0;
+		for (size_t k = 1; k != candidates_.size(); ++k)
+		{
+			if (candidate_times_[k] < candidate_times_[fastest])
+				fastest = k;
+		}
+		setPolicy(candidates_[fastest].first, candidates_[fastest].second);
+
+		std::lock_guard<std::mutex> lock(tuned_policies_mutex_);
+		tuned_policies_[name_] = candidates_[fastest];
+	}
+	//=============================================================================================//
+	void ExecutionPolicy::writeTunedPolicies(const std::string &filefullpath)
+	{
+		std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+		if (!out_file.is_open())
+		{
+			std::cout << "\n Error: the execution policy file " << filefullpath << " can not be written!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+
+		std::lock_guard<std::mutex> lock(tuned_policies_mutex_);
+		for (auto &tuned : tuned_policies_)
+		{
+			out_file << tuned.first << " " << static_cast<int>(tuned.second.first)
+					 << " " << tuned.second.second << "\n";
+		}
+	}
+	//=============================================================================================//
+	void ExecutionPolicy::readTunedPolicies(const std::string &filefullpath)
+	{
+		std::ifstream in_file(filefullpath.c_str());
+		if (!in_file.is_open())
+			return;
+
+		std::lock_guard<std::mutex> lock(tuned_policies_mutex_);
+		std::string name;
+		int partitioner_type;
+		size_t grain_size;
+		while (in_file >> name >> partitioner_type >> grain_size)
+		{
+			if (partitioner_type < static_cast<int>(PartitionerType::Affinity) ||
+				partitioner_type > static_cast<int>(PartitionerType::Sequential))
+				continue;
+			tuned_policies_[name] = std::make_pair(static_cast<PartitionerType>(partitioner_type), grain_size);
+		}
+	}
+	//=============================================================================================//
+}
+//=============================================================================================//
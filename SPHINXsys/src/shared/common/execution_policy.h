@@ -0,0 +1,158 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+* @file 	execution_policy.h
+* @brief 	The execution policy of the parallel loops of a particle dynamics,
+*			i.e. the partitioner and grain size, with optional autotuning.
+* @author	Xiangyu Hu
+*/
+
+#ifndef EXECUTION_POLICY_H
+#define EXECUTION_POLICY_H
+
+#include "base_data_package.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace SPH
+{
+	/** partitioners for the parallel loops of particle dynamics */
+	enum class PartitionerType
+	{
+		Affinity,
+		Auto,
+		Simple,
+		Static,
+		Sequential
+	};
+
+	/**
+	 * @class ExecutionPolicy
+	 * @brief The partitioner and grain size for the parallel loops of a particle dynamics.
+	 * Each policy has its own affinity partitioner, so that loops of different cost and size
+	 * do not share one affinity history. With autotuning, the candidate settings are measured
+	 * for a few executions each, timed as a whole from startExecution to finishExecution,
+	 * and the fastest one is kept. All loops of an execution use the same candidate.
+	 * Tuned settings are registered by name, and can be written to and read from a file for later runs.
+	 */
+	class ExecutionPolicy
+	{
+	public:
+		explicit ExecutionPolicy(PartitionerType partitioner_type = PartitionerType::Affinity, size_t grain_size = 1);
+		/** copy the settings only, the affinity history and the tuning state are not shared */
+		ExecutionPolicy(const ExecutionPolicy &other);
+		ExecutionPolicy &operator=(const ExecutionPolicy &other);
+		virtual ~ExecutionPolicy(){};
+
+		void setPolicy(PartitionerType partitioner_type, size_t grain_size = 1);
+		PartitionerType getPartitionerType() { return partitioner_type_; };
+		size_t getGrainSize() { return grain_size_; };
+		/** use the tuned setting registered under the name, or start tuning if there is none */
+		void autotune(const std::string &name, size_t samples_per_candidate = 5);
+		bool isTuning() { return is_tuning_; };
+		/** bracket a whole execution of the particle dynamics, the candidate is changed only after it */
+		void startExecution();
+		void finishExecution();
+
+		/** loop over [0, size) with a body taking a blocked_range<size_t> */
+		template <class RangeBody>
+		void parallelFor(size_t size, const RangeBody &range_body);
+		/** reduce over [0, size) with a body taking a blocked_range<size_t> and a partial result */
+		template <class ReturnType, class RangeBody, class JoinOperation>
+		ReturnType parallelReduce(size_t size, const ReturnType &identity,
+								  const RangeBody &range_body, const JoinOperation &join_operation);
+
+		static void writeTunedPolicies(const std::string &filefullpath);
+		static void readTunedPolicies(const std::string &filefullpath);
+
+	protected:
+		PartitionerType partitioner_type_;
+		size_t grain_size_;
+		tbb::affinity_partitioner affinity_partitioner_;
+
+		std::string name_;
+		bool is_tuning_;
+		size_t samples_per_candidate_, samples_;
+		size_t current_candidate_;
+		StdVec<std::pair<PartitionerType, size_t>> candidates_;
+		StdVec<Real> candidate_times_;
+		tick_count execution_start_;
+		void recordSample(Real time_interval);
+
+		static std::map<std::string, std::pair<PartitionerType, size_t>> tuned_policies_;
+		static std::mutex tuned_policies_mutex_;
+	};
+	//=================================================================================================//
+	template <class RangeBody>
+	void ExecutionPolicy::parallelFor(size_t size, const RangeBody &range_body)
+	{
+		blocked_range<size_t> range(0, size, SMAX(grain_size_, size_t(1)));
+		switch (partitioner_type_)
+		{
+		case PartitionerType::Auto:
+			tbb::parallel_for(range, range_body, tbb::auto_partitioner());
+			break;
+		case PartitionerType::Simple:
+			tbb::parallel_for(range, range_body, tbb::simple_partitioner());
+			break;
+		case PartitionerType::Static:
+			tbb::parallel_for(range, range_body, tbb::static_partitioner());
+			break;
+		case PartitionerType::Sequential:
+			range_body(blocked_range<size_t>(0, size));
+			break;
+		default:
+			tbb::parallel_for(range, range_body, affinity_partitioner_);
+		}
+	}
+	//=================================================================================================//
+	template <class ReturnType, class RangeBody, class JoinOperation>
+	ReturnType ExecutionPolicy::parallelReduce(size_t size, const ReturnType &identity,
+											   const RangeBody &range_body, const JoinOperation &join_operation)
+	{
+		blocked_range<size_t> range(0, size, SMAX(grain_size_, size_t(1)));
+		ReturnType result;
+		switch (partitioner_type_)
+		{
+		case PartitionerType::Auto:
+			result = tbb::parallel_reduce(range, identity, range_body, join_operation, tbb::auto_partitioner());
+			break;
+		case PartitionerType::Simple:
+			result = tbb::parallel_reduce(range, identity, range_body, join_operation, tbb::simple_partitioner());
+			break;
+		case PartitionerType::Static:
+			result = tbb::parallel_reduce(range, identity, range_body, join_operation, tbb::static_partitioner());
+			break;
+		case PartitionerType::Sequential:
+			result = range_body(blocked_range<size_t>(0, size), identity);
+			break;
+		default:
+			result = tbb::parallel_reduce(range, identity, range_body, join_operation, affinity_partitioner_);
+		}
+		return result;
+	}
+	//=================================================================================================//
+}
+#endif //EXECUTION_POLICY_H
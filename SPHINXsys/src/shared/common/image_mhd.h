@@ -38,6 +38,15 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <atomic>
+#include <mutex>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define IMAGE_MHD_MEMORY_MAPPING
+#endif
 
 namespace SPH {
 
@@ -54,13 +63,20 @@ namespace SPH {
 		ASCII
 	};
 
+	/** storage of the image data, memory mapped data are paged in by the OS on demand and are read only */
+	enum Storage_Mode
+	{
+		IN_MEMORY,
+		MEMORY_MAPPED
+	};
+
 	template <typename T, int nDims>
 	class ImageMHD
 	{
 	public:
-		ImageMHD() {};
+		ImageMHD() : is_value_range_found_(false) {};
 		// constructor for input files
-		ImageMHD(std::string full_path_file);
+		ImageMHD(std::string full_path_file, Storage_Mode storage_mode = IN_MEMORY);
 		// constructor for sphere 
 		ImageMHD(Real radius, Vec3i dxdydz, Vec3d spacings);
 		~ImageMHD();
@@ -85,6 +101,7 @@ namespace SPH {
 		void set_transformMatrix(Mat3d transformMatrix) 
 		{ 
 			transformMatrix_ = transformMatrix; 
+			inverseTransformMatrix_ = transformMatrix_.invert();
 		};
 		void set_offset(Vec3d offset) 
 		{ 
@@ -119,13 +136,35 @@ namespace SPH {
 
 		int get_size() { return size_; }
 
-		Real get_min_value() { return min_value_; };
-		Real get_max_value() { return max_value_; };
+		/** the value range is taken from the header if given, otherwise found when first requested */
+		Real get_min_value()
+		{
+			findValueRange();
+			return min_value_;
+		};
+		Real get_max_value()
+		{
+			findValueRange();
+			return max_value_;
+		};
 
 		Vec3d findClosestPoint(const Vec3d& input_pnt);
 		BoundingBox findBounds();
 		Real findValueAtPoint(const Vec3d& input_pnt);
 		Vec3d findNormalAtPoint(const Vec3d & input_pnt);
+		/** 
+		 * batched probes, the points are processed in parallel in the order of the image memory
+		 * so that the voxels, especially those of a memory mapped image, are visited coherently.
+		 */
+		void findValuesAtPoints(const StdVec<Vec3d> &input_pnts, StdVec<Real> &values);
+		void findNormalsAtPoints(const StdVec<Vec3d> &input_pnts, StdVec<Vec3d> &normals);
+
+		/** 
+		 * replace a binary or label image by the signed distance to the voxels with the given label,
+		 * non-positive label takes all voxels with positive values as inside.
+		 * The distance is negative inside and computed by a separable exact Euclidean distance transform.
+		 */
+		void transformToSignedDistance(int label = 0);
 
 		void write(std::string filename, Output_Mode=BINARY);
 
@@ -136,6 +175,7 @@ namespace SPH {
 		bool binaryDataByteOrderMSB_;
 		bool compressedData_;
 		Mat3d transformMatrix_;
+		Mat3d inverseTransformMatrix_;
 		Vec3d offset_;
 		Vec3d centerOfRotation_;
 		Vec3d elementSpacing_;
@@ -149,14 +189,29 @@ namespace SPH {
 		std::string elementDataFile_;
 		Real min_value_;
 		Real max_value_;
+		std::atomic<bool> is_value_range_found_;
+		std::mutex value_range_mutex_;
+		Storage_Mode storage_mode_;
 		T *data_;
 
+		void readRawFile(const std::string &file_path_to_raw_file);
+		template <typename ElementType>
+		void readRawFileElements(std::ifstream &data_file_raw);
+		void mapRawFile(const std::string &file_path_to_raw_file);
+
+		void findValueRange();
 		std::vector<int> findNeighbors(const Vec3d& input_pnt, Vec3i& this_cell);
+		/** the cell of a point and the number of its stencil entries, zero if the point is outside of the image */
+		int findStencilCell(const Vec3d &input_pnt, int &cell_index);
+		Real findValueAtStencil(int cell_index, int stencil_size);
+		Vec3d findNormalAtStencil(int cell_index, int stencil_size);
 		Vec3d computeGradientAtCell(int i);
 		Vec3d computeNormalAtCell(int i);
 		T getValueAtCell(int i);
 		Vec3d convertToPhysicalSpace(Vec3d p);
 		void split(const std::string &s, char delim, std::vector<std::string> &elems);
+		void squaredDistanceTransform(StdVec<Real> &squared_distance);
+		void squaredDistanceTransformLine(StdVec<Real> &f, StdVec<Real> &d, StdVec<int> &v, StdVec<Real> &z, int n, Real h2);
 	};
 
 }
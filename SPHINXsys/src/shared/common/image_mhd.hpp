@@ -38,13 +38,14 @@
 namespace SPH {
 
 	template<typename T, int nDims>
-	ImageMHD<T, nDims>::ImageMHD(std::string full_path_to_file):
+	ImageMHD<T, nDims>::ImageMHD(std::string full_path_to_file, Storage_Mode storage_mode):
 		objectType_("Image"),
 		ndims_(nDims),
 		binaryData_(true),
 		binaryDataByteOrderMSB_(false),
 		compressedData_(false),
 		transformMatrix_(Mat3d(1.0)),
+		inverseTransformMatrix_(Mat3d(1.0)),
 		offset_(Vec3d(0.0,0.0,0.0)),
 		centerOfRotation_(Vec3d(0.0,0.0,0.0)),
 		elementSpacing_(Vec3d(1.0,1.0,1.0)),
@@ -58,12 +59,21 @@ namespace SPH {
 		elementDataFile_(""),
 		min_value_(Infinity),
 		max_value_(-Infinity),
+		storage_mode_(storage_mode),
 		data_(nullptr)
 	{
 		//- read mhd file
 		std::ifstream dataFile(full_path_to_file, std::ifstream::in);
 		std::string file_path_to_raw_file;
-		if (dataFile.is_open())
+		bool has_min_value = false;
+		bool has_max_value = false;
+		if (!dataFile.is_open())
+		{
+			std::cout << "\n Error: the image file " << full_path_to_file << " can not be opened!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		else
 		{
 			std::string line;
 			std::vector<std::string> values;
@@ -117,8 +127,25 @@ namespace SPH {
 						height_ = dimSize_[1];
 						depth_ = dimSize_[2];
 						size_ = width_ * height_*depth_;
-						if(data_ == nullptr)
-							data_ = new T[dimSize_[0] * dimSize_[1] * dimSize_[2]];
+					}
+					else if (elements[0].compare("ElementType") == 0)
+					{
+						if (elements[1].compare("MET_UCHAR") == 0)
+							elementType_ = MET_UCHAR;
+						else if (elements[1].compare("MET_LONG") == 0)
+							elementType_ = MET_LONG;
+						else
+							elementType_ = MET_FLOAT;
+					}
+					else if (elements[0].compare("ElementMin") == 0)
+					{
+						min_value_ = std::stof(elements[1]);
+						has_min_value = true;
+					}
+					else if (elements[0].compare("ElementMax") == 0)
+					{
+						max_value_ = std::stof(elements[1]);
+						has_max_value = true;
 					}
 					else if (elements[0].compare("ElementDataFile") == 0)
 					{
@@ -130,28 +157,30 @@ namespace SPH {
 		}
 
 		dataFile.close();
+		inverseTransformMatrix_ = transformMatrix_.invert();
 		std::cout << "dimensions: " << dimSize_ << std::endl;
 		std::cout << "spacing: " << elementSpacing_ << std::endl;
 		std::cout << "offset: " << offset_ << std::endl;
 		std::cout << "transformMatrix: " << transformMatrix_ << std::endl;
 
-		//- read raw file
-		std::ifstream dataFileRaw(file_path_to_raw_file, std::ios::in | std::ios::binary);
-
-		if (dataFileRaw.is_open())
+		//- read or map raw file, only float data can be mapped directly
+		if (storage_mode_ == MEMORY_MAPPED && elementType_ != MET_FLOAT)
 		{
-			dataFileRaw.read((char*)data_, sizeof(T)*size_);
-			T distance = 0;
-			for(int index = 0; index<size_; index++)
-			{
-				distance = data_[index];
-				data_[index] = distance;
-				//std::cout <<index <<" "<< distance << '\n';
-				if (distance < min_value_) min_value_ = distance;
-				if (distance > max_value_) max_value_ = distance;
-			}
+			std::cout << "\n Only MET_FLOAT images can be memory mapped, the raw file is read into memory." << std::endl;
+			storage_mode_ = IN_MEMORY;
 		}
-		dataFileRaw.close();
+		if (storage_mode_ == MEMORY_MAPPED)
+		{
+			mapRawFile(file_path_to_raw_file);
+		}
+		else
+		{
+			readRawFile(file_path_to_raw_file);
+		}
+
+		//- without the range in the header, the data are scanned only when the range is requested,
+		//- so that a memory mapped image is not paged in as a whole
+		is_value_range_found_ = has_min_value && has_max_value;
 
 		//write(std::string("sphere-binary"),ASCII);
 	}
@@ -163,6 +192,7 @@ namespace SPH {
 		binaryDataByteOrderMSB_(false),
 		compressedData_(false),
 		transformMatrix_(Mat3d(1.0)),
+		inverseTransformMatrix_(Mat3d(1.0)),
 		offset_(Vec3d(-0.5*NxNyNz[0]*spacings[0], -0.5*NxNyNz[1] * spacings[1], -0.5*NxNyNz[2] * spacings[2])),
 		centerOfRotation_(Vec3d(0.0, 0.0, 0.0)),
 		elementSpacing_(spacings),
@@ -176,6 +206,7 @@ namespace SPH {
 		elementDataFile_(""),
 		min_value_(Infinity),
 		max_value_(-Infinity),
+		storage_mode_(IN_MEMORY),
 		data_(nullptr)
 	{
 		if(data_ == nullptr) 
@@ -197,6 +228,7 @@ namespace SPH {
 				}
 			}
 		}
+		is_value_range_found_ = true;
 		write(std::string("sphere"), BINARY);
 	}
 
@@ -205,18 +237,115 @@ namespace SPH {
 	{
 		if (data_)
 		{
-			delete data_;
+#ifdef IMAGE_MHD_MEMORY_MAPPING
+			if (storage_mode_ == MEMORY_MAPPED)
+			{
+				munmap(data_, sizeof(T) * size_);
+				data_ = nullptr;
+				return;
+			}
+#endif
+			delete[] data_;
 			data_ = nullptr;
 		}
 	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	void ImageMHD<T, nDims>::readRawFile(const std::string &file_path_to_raw_file)
+	{
+		if (data_ == nullptr)
+			data_ = new T[size_];
 
+		std::ifstream dataFileRaw(file_path_to_raw_file, std::ios::in | std::ios::binary);
+		if (!dataFileRaw.is_open())
+		{
+			std::cout << "\n Error: the raw file " << file_path_to_raw_file << " can not be opened!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		if (elementType_ == MET_UCHAR)
+			readRawFileElements<unsigned char>(dataFileRaw);
+		else if (elementType_ == MET_LONG)
+			readRawFileElements<int32_t>(dataFileRaw);
+		else
+			dataFileRaw.read((char*)data_, sizeof(T)*size_);
+		if (!dataFileRaw)
+		{
+			std::cout << "\n Error: the raw file " << file_path_to_raw_file << " is shorter than the image size!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		dataFileRaw.close();
+		//- the data are kept in the image type from now on
+		elementType_ = MET_FLOAT;
+	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	template <typename ElementType>
+	void ImageMHD<T, nDims>::readRawFileElements(std::ifstream &data_file_raw)
+	{
+		std::vector<ElementType> elements(size_);
+		data_file_raw.read((char*)elements.data(), sizeof(ElementType)*size_);
+		for (int index = 0; index < size_; index++)
+		{
+			data_[index] = T(elements[index]);
+		}
+	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	void ImageMHD<T, nDims>::mapRawFile(const std::string &file_path_to_raw_file)
+	{
+#ifdef IMAGE_MHD_MEMORY_MAPPING
+		size_t data_bytes = sizeof(T) * size_;
+		int file_descriptor = open(file_path_to_raw_file.c_str(), O_RDONLY);
+		if (file_descriptor < 0 || lseek(file_descriptor, 0, SEEK_END) < (off_t)data_bytes)
+		{
+			std::cout << "\n Error: the raw file " << file_path_to_raw_file << " can not be mapped!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		void *mapped_data = mmap(nullptr, data_bytes, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+		close(file_descriptor);
+		if (mapped_data == MAP_FAILED)
+		{
+			std::cout << "\n Error: the raw file " << file_path_to_raw_file << " can not be mapped!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		//- probes access the volume randomly
+		madvise(mapped_data, data_bytes, MADV_RANDOM);
+		data_ = static_cast<T *>(mapped_data);
+#else
+		std::cout << "\n Memory mapping is not available, the raw file is read into memory." << std::endl;
+		storage_mode_ = IN_MEMORY;
+		readRawFile(file_path_to_raw_file);
+#endif
+	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	void ImageMHD<T, nDims>::findValueRange()
+	{
+		if (is_value_range_found_) return;
+
+		std::lock_guard<std::mutex> lock(value_range_mutex_);
+		if (is_value_range_found_) return;
+		min_value_ = Infinity;
+		max_value_ = -Infinity;
+		for (int index = 0; index < size_; index++)
+		{
+			T distance = data_[index];
+			if (distance < min_value_) min_value_ = distance;
+			if (distance > max_value_) max_value_ = distance;
+		}
+		is_value_range_found_ = true;
+	}
 	//=================================================================================================//
 	template<typename T, int nDims>
 	std::vector<int> ImageMHD<T, nDims>::findNeighbors(const Vec3d& input_pnt, Vec3i& this_cell)
 	{
 		std::vector<int> neighbors;
 
-		Vec3d image_coord = transformMatrix_.invert()*(input_pnt - offset_);
+		Vec3d image_coord = inverseTransformMatrix_*(input_pnt - offset_);
 		// std::cout <<"findNeighbor of " << input_pnt << " ........... " << image_coord << std::endl;
 
 		int z = int(floor(image_coord[2]));
@@ -330,7 +459,7 @@ namespace SPH {
 	{
 		if (i < 0 || i > size_)
 		{
-			return float(max_value_);
+			return float(get_max_value());
 		}
 		else
 		{
@@ -415,60 +544,240 @@ namespace SPH {
 	}
 
 	template<typename T, int nDims>
-	Real ImageMHD<T, nDims>::findValueAtPoint(const Vec3d& input_pnt)
+	int ImageMHD<T, nDims>::findStencilCell(const Vec3d &input_pnt, int &cell_index)
 	{
-		Vec3i this_cell;
-		std::vector<int> neighbors = findNeighbors(input_pnt, this_cell);
+		Vec3d image_coord = inverseTransformMatrix_*(input_pnt - offset_);
+
+		int z = int(floor(image_coord[2]));
+		int y = int(floor(image_coord[1]));
+		int x = int(floor(image_coord[0]));
+
+		//- cannot count cells in buffer zone
+		if (x < 0 || x > width_ - 1 || y < 0 || y > height_ - 1 || z < 0 || z > depth_ - 1) return 0;
+
+		//- the same stencil as findNeighbors, whose entries all refer to the cell itself
+		int stencil_size = 0;
+		for (int k = z - 1; k < z + 2; k = k + 2)
+			for (int j = y - 1; j < y + 2; j = j + 2)
+				for (int i = x - 1; i < x + 2; i = i + 2)
+				{
+					if (i<0 || i >width_ - 1 || j <0 || j >height_ - 1 || k<0 || k >depth_)
+						continue;
+					stencil_size++;
+				}
+
+		cell_index = z * width_*height_ + y * width_ + x;
+		return stencil_size;
+	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	Real ImageMHD<T, nDims>::findValueAtStencil(int cell_index, int stencil_size)
+	{
+		double dCj = float(getValueAtCell(cell_index));
+		double weight_Cj = 1.0 / (fabs(dCj) + Eps);
 		double weight_sum = 0.0;
 		double d_sum = 0.0;
-		if (neighbors.size() > 0)
+		for (int n = 0; n != stencil_size; ++n)
 		{
-			for (const int& i : neighbors)
-			{
-				// checkIndexBound(i);
-				double dCj = float(getValueAtCell(i));
-				double weight_Cj = 1.0 / (fabs(dCj) + Eps);
-				weight_sum = weight_sum + weight_Cj;
-				d_sum = d_sum + dCj;
-			}
-			return d_sum / (weight_sum + Eps);
+			weight_sum = weight_sum + weight_Cj;
+			d_sum = d_sum + dCj;
 		}
-		else
+		return d_sum / (weight_sum + Eps);
+	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	Vec3d ImageMHD<T, nDims>::findNormalAtStencil(int cell_index, int stencil_size)
+	{
+		Vec3d nCj = computeNormalAtCell(cell_index);
+		double dCj = float(getValueAtCell(cell_index));
+		double weight_Cj = 1.0 / (fabs(dCj) + Eps);
+		Vec3d n_sum(0.0, 0.0, 0.0);
+		double weight_sum = 0.0;
+		for (int n = 0; n != stencil_size; ++n)
 		{
-			return max_value_;
+			n_sum = n_sum + weight_Cj * nCj;
+			weight_sum = weight_sum + weight_Cj;
 		}
-
+		Vec3d n = n_sum / (weight_sum + Eps);
+		return n.normalize();
+	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	Real ImageMHD<T, nDims>::findValueAtPoint(const Vec3d& input_pnt)
+	{
+		int cell_index = 0;
+		int stencil_size = findStencilCell(input_pnt, cell_index);
+		return stencil_size > 0 ? findValueAtStencil(cell_index, stencil_size) : get_max_value();
 	}
 	//=================================================================================================//
 	template<typename T, int nDims>
 	Vec3d ImageMHD<T, nDims>::findNormalAtPoint(const Vec3d & input_pnt)
 	{
-		Vec3i this_cell;
-		std::vector<int> neighbors = findNeighbors(input_pnt, this_cell);
-		Vec3d n_sum(0.0, 0.0, 0.0);
-		double weight_sum = 0.0;
-		double d_sum = 0.0;
-		if (neighbors.size() > 0)
+		int cell_index = 0;
+		int stencil_size = findStencilCell(input_pnt, cell_index);
+		return stencil_size > 0 ? findNormalAtStencil(cell_index, stencil_size) : Vec3d(1.0, 1.0, 1.0).normalize();
+	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	void ImageMHD<T, nDims>::findValuesAtPoints(const StdVec<Vec3d> &input_pnts, StdVec<Real> &values)
+	{
+		size_t number_of_probes = input_pnts.size();
+		values.resize(number_of_probes);
+		StdVec<int> cell_indexes(number_of_probes, 0);
+		StdVec<int> stencil_sizes(number_of_probes);
+		StdVec<size_t> sequence(number_of_probes);
+		Real max_value = get_max_value();
+		parallel_for(blocked_range<size_t>(0, number_of_probes),
+			[&](const blocked_range<size_t> &r) {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					stencil_sizes[i] = findStencilCell(input_pnts[i], cell_indexes[i]);
+					sequence[i] = i;
+				}
+			});
+		parallel_sort(sequence.begin(), sequence.end(),
+			[&](size_t a, size_t b) { return cell_indexes[a] < cell_indexes[b]; });
+		parallel_for(blocked_range<size_t>(0, number_of_probes),
+			[&](const blocked_range<size_t> &r) {
+				for (size_t n = r.begin(); n != r.end(); ++n)
+				{
+					size_t i = sequence[n];
+					values[i] = stencil_sizes[i] > 0 ? findValueAtStencil(cell_indexes[i], stencil_sizes[i]) : max_value;
+				}
+			});
+	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	void ImageMHD<T, nDims>::findNormalsAtPoints(const StdVec<Vec3d> &input_pnts, StdVec<Vec3d> &normals)
+	{
+		size_t number_of_probes = input_pnts.size();
+		normals.resize(number_of_probes);
+		StdVec<int> cell_indexes(number_of_probes, 0);
+		StdVec<int> stencil_sizes(number_of_probes);
+		StdVec<size_t> sequence(number_of_probes);
+		Vec3d far_normal = Vec3d(1.0, 1.0, 1.0).normalize();
+		parallel_for(blocked_range<size_t>(0, number_of_probes),
+			[&](const blocked_range<size_t> &r) {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					stencil_sizes[i] = findStencilCell(input_pnts[i], cell_indexes[i]);
+					sequence[i] = i;
+				}
+			});
+		parallel_sort(sequence.begin(), sequence.end(),
+			[&](size_t a, size_t b) { return cell_indexes[a] < cell_indexes[b]; });
+		parallel_for(blocked_range<size_t>(0, number_of_probes),
+			[&](const blocked_range<size_t> &r) {
+				for (size_t n = r.begin(); n != r.end(); ++n)
+				{
+					size_t i = sequence[n];
+					normals[i] = stencil_sizes[i] > 0 ? findNormalAtStencil(cell_indexes[i], stencil_sizes[i]) : far_normal;
+				}
+			});
+	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	void ImageMHD<T, nDims>::transformToSignedDistance(int label)
+	{
+		StdVec<Real> squared_distance_to_inside(size_);
+		StdVec<Real> squared_distance_to_outside(size_);
+		Real far_away = 1.0e20;
+		parallel_for(blocked_range<int>(0, size_),
+			[&](const blocked_range<int> &r) {
+				for (int i = r.begin(); i != r.end(); ++i)
+				{
+					bool is_inside = label > 0 ? int(data_[i]) == label : data_[i] > 0;
+					squared_distance_to_inside[i] = is_inside ? 0.0 : far_away;
+					squared_distance_to_outside[i] = is_inside ? far_away : 0.0;
+				}
+			});
+		squaredDistanceTransform(squared_distance_to_inside);
+		squaredDistanceTransform(squared_distance_to_outside);
+
+		//- the memory mapped data is read only
+		if (storage_mode_ == MEMORY_MAPPED)
+		{
+#ifdef IMAGE_MHD_MEMORY_MAPPING
+			munmap(data_, sizeof(T) * size_);
+#endif
+			storage_mode_ = IN_MEMORY;
+			data_ = new T[size_];
+		}
+
+		min_value_ = Infinity;
+		max_value_ = -Infinity;
+		for (int index = 0; index < size_; index++)
+		{
+			Real distance = sqrt(squared_distance_to_inside[index]) - sqrt(squared_distance_to_outside[index]);
+			data_[index] = T(distance);
+			if (distance < min_value_) min_value_ = distance;
+			if (distance > max_value_) max_value_ = distance;
+		}
+		is_value_range_found_ = true;
+	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	void ImageMHD<T, nDims>::squaredDistanceTransform(StdVec<Real> &squared_distance)
+	{
+		int strides[3] = {1, width_, width_ * height_};
+		for (int axis = 0; axis != 3; ++axis)
+		{
+			int n = dimSize_[axis];
+			int stride = strides[axis];
+			Real h2 = elementSpacing_[axis] * elementSpacing_[axis];
+			parallel_for(blocked_range<int>(0, size_ / n),
+				[&](const blocked_range<int> &r) {
+					StdVec<Real> f(n), d(n), z(n + 1);
+					StdVec<int> v(n);
+					for (int line = r.begin(); line != r.end(); ++line)
+					{
+						int base = line;
+						if (axis == 0)
+							base = line * width_;
+						else if (axis == 1)
+							base = (line / width_) * width_ * height_ + line % width_;
+
+						for (int p = 0; p < n; ++p)
+							f[p] = squared_distance[base + p * stride];
+						squaredDistanceTransformLine(f, d, v, z, n, h2);
+						for (int p = 0; p < n; ++p)
+							squared_distance[base + p * stride] = d[p];
+					}
+				});
+		}
+	}
+	//=================================================================================================//
+	template<typename T, int nDims>
+	void ImageMHD<T, nDims>::squaredDistanceTransformLine(StdVec<Real> &f, StdVec<Real> &d,
+		StdVec<int> &v, StdVec<Real> &z, int n, Real h2)
+	{
+		//- lower envelope of the parabolas rooted at the voxels, Felzenszwalb and Huttenlocher (2012)
+		int k = 0;
+		v[0] = 0;
+		z[0] = -Infinity;
+		z[1] = Infinity;
+		for (int q = 1; q < n; ++q)
 		{
-			for (const int& i : neighbors)
+			Real s = ((f[q] + h2 * q * q) - (f[v[k]] + h2 * v[k] * v[k])) / (2.0 * h2 * (q - v[k]));
+			while (s <= z[k])
 			{
-				// checkIndexBound(i);
-				Vec3d nCj = computeNormalAtCell(i);
-				double dCj = float(getValueAtCell(i));
-				double weight_Cj = 1.0 / (fabs(dCj) + Eps);
-				n_sum = n_sum + weight_Cj * nCj;
-				weight_sum = weight_sum + weight_Cj;
-				d_sum = d_sum + dCj;
+				k--;
+				s = ((f[q] + h2 * q * q) - (f[v[k]] + h2 * v[k] * v[k])) / (2.0 * h2 * (q - v[k]));
 			}
-			Vec3d n = n_sum / (weight_sum + Eps);
-			return n.normalize();
+			k++;
+			v[k] = q;
+			z[k] = s;
+			z[k + 1] = Infinity;
 		}
-		else
+
+		k = 0;
+		for (int p = 0; p < n; ++p)
 		{
-			return Vec3d(1.0, 1.0, 1.0).normalize();
+			while (z[k + 1] < p)
+				k++;
+			d[p] = h2 * (p - v[k]) * (p - v[k]) + f[v[k]];
 		}
 	}
-
 	//=================================================================================================//
 	template<typename T, int nDims>
 	void ImageMHD<T, nDims>::write(std::string filename, Output_Mode mode)
@@ -501,7 +810,9 @@ namespace SPH {
 			output_file << "ElementType = MET_UCHAR" << "\n";
 		if (elementType_ == MET_LONG)
 			output_file << "ElementType = MET_LONG" << "\n";
-		output_file << "ElementDataFile = "<< filename+".raw" << "\n";
+		output_file << "ElementMin = " << get_min_value() << "\n";
+		output_file << "ElementMax = " << get_max_value() << "\n";
+		output_file << "ElementDataFile = "<< filename.substr(filename.find_last_of("\\/") + 1) + ".raw" << "\n";
 
 		output_file.close();
 		
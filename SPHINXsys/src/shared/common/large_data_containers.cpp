@@ -0,0 +1,105 @@
+/**
+ * @file 	large_data_containers.cpp
+ * @author	Xiangyu Hu
+ */
+#include "large_data_containers.h"
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+//=============================================================================================//
+namespace SPH
+{
+	//=============================================================================================//
+	/** the huge page blocks in use and their mapped sizes */
+	static std::map<void *, size_t> huge_page_blocks;
+	static std::mutex huge_page_blocks_mutex;
+	//=============================================================================================//
+	void *allocateHugePageBlock(size_t bytes)
+	{
+#ifdef __linux__
+		size_t mapped_bytes = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+		void *data = MAP_FAILED;
+#ifdef MAP_HUGETLB
+		if (hugePageMode() == HugePageMode::Explicit)
+			data = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE,
+						MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+		if (data == MAP_FAILED)
+		{
+			/** map one more huge page and trim to a huge page aligned block */
+			void *mapped = mmap(nullptr, mapped_bytes + huge_page_size, PROT_READ | PROT_WRITE,
+								MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (mapped == MAP_FAILED)
+				return nullptr;
+
+			uintptr_t begin = reinterpret_cast<uintptr_t>(mapped);
+			uintptr_t aligned = (begin + huge_page_size - 1) / huge_page_size * huge_page_size;
+			size_t head_bytes = aligned - begin;
+			if (head_bytes != 0)
+				munmap(mapped, head_bytes);
+			if (head_bytes != huge_page_size)
+				munmap(reinterpret_cast<void *>(aligned + mapped_bytes), huge_page_size - head_bytes);
+			data = reinterpret_cast<void *>(aligned);
+#ifdef MADV_HUGEPAGE
+			madvise(data, mapped_bytes, MADV_HUGEPAGE);
+#endif
+		}
+
+		std::lock_guard<std::mutex> lock(huge_page_blocks_mutex);
+		huge_page_blocks[data] = mapped_bytes;
+		return data;
+#else
+		return nullptr;
+#endif
+	}
+	//=============================================================================================//
+	bool deallocateHugePageBlock(void *data)
+	{
+#ifdef __linux__
+		size_t mapped_bytes = 0;
+		{
+			std::lock_guard<std::mutex> lock(huge_page_blocks_mutex);
+			auto block = huge_page_blocks.find(data);
+			if (block == huge_page_blocks.end())
+				return false;
+			mapped_bytes = block->second;
+			huge_page_blocks.erase(block);
+		}
+		munmap(data, mapped_bytes);
+		return true;
+#else
+		return false;
+#endif
+	}
+	//=============================================================================================//
+	bool isScalableAllocatorHugePageCapable()
+	{
+#ifdef __linux__
+		std::ifstream transparent_huge_page_setting("/sys/kernel/mm/transparent_hugepage/enabled");
+		std::string setting;
+		if (std::getline(transparent_huge_page_setting, setting) &&
+			setting.find("[always]") != std::string::npos)
+			return true;
+
+		std::ifstream memory_info("/proc/meminfo");
+		std::string key;
+		size_t value = 0;
+		while (memory_info >> key >> value)
+		{
+			if (key == "HugePages_Total:")
+				return value != 0;
+			memory_info.ignore(256, '\n');
+		}
+#endif
+		return false;
+	}
+	//=============================================================================================//
+}
+//=============================================================================================//
@@ -33,24 +33,146 @@
 #include "tbb/scalable_allocator.h"
 #include "tbb/concurrent_unordered_set.h"
 #include "tbb/concurrent_vector.h"
+#include "tbb/enumerable_thread_specific.h"
 #include "tbb/cache_aligned_allocator.h"
 
 #include <array>
 
 using namespace tbb;
-static tbb::affinity_partitioner ap;
+/** one partitioner per calling thread, so that several SPH systems can run concurrently */
+static thread_local tbb::affinity_partitioner ap;
 
 namespace SPH {
 
+	/** switch for the parallel first touch of newly registered particle variables, see touchPagesInParallel */
+	inline bool &parallelFirstTouch()
+	{
+		static bool parallel_first_touch = false;
+		return parallel_first_touch;
+	}
+
+	/** huge pages for large vectors: none, transparent (madvise) or explicit (hugetlbfs, falls back to transparent) */
+	enum class HugePageMode
+	{
+		None,
+		Transparent,
+		Explicit
+	};
+	/** the huge page mode of newly allocated large vectors, see LargeVecAllocator */
+	inline HugePageMode &hugePageMode()
+	{
+		static HugePageMode huge_page_mode = HugePageMode::None;
+		return huge_page_mode;
+	}
+	/** size of a huge page, also the smallest allocation backed by huge pages */
+	const size_t huge_page_size = size_t(2) << 20;
+	/** allocate a block backed by huge pages, returns nullptr if not available */
+	void *allocateHugePageBlock(size_t bytes);
+	/** release a block allocated with huge pages, returns false if the block is not one of them */
+	bool deallocateHugePageBlock(void *data);
+	/** whether the TBB scalable allocator, which allocates the small vectors, can get huge pages,
+	 *  i.e. transparent huge pages are always on or explicit huge pages are reserved */
+	bool isScalableAllocatorHugePageCapable();
+
+	/**
+	 * @class LargeVecAllocator
+	 * @brief Cache aligned allocator for large particle data vectors.
+	 * With a huge page mode, allocations of at least one huge page are backed by huge pages,
+	 * which reduces the TLB misses of the random accesses to neighbor particle data.
+	 */
+	template <typename T>
+	class LargeVecAllocator : public cache_aligned_allocator<T>
+	{
+	public:
+		template <typename U>
+		struct rebind
+		{
+			typedef LargeVecAllocator<U> other;
+		};
+
+		LargeVecAllocator() : cache_aligned_allocator<T>(){};
+		LargeVecAllocator(const LargeVecAllocator &) : cache_aligned_allocator<T>(){};
+		template <typename U>
+		LargeVecAllocator(const LargeVecAllocator<U> &) : cache_aligned_allocator<T>(){};
+
+		T *allocate(std::size_t n)
+		{
+			T *data = nullptr;
+			if (hugePageMode() != HugePageMode::None && n * sizeof(T) >= huge_page_size)
+				data = static_cast<T *>(allocateHugePageBlock(n * sizeof(T)));
+			if (data == nullptr)
+				data = cache_aligned_allocator<T>::allocate(n);
+			return data;
+		};
+
+		void deallocate(T *data, std::size_t n)
+		{
+			if (n * sizeof(T) < huge_page_size || !deallocateHugePageBlock(data))
+				cache_aligned_allocator<T>::deallocate(data, n);
+		};
+	};
+
+	template <typename T, typename U>
+	bool operator==(const LargeVecAllocator<T> &, const LargeVecAllocator<U> &) { return true; }
+	template <typename T, typename U>
+	bool operator!=(const LargeVecAllocator<T> &, const LargeVecAllocator<U> &) { return false; }
+
 	template <typename T>
 	using LargeVec = tbb::concurrent_vector<T>;
 
 	template <typename T>
-	using StdLargeVec = std::vector<T, cache_aligned_allocator<T>>;
+	using StdLargeVec = std::vector<T, LargeVecAllocator<T>>;
 
 	template <typename T>
 	using StdVec = std::vector<T>;
 
+	/**
+	 * Allocate the storage of an empty large vector for the given number of elements
+	 * and touch its pages in parallel over the element range with the static partitioner,
+	 * before the vector is resized and its elements are initialized serially.
+	 * Since a page is placed on the memory node of the thread which touches it first,
+	 * on NUMA systems the data of a particle range is on the node of the thread
+	 * which iterates that range with the static partitioner.
+	 * A page shared by two ranges goes to the node of one of them.
+	 */
+	template <typename T>
+	void touchPagesInParallel(StdLargeVec<T> &variable, size_t size)
+	{
+		if (!variable.empty() || size == 0)
+			return;
+
+		const size_t page_size = 4096;
+		variable.reserve(size);
+		volatile char *bytes = reinterpret_cast<volatile char *>(variable.data());
+		parallel_for(
+			blocked_range<size_t>(0, size),
+			[&](const blocked_range<size_t> &r)
+			{
+				size_t begin = r.begin() * sizeof(T);
+				size_t end = r.end() * sizeof(T);
+				bytes[begin] = 0;
+				for (size_t byte = (begin / page_size + 1) * page_size; byte < end; byte += page_size)
+					bytes[byte] = 0;
+			},
+			tbb::static_partitioner());
+	}
+
+	/**
+	 * Move the data of a large vector, which has been filled serially before its final size is known,
+	 * to storage whose pages are touched in parallel, see touchPagesInParallel.
+	 */
+	template <typename T>
+	void placePagesInParallel(StdLargeVec<T> &variable)
+	{
+		if (variable.empty())
+			return;
+
+		StdLargeVec<T> placed_variable;
+		touchPagesInParallel(placed_variable, variable.size());
+		placed_variable.insert(placed_variable.end(), variable.begin(), variable.end());
+		variable.swap(placed_variable);
+	}
+
 	template <typename T>
 	using DoubleVec = std::vector<std::vector<T>>;
 
@@ -0,0 +1,202 @@
+/**
+ * @file 	numa_placement.cpp
+ * @author	Xiangyu Hu
+ */
+#include "numa_placement.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+//=============================================================================================//
+namespace SPH
+{
+	namespace
+	{
+		/** the number of pinning observers using each core */
+		std::mutex core_claims_mutex;
+		StdVec<size_t> core_claims;
+#ifdef __linux__
+		/** the affinities of a thread before entering the arenas it is in */
+		thread_local StdVec<cpu_set_t> saved_affinities;
+#endif
+		/** parse a list in the format of /sys, e.g. 0-3,8,10-11 */
+		IndexVector readIndexList(const std::string &file_name)
+		{
+			IndexVector indexes;
+			std::ifstream list_file(file_name);
+			std::string entry;
+			while (std::getline(list_file, entry, ','))
+			{
+				if (entry.find_first_of("0123456789") == std::string::npos)
+					continue;
+				size_t dash = entry.find('-');
+				size_t first = std::stoul(entry.substr(0, dash));
+				size_t last = dash == std::string::npos ? first : std::stoul(entry.substr(dash + 1));
+				for (size_t index = first; index <= last; ++index)
+					indexes.push_back(index);
+			}
+			return indexes;
+		}
+	}
+	//=============================================================================================//
+	IndexVector allowedCoresByMemoryNode()
+	{
+		IndexVector cores;
+#ifdef __linux__
+		cpu_set_t allowed_set;
+		CPU_ZERO(&allowed_set);
+		if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed_set) != 0)
+			return cores;
+
+		/** sort key: memory node, then whether the core is a secondary hardware thread, then the core index */
+		StdVec<std::array<size_t, 3>> keys;
+		IndexVector nodes = readIndexList("/sys/devices/system/node/online");
+		for (int core = 0; core != CPU_SETSIZE; ++core)
+		{
+			if (!CPU_ISSET(core, &allowed_set))
+				continue;
+
+			std::string core_path = "/sys/devices/system/cpu/cpu" + std::to_string(core);
+			size_t node = 0;
+			for (size_t k = 0; k != nodes.size(); ++k)
+				if (access((core_path + "/node" + std::to_string(nodes[k])).c_str(), F_OK) == 0)
+					node = nodes[k];
+			IndexVector siblings = readIndexList(core_path + "/topology/thread_siblings_list");
+			size_t is_secondary = !siblings.empty() && siblings[0] != size_t(core) ? 1 : 0;
+			keys.push_back({node, is_secondary, size_t(core)});
+		}
+		std::sort(keys.begin(), keys.end());
+		for (size_t k = 0; k != keys.size(); ++k)
+			cores.push_back(keys[k][2]);
+#endif
+		return cores;
+	}
+	//=============================================================================================//
+	ThreadPinningObserver::ThreadPinningObserver(tbb::task_arena &task_arena)
+		: tbb::task_scheduler_observer(task_arena)
+	{
+		IndexVector allowed_cores = allowedCoresByMemoryNode();
+		if (!allowed_cores.empty())
+		{
+			std::lock_guard<std::mutex> lock(core_claims_mutex);
+			size_t max_core = *std::max_element(allowed_cores.begin(), allowed_cores.end());
+			if (core_claims.size() <= max_core)
+				core_claims.resize(max_core + 1, 0);
+
+			/** the least claimed cores, taken in the order of memory nodes */
+			IndexVector positions(allowed_cores.size());
+			for (size_t k = 0; k != positions.size(); ++k)
+				positions[k] = k;
+			std::stable_sort(positions.begin(), positions.end(),
+							 [&](size_t a, size_t b)
+							 { return core_claims[allowed_cores[a]] < core_claims[allowed_cores[b]]; });
+			size_t number_of_slots = SMIN(size_t(task_arena.max_concurrency()), positions.size());
+			positions.resize(number_of_slots);
+			std::sort(positions.begin(), positions.end());
+			for (size_t k = 0; k != number_of_slots; ++k)
+			{
+				cores_.push_back(allowed_cores[positions[k]]);
+				core_claims[cores_.back()]++;
+			}
+		}
+		observe(true);
+	}
+	//=============================================================================================//
+	ThreadPinningObserver::~ThreadPinningObserver()
+	{
+		observe(false);
+		std::lock_guard<std::mutex> lock(core_claims_mutex);
+		for (size_t k = 0; k != cores_.size(); ++k)
+			core_claims[cores_[k]]--;
+	}
+	//=============================================================================================//
+	void ThreadPinningObserver::on_scheduler_entry(bool is_worker)
+	{
+#ifdef __linux__
+		cpu_set_t previous_set;
+		CPU_ZERO(&previous_set);
+		sched_getaffinity(0, sizeof(cpu_set_t), &previous_set);
+		saved_affinities.push_back(previous_set);
+
+		int thread_index = tbb::this_task_arena::current_thread_index();
+		if (thread_index < 0 || cores_.empty())
+			return;
+
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		CPU_SET(cores_[size_t(thread_index) % cores_.size()], &cpu_set);
+		sched_setaffinity(0, sizeof(cpu_set_t), &cpu_set);
+#endif
+	}
+	//=============================================================================================//
+	void ThreadPinningObserver::on_scheduler_exit(bool is_worker)
+	{
+#ifdef __linux__
+		if (saved_affinities.empty())
+			return;
+
+		sched_setaffinity(0, sizeof(cpu_set_t), &saved_affinities.back());
+		saved_affinities.pop_back();
+#endif
+	}
+	//=============================================================================================//
+	Real localPageFraction(const void *data, size_t bytes)
+	{
+#if defined(__linux__) && defined(SYS_move_pages) && defined(SYS_getcpu)
+		if (data == nullptr || bytes == 0)
+			return -1.0;
+
+		const uintptr_t page_size = uintptr_t(sysconf(_SC_PAGESIZE));
+		const uintptr_t first_page = reinterpret_cast<uintptr_t>(data) / page_size * page_size;
+		const size_t number_of_pages = (reinterpret_cast<uintptr_t>(data) + bytes - first_page + page_size - 1) / page_size;
+
+		std::atomic<size_t> local_pages(0), located_pages(0);
+		parallel_for(
+			blocked_range<size_t>(0, number_of_pages),
+			[&](const blocked_range<size_t> &r)
+			{
+				unsigned cpu = 0, node = 0;
+				if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+					return;
+
+				StdVec<void *> pages;
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					pages.push_back(reinterpret_cast<void *>(first_page + i * page_size));
+				StdVec<int> status(pages.size(), -1);
+				/** without target nodes, the nodes of the pages are returned in the status */
+				if (syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0)
+					return;
+
+				size_t local = 0, located = 0;
+				for (size_t i = 0; i != status.size(); ++i)
+				{
+					if (status[i] >= 0)
+					{
+						++located;
+						if (status[i] == int(node))
+							++local;
+					}
+				}
+				local_pages += local;
+				located_pages += located;
+			},
+			tbb::static_partitioner());
+
+		return located_pages == 0 ? -1.0 : Real(local_pages) / Real(located_pages);
+#else
+		return -1.0;
+#endif
+	}
+	//=============================================================================================//
+}
+//=============================================================================================//
@@ -0,0 +1,82 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+* @file 	numa_placement.h
+* @brief 	Thread pinning and the check of the memory placement of
+*			particle data for NUMA-aware execution.
+* @details	Together with the parallel first touch of large vectors, see LargeVecAllocator,
+*			and the static partitioner in the execution policy of particle dynamics,
+*			each thread iterates the particles whose data is on its own memory node.
+* @author	Xiangyu Hu
+*/
+
+#ifndef NUMA_PLACEMENT_H
+#define NUMA_PLACEMENT_H
+
+#include "base_data_package.h"
+#include "sph_data_containers.h"
+
+#include "tbb/task_arena.h"
+#include "tbb/task_scheduler_observer.h"
+
+namespace SPH
+{
+	/**
+	 * @class ThreadPinningObserver
+	 * @brief Pins each thread entering a task arena to a core by its thread slot in the arena,
+	 * so that the thread of a slot, and hence the particle range assigned to it by the static partitioner,
+	 * stays on the same memory node. The cores are those allowed for the process (cpuset),
+	 * ordered by memory node and with one hardware thread per core first, as given in /sys.
+	 * Each observer claims the least used cores, so that concurrent arenas do not collide
+	 * as long as there are enough cores. The affinity of a thread is restored when it leaves the arena.
+	 * Only effective on Linux.
+	 */
+	class ThreadPinningObserver : public tbb::task_scheduler_observer
+	{
+	public:
+		explicit ThreadPinningObserver(tbb::task_arena &task_arena);
+		virtual ~ThreadPinningObserver();
+
+		virtual void on_scheduler_entry(bool is_worker) override;
+		virtual void on_scheduler_exit(bool is_worker) override;
+		/** the cores of the thread slots */
+		const IndexVector &PinnedCores() { return cores_; };
+
+	protected:
+		IndexVector cores_;
+	};
+
+	/** the cores allowed for the process, ordered by memory node and with one hardware thread per core first */
+	IndexVector allowedCoresByMemoryNode();
+
+	/** Fraction of the pages of a data range which are located on the memory node of
+	 *  the thread iterating them with the static partitioner. Negative if not available. */
+	Real localPageFraction(const void *data, size_t bytes);
+
+	template <typename T>
+	Real localPageFraction(const StdLargeVec<T> &variable)
+	{
+		return localPageFraction(variable.data(), variable.size() * sizeof(T));
+	}
+}
+#endif //NUMA_PLACEMENT_H
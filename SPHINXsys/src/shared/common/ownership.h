@@ -172,6 +172,8 @@ namespace SPH
 			ptr_member_ = shared_ptr;
 			return ptr_member_.get();
 		};
+		/** output the shared ownership, e.g. for sharing the object with others */
+		SharedPtr<BaseType> getSharedPtr() { return ptr_member_; };
 
 	private:
 		SharedPtr<BaseType> ptr_member_;
@@ -51,6 +51,8 @@ namespace SPH
 	using IndexVector = StdVec<size_t>;
 	/** Concurrent particle indexes .*/
 	using ConcurrentIndexVector = LargeVec<size_t>;
+	/** Particle indexes collected separately by each thread. */
+	using ThreadLocalIndexVectors = tbb::enumerable_thread_specific<IndexVector>;
 
 	/** List data pair */
 	using ListData = std::pair<size_t, Vecd>;
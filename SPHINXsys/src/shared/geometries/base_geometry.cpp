@@ -39,6 +39,20 @@ namespace SPH
 		return is_contain ? direction_to_surface : -1.0 * direction_to_surface;
 	}
 	//=================================================================================================//
+	void Shape::findSignedDistances(const StdVec<Vecd> &input_pnts, StdVec<Real> &signed_distances)
+	{
+		signed_distances.resize(input_pnts.size());
+		for (size_t i = 0; i != input_pnts.size(); ++i)
+			signed_distances[i] = findSignedDistance(input_pnts[i]);
+	}
+	//=================================================================================================//
+	void Shape::findNormalDirections(const StdVec<Vecd> &input_pnts, StdVec<Vecd> &normal_directions)
+	{
+		normal_directions.resize(input_pnts.size());
+		for (size_t i = 0; i != input_pnts.size(); ++i)
+			normal_directions[i] = findNormalDirection(input_pnts[i]);
+	}
+	//=================================================================================================//
 	BoundingBox BinaryShapes::findBounds()
 	{
 		//initial reference values
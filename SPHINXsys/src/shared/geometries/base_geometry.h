@@ -77,6 +77,11 @@ namespace SPH
 		virtual Real findSignedDistance(const Vecd &input_pnt);
 		/** Normal direction point toward outside of the complex shape. */
 		virtual Vecd findNormalDirection(const Vecd &input_pnt);
+		/** Batched versions of the above two for a large number of points, e.g. during level set generation. */
+		virtual void findSignedDistances(const StdVec<Vecd> &input_pnts, StdVec<Real> &signed_distances);
+		virtual void findNormalDirections(const StdVec<Vecd> &input_pnts, StdVec<Vecd> &normal_directions);
+		/** whether the batched versions are faster than probing point by point, e.g. for a large image */
+		virtual bool isProbedInBatches() { return false; };
 
 	protected:
 		std::string name_;
@@ -71,8 +71,12 @@ namespace SPH
 	//=================================================================================================//
 	void LevelSet::initializeDataPackages()
 	{
+		if (shape_.isProbedInBatches())
+			probeShapeAtCells();
 		MeshFunctor initialize_data_in_a_cell = std::bind(&LevelSet::initializeDataInACell, this, _1, _2);
 		MeshIterator_parallel(Vecu(0), number_of_cells_, initialize_data_in_a_cell);
+		StdVec<Real>().swap(cell_signed_distances_);
+		StdVec<Vecd>().swap(cell_normal_directions_);
 		MeshFunctor tag_a_cell_inner_pkg = std::bind(&LevelSet::tagACellIsInnerPackage, this, _1, _2);
 		MeshIterator_parallel(Vecu(0), number_of_cells_, tag_a_cell_inner_pkg);
 		MeshFunctor initial_address_in_a_cell = std::bind(&LevelSet::initializeAddressesInACell, this, _1, _2);
@@ -81,6 +85,38 @@ namespace SPH
 		updateKernelIntegrals();
 	}
 	//=================================================================================================//
+	void LevelSet::probeShapeAtCells()
+	{
+		size_t total_number_of_cells = 1;
+		for (int n = 0; n != number_of_cells_.size(); ++n)
+			total_number_of_cells *= number_of_cells_[n];
+
+		StdVec<Vecd> cell_positions(total_number_of_cells);
+		parallel_for(blocked_range<size_t>(0, total_number_of_cells),
+			[&](const blocked_range<size_t> &r) {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					cell_positions[i] = CellPositionFromIndex(transfer1DtoMeshIndex(number_of_cells_, i));
+				}
+			});
+		shape_.findSignedDistances(cell_positions, cell_signed_distances_);
+		shape_.findNormalDirections(cell_positions, cell_normal_directions_);
+	}
+	//=================================================================================================//
+	void LevelSet::probeShapeAtACell(const Vecu &cell_index, Real &signed_distance, Vecd &normal_direction)
+	{
+		if (cell_signed_distances_.empty())
+		{
+			Vecd cell_position = CellPositionFromIndex(cell_index);
+			signed_distance = shape_.findSignedDistance(cell_position);
+			normal_direction = shape_.findNormalDirection(cell_position);
+			return;
+		}
+		size_t cell_1d_index = transferMeshIndexTo1D(number_of_cells_, cell_index);
+		signed_distance = cell_signed_distances_[cell_1d_index];
+		normal_direction = cell_normal_directions_[cell_1d_index];
+	}
+	//=================================================================================================//
 	void LevelSet::initializeAddressesInACell(const Vecu &cell_index, Real dt)
 	{
 		initializePackageAddressesInACell(cell_index);
@@ -151,6 +151,13 @@ namespace SPH
 		virtual void initializeAddressesInACell(const Vecu &cell_index, Real dt) override;
 		virtual void tagACellIsInnerPackage(const Vecu &cell_index, Real dt) override;
 		virtual void initializeDataPackages() override;
+
+		/** for a shape probed in batches, the shape is probed at all cell centers 
+		 * before the data packages are initialized, otherwise cell by cell */
+		StdVec<Real> cell_signed_distances_;
+		StdVec<Vecd> cell_normal_directions_;
+		void probeShapeAtCells();
+		void probeShapeAtACell(const Vecu &cell_index, Real &signed_distance, Vecd &normal_direction);
 	};
 
 	/**
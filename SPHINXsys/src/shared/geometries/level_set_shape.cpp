@@ -18,7 +18,7 @@ namespace SPH
 	{
 		name_ = sph_body->getBodyName();
 		bounding_box_ = shape.findBounds();
-		level_set_ = level_set_keeper_.movePtr(sph_body->sph_adaptation_->createLevelSet(shape));
+		level_set_ = level_set_keeper_.assignPtr(SharedPtr<BaseLevelSet>(sph_body->sph_adaptation_->createLevelSet(shape)));
 		if (isCleaned)
 			level_set_->cleanInterface();
 
@@ -30,6 +30,14 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	LevelSetShape::LevelSetShape(SPHBody *sph_body, LevelSetShape &shared_shape)
+		: Shape(sph_body->getBodyName()), level_set_(nullptr)
+	{
+		name_ = sph_body->getBodyName();
+		bounding_box_ = shared_shape.findBounds();
+		level_set_ = level_set_keeper_.assignPtr(shared_shape.getSharedLevelSet());
+	}
+	//=================================================================================================//
 	bool LevelSetShape::checkContain(const Vecd &input_pnt, bool BOUNDARY_INCLUDED)
 	{
 		return level_set_->probeSignedDistance(input_pnt) < 0.0 ? true : false;
@@ -24,12 +24,17 @@ namespace SPH
 	class LevelSetShape : public Shape
 	{
 	private:
-		UniquePtrKeeper<BaseLevelSet> level_set_keeper_;
+		SharedPtrKeeper<BaseLevelSet> level_set_keeper_;
 
 	public:
 		LevelSetShape(SPHBody *sph_body, Shape &shape, bool isCleaned = false, bool write_level_set = true);
+		/** Share the level set of another shape, e.g. of the same body in another SPH system.
+		 *  The level set is only read after its generation, and the body should use the same adaptation. */
+		LevelSetShape(SPHBody *sph_body, LevelSetShape &shared_shape);
 		virtual ~LevelSetShape(){};
 
+		SharedPtr<BaseLevelSet> getSharedLevelSet() { return level_set_keeper_.getSharedPtr(); };
+
 		virtual BoundingBox findBounds() override { return bounding_box_; };
 		virtual Vecd findClosestPoint(const Vecd &input_pnt) override;
 		virtual bool checkContain(const Vecd &input_pnt, bool BOUNDARY_INCLUDED = true) override;
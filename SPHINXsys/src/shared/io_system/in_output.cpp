@@ -46,34 +46,81 @@ namespace SPH
 	}
 	//=============================================================================================//
 	void PltEngine::
-		writeAQuantityHeader(std::ofstream &out_file, const Real &quantity, const std::string &quantity_name)
+		writeAQuantityHeader(std::ostream &out_file, const Real &quantity, const std::string &quantity_name)
 	{
 		out_file << "\"" << quantity_name << "\""
 				 << "   ";
 	}
 	//=============================================================================================//
 	void PltEngine::
-		writeAQuantityHeader(std::ofstream &out_file, const Vecd &quantity, const std::string &quantity_name)
+		writeAQuantityHeader(std::ostream &out_file, const Vecd &quantity, const std::string &quantity_name)
 	{
 		for (int i = 0; i != Dimensions; ++i)
 			out_file << "\"" << quantity_name << "[" << i << "]\""
 					 << "   ";
 	}
 	//=============================================================================================//
-	void PltEngine::writeAQuantity(std::ofstream &out_file, const Real &quantity)
+	void PltEngine::writeAQuantity(std::ostream &out_file, const Real &quantity)
 	{
 		out_file << std::fixed << std::setprecision(9) << quantity << "   ";
 	}
 	//=============================================================================================//
-	void PltEngine::writeAQuantity(std::ofstream &out_file, const Vecd &quantity)
+	void PltEngine::writeAQuantity(std::ostream &out_file, const Vecd &quantity)
 	{
 		for (int i = 0; i < Dimensions; ++i)
 			out_file << std::fixed << std::setprecision(9) << quantity[i] << "   ";
 	}
 	//=============================================================================================//
+	void BufferedRecordingFile::openFile(const std::string &filefullpath, std::ios::openmode mode)
+	{
+		flush();
+		if (out_file_.is_open())
+			out_file_.close();
+		out_file_.open(filefullpath.c_str(), std::ios::out | mode);
+		if (!out_file_.is_open())
+		{
+			std::cout << "\n Error: the recording file " << filefullpath << " can not be opened!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+	}
+	//=============================================================================================//
+	void BufferedRecordingFile::endRow()
+	{
+		buffered_rows_++;
+		if (buffered_rows_ >= rows_per_flush_)
+			flush();
+	}
+	//=============================================================================================//
+	void BufferedRecordingFile::flush()
+	{
+		if (out_file_.is_open())
+		{
+			std::string buffered = buffer_.str();
+			out_file_.write(buffered.data(), buffered.size());
+			out_file_.flush();
+		}
+		buffer_.str(std::string());
+		buffer_.clear();
+		buffered_rows_ = 0;
+	}
+	//=============================================================================================//
+	void BinarySnapshotIO::writeHeader(BufferedRecordingFile &binary_file, size_t number_of_columns, size_t column_size)
+	{
+		uint64_t header[2] = {uint64_t(number_of_columns), uint64_t(column_size)};
+		binary_file.row().write((const char *)header, sizeof(header));
+		binary_file.flush();
+	}
+	//=============================================================================================//
+	void BinarySnapshotIO::writeSnapshotTag(BufferedRecordingFile &binary_file, size_t iteration)
+	{
+		uint64_t tag = iteration;
+		binary_file.row().write((const char *)&tag, sizeof(uint64_t));
+	}
+	//=============================================================================================//
 	std::string BodyStatesIO::convertPhysicalTimeToString(Real convertPhysicalTimeToStream)
 	{
-		int i_time = int(GlobalStaticVariables::physical_time_ * 1.0e6);
+		int i_time = int(convertPhysicalTimeToStream * 1.0e6);
 		std::stringstream s_time;
 		s_time << std::setw(10) << std::setfill('0') << i_time;
 		return s_time.str();
@@ -380,7 +427,7 @@ namespace SPH
 			fs::remove(overall_filefullpath);
 		}
 		std::ofstream out_file(overall_filefullpath.c_str(), std::ios::app);
-		out_file << std::fixed << std::setprecision(9) << GlobalStaticVariables::physical_time_ << "   \n";
+		out_file << std::fixed << std::setprecision(9) << in_output_.sph_system_.PhysicalTime() << "   \n";
 		out_file.close();
 
 		for (size_t i = 0; i < bodies_.size(); ++i)
@@ -453,7 +500,7 @@ namespace SPH
 	void WriteSimBodyPinData::writeToFile(size_t iteration_step)
 	{
 		std::ofstream out_file(filefullpath_.c_str(), std::ios::app);
-		out_file << GlobalStaticVariables::physical_time_ << "   ";
+		out_file << in_output_.sph_system_.PhysicalTime() << "   ";
 		const SimTK::State &state = integ_.getState();
 
 		out_file << "  " << mobody_.getAngle(state) << "  " << mobody_.getRate(state) << "  ";
@@ -88,10 +88,10 @@ namespace SPH
 		PltEngine(){};
 		virtual ~PltEngine(){};
 
-		void writeAQuantityHeader(std::ofstream &out_file, const Real &quantity, const std::string &quantity_name);
-		void writeAQuantityHeader(std::ofstream &out_file, const Vecd &quantity, const std::string &quantity_name);
-		void writeAQuantity(std::ofstream &out_file, const Real &quantity);
-		void writeAQuantity(std::ofstream &out_file, const Vecd &quantity);
+		void writeAQuantityHeader(std::ostream &out_file, const Real &quantity, const std::string &quantity_name);
+		void writeAQuantityHeader(std::ostream &out_file, const Vecd &quantity, const std::string &quantity_name);
+		void writeAQuantity(std::ostream &out_file, const Real &quantity);
+		void writeAQuantity(std::ostream &out_file, const Vecd &quantity);
 	};
 
 	/**
@@ -169,6 +169,83 @@ namespace SPH
 		};
 	};
 
+	/**
+	 * @class BufferedRecordingFile
+	 * @brief Keeps a recording file open and buffers its rows in memory.
+	 * The buffered rows are written to the file when the given number of rows is reached,
+	 * when flushed explicitly and when the recording is destroyed.
+	 */
+	class BufferedRecordingFile
+	{
+	public:
+		explicit BufferedRecordingFile(size_t rows_per_flush = 100)
+			: rows_per_flush_(rows_per_flush), buffered_rows_(0){};
+		virtual ~BufferedRecordingFile() { flush(); };
+
+		void openFile(const std::string &filefullpath, std::ios::openmode mode = std::ios::app);
+		bool isOpen() { return out_file_.is_open(); };
+		/** the stream in which the current row is composed. */
+		std::ostream &row() { return buffer_; };
+		void endRow();
+		void flush();
+		void setRowsPerFlush(size_t rows_per_flush) { rows_per_flush_ = SMAX(rows_per_flush, size_t(1)); };
+
+	protected:
+		std::ofstream out_file_;
+		std::stringstream buffer_;
+		size_t rows_per_flush_;
+		size_t buffered_rows_;
+	};
+
+	/**
+	 * @class BinarySnapshotIO
+	 * @brief Compact binary alternative to the xml memory for the snapshots of observed quantities.
+	 * The file starts with the number of columns and the byte size of a column entry,
+	 * followed by the snapshots, each given by its iteration and the raw column values.
+	 */
+	class BinarySnapshotIO
+	{
+	public:
+		BinarySnapshotIO(){};
+		virtual ~BinarySnapshotIO(){};
+
+		void writeHeader(BufferedRecordingFile &binary_file, size_t number_of_columns, size_t column_size);
+		void writeSnapshotTag(BufferedRecordingFile &binary_file, size_t iteration);
+
+		template <typename T>
+		void writeColumn(BufferedRecordingFile &binary_file, const T &quantity)
+		{
+			binary_file.row().write((const char *)&quantity, sizeof(T));
+		};
+
+		template <typename T>
+		void readSnapshots(const std::string &filefullpath, DoubleVec<T> &quantity, StdVec<string> &element_tag)
+		{
+			std::ifstream in_file(filefullpath.c_str(), std::ios::in | std::ios::binary);
+			uint64_t number_of_columns = 0;
+			uint64_t column_size = 0;
+			in_file.read((char *)&number_of_columns, sizeof(uint64_t));
+			in_file.read((char *)&column_size, sizeof(uint64_t));
+			if (!in_file || column_size != sizeof(T))
+			{
+				std::cout << "\n Error: the binary snapshot file " << filefullpath << " is missing or not compatible!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+
+			quantity.clear();
+			element_tag.clear();
+			uint64_t iteration = 0;
+			StdVec<T> snapshot(number_of_columns);
+			while (in_file.read((char *)&iteration, sizeof(uint64_t)) &&
+				   in_file.read((char *)snapshot.data(), sizeof(T) * number_of_columns))
+			{
+				quantity.push_back(snapshot);
+				element_tag.push_back("Snapshot_" + std::to_string(iteration));
+			}
+		};
+	};
+
 	/**
 	 * @class BodyStatesIO
 	 * @brief base class for write and read body states.
@@ -206,7 +283,7 @@ namespace SPH
 		/** write with filename indicated by physical time */
 		void writeToFile()
 		{
-			writeWithFileName(convertPhysicalTimeToString(GlobalStaticVariables::physical_time_));
+			writeWithFileName(convertPhysicalTimeToString(in_output_.sph_system_.PhysicalTime()));
 		};
 
 		/** write with filename indicated by iteration step */
@@ -397,6 +474,10 @@ namespace SPH
 		XmlEngine observe_xml_engine_;
 		std::string filefullpath_input_;
 		std::string filefullpath_output_;
+		BufferedRecordingFile dat_file_;
+		BinarySnapshotIO binary_snapshot_io_;
+		BufferedRecordingFile binary_file_;
+		bool binary_snapshots_;
 
 		DoubleVec<VariableType> current_result_; /* the container of the current result. */
 		StdVec<string> element_tag_;			 /* the container of the current tag. */
@@ -408,11 +489,13 @@ namespace SPH
 			  observer_dynamics::ObservingAQuantity<DataTypeIndex, VariableType>(contact_relation, quantity_name),
 			  observer_(contact_relation.sph_body_), plt_engine_(), xmlmemory_io_(),
 			  base_particles_(observer_->base_particles_), body_name_(contact_relation.sph_body_->getBodyName()),
-			  quantity_name_(quantity_name), observe_xml_engine_("xml_observe", quantity_name_)
+			  quantity_name_(quantity_name), observe_xml_engine_("xml_observe", quantity_name_),
+			  binary_snapshots_(false)
 		{
 			/** Output for .dat file. */
 			filefullpath_output_ = in_output_.output_folder_ + "/" + body_name_ + "_" + quantity_name + "_" + in_output_.restart_step_ + ".dat";
-			std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
+			dat_file_.openFile(filefullpath_output_);
+			std::ostream &out_file = dat_file_.row();
 			out_file << "run_time"
 					 << "   ";
 			for (size_t i = 0; i != base_particles_->total_real_particles_; ++i)
@@ -421,7 +504,7 @@ namespace SPH
 				plt_engine_.writeAQuantityHeader(out_file, (*this->interpolated_quantities_)[i], quantity_name_i);
 			}
 			out_file << "\n";
-			out_file.close();
+			dat_file_.flush();
 
 			/** Output for .xml file. */
 			filefullpath_input_ = in_output_.input_folder_ + "/" + body_name_ + "_" + quantity_name + "_" + in_output_.restart_step_ + ".xml";
@@ -430,24 +513,58 @@ namespace SPH
 
 		VariableType type_indicator_; /*< this is an indicator to identify the variable type. */
 
-		void writeXmlToXmlFile() { observe_xml_engine_.writeToXmlFile(filefullpath_input_); }
+		/** Write the rows of the .dat file every given number of observations. */
+		void setRowsPerFlush(size_t rows_per_flush) { dat_file_.setRowsPerFlush(rows_per_flush); };
+
+		/** Record the snapshots into a compact binary file instead of the xml memory. */
+		void useBinarySnapshots(size_t rows_per_flush = 100)
+		{
+			binary_snapshots_ = true;
+			binary_file_.setRowsPerFlush(rows_per_flush);
+			binary_file_.openFile(binarySnapshotFilePath(), std::ios::binary | std::ios::trunc);
+			binary_snapshot_io_.writeHeader(binary_file_, base_particles_->total_real_particles_, sizeof(VariableType));
+		};
+
+		std::string binarySnapshotFilePath()
+		{
+			return filefullpath_input_.substr(0, filefullpath_input_.find_last_of('.')) + ".bin";
+		};
+
+		void writeXmlToXmlFile()
+		{
+			dat_file_.flush();
+			if (binary_snapshots_)
+				binary_file_.flush();
+			else
+				observe_xml_engine_.writeToXmlFile(filefullpath_input_);
+		};
 
 		virtual void writeWithFileName(const std::string &sequence) override
 		{
 			this->parallel_exec();
-			std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-			out_file << GlobalStaticVariables::physical_time_ << "   ";
+			std::ostream &out_file = dat_file_.row();
+			out_file << in_output_.sph_system_.PhysicalTime() << "   ";
 			for (size_t i = 0; i != base_particles_->total_real_particles_; ++i)
 			{
 				plt_engine_.writeAQuantity(out_file, (*this->interpolated_quantities_)[i]);
 			}
 			out_file << "\n";
-			out_file.close();
+			dat_file_.endRow();
 		};
 
 		void writeToXml(size_t iteration = 0)
 		{
 			this->parallel_exec();
+			if (binary_snapshots_)
+			{
+				binary_snapshot_io_.writeSnapshotTag(binary_file_, iteration);
+				for (size_t i = 0; i != base_particles_->total_real_particles_; ++i)
+				{
+					binary_snapshot_io_.writeColumn(binary_file_, (*this->interpolated_quantities_)[i]);
+				}
+				binary_file_.endRow();
+				return;
+			}
 			std::string element_name_ = "Snapshot_" + std::to_string(iteration);
 			SimTK::Xml::Element &element_ = observe_xml_engine_.root_element_;
 			observe_xml_engine_.addElementToXmlDoc(element_name_);
@@ -460,6 +577,12 @@ namespace SPH
 
 		void readFromXml()
 		{
+			if (binary_snapshots_)
+			{
+				binary_file_.flush();
+				binary_snapshot_io_.readSnapshots(binarySnapshotFilePath(), current_result_, element_tag_);
+				return;
+			}
 			observe_xml_engine_.loadXmlFile(filefullpath_input_);
 			size_t number_of_particle_ = base_particles_->total_real_particles_;
 			size_t number_of_snapshot_ = std::distance(observe_xml_engine_.root_element_.element_begin(),
@@ -494,6 +617,10 @@ namespace SPH
 		XmlEngine observe_xml_engine_;
 		std::string filefullpath_input_;
 		std::string filefullpath_output_;
+		BufferedRecordingFile dat_file_;
+		BinarySnapshotIO binary_snapshot_io_;
+		BufferedRecordingFile binary_file_;
+		bool binary_snapshots_;
 
 		/*< deduce variable type from reduce method. */
 		using VariableType = decltype(reduce_method_.InitialReference());
@@ -506,16 +633,17 @@ namespace SPH
 			: in_output_(in_output), plt_engine_(), reduce_method_(std::forward<ConstructorArgs>(args)...),
 			  body_name_(reduce_method_.getSPHBody()->getBodyName()),
 			  quantity_name_(reduce_method_.QuantityName()),
-			  observe_xml_engine_("xml_reduce", quantity_name_)
+			  observe_xml_engine_("xml_reduce", quantity_name_), binary_snapshots_(false)
 		{
 			/** output for .dat file. */
 			filefullpath_output_ = in_output_.output_folder_ + "/" + body_name_ + "_" + quantity_name_ + "_" + in_output_.restart_step_ + ".dat";
-			std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
+			dat_file_.openFile(filefullpath_output_);
+			std::ostream &out_file = dat_file_.row();
 			out_file << "\"run_time\""
 					 << "   ";
 			plt_engine_.writeAQuantityHeader(out_file, reduce_method_.InitialReference(), quantity_name_);
 			out_file << "\n";
-			out_file.close();
+			dat_file_.flush();
 
 			/** output for .xml file. */
 			filefullpath_input_ = in_output_.input_folder_ + "/" + body_name_ + "_" + quantity_name_ + "_" + in_output_.restart_step_ + ".xml";
@@ -524,19 +652,50 @@ namespace SPH
 
 		VariableType type_indicator_; /*< this is an indicator to identify the variable type. */
 
-		void writeXmlToXmlFile() { observe_xml_engine_.writeToXmlFile(filefullpath_input_); }
+		/** Write the rows of the .dat file every given number of observations. */
+		void setRowsPerFlush(size_t rows_per_flush) { dat_file_.setRowsPerFlush(rows_per_flush); };
+
+		/** Record the snapshots into a compact binary file instead of the xml memory. */
+		void useBinarySnapshots(size_t rows_per_flush = 100)
+		{
+			binary_snapshots_ = true;
+			binary_file_.setRowsPerFlush(rows_per_flush);
+			binary_file_.openFile(binarySnapshotFilePath(), std::ios::binary | std::ios::trunc);
+			binary_snapshot_io_.writeHeader(binary_file_, 1, sizeof(VariableType));
+		};
+
+		std::string binarySnapshotFilePath()
+		{
+			return filefullpath_input_.substr(0, filefullpath_input_.find_last_of('.')) + ".bin";
+		};
+
+		void writeXmlToXmlFile()
+		{
+			dat_file_.flush();
+			if (binary_snapshots_)
+				binary_file_.flush();
+			else
+				observe_xml_engine_.writeToXmlFile(filefullpath_input_);
+		};
 
 		virtual void writeToFile(size_t iteration_step = 0)
 		{
-			std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-			out_file << GlobalStaticVariables::physical_time_ << "   ";
+			std::ostream &out_file = dat_file_.row();
+			out_file << in_output_.sph_system_.PhysicalTime() << "   ";
 			plt_engine_.writeAQuantity(out_file, reduce_method_.parallel_exec());
 			out_file << "\n";
-			out_file.close();
+			dat_file_.endRow();
 		};
 
 		void writeToXml(size_t iteration = 0)
 		{
+			if (binary_snapshots_)
+			{
+				binary_snapshot_io_.writeSnapshotTag(binary_file_, iteration);
+				binary_snapshot_io_.writeColumn(binary_file_, reduce_method_.parallel_exec());
+				binary_file_.endRow();
+				return;
+			}
 			std::string element_name_ = "Snapshot_" + std::to_string(iteration);
 			SimTK::Xml::Element &element_ = observe_xml_engine_.root_element_;
 			observe_xml_engine_.addElementToXmlDoc(element_name_);
@@ -546,6 +705,12 @@ namespace SPH
 
 		void readFromXml()
 		{
+			if (binary_snapshots_)
+			{
+				binary_file_.flush();
+				binary_snapshot_io_.readSnapshots(binarySnapshotFilePath(), current_result_, element_tag_);
+				return;
+			}
 			observe_xml_engine_.loadXmlFile(filefullpath_input_);
 			size_t number_of_particle_ = 1;
 			size_t number_of_snapshot_ = std::distance(observe_xml_engine_.root_element_.element_begin(),
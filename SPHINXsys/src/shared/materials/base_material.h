@@ -112,6 +112,12 @@ namespace SPH
 		virtual Real getPressure(Real rho, Real rho_e) { return getPressure(rho); };
 		virtual Real DensityFromPressure(Real p) = 0;
 		virtual Real getSoundSpeed(Real p = 0.0, Real rho = 1.0) = 0;
+		/** sound speeds of a batch of states with one virtual call, to be overridden with getSoundSpeed */
+		virtual void getSoundSpeeds(const Real *p, const Real *rho, Real *c, int size)
+		{
+			for (int l = 0; l < size; ++l)
+				c[l] = getSoundSpeed(p[l], rho[l]);
+		};
 		virtual Fluid *ThisObjectPtr() override { return this; };
 	};
 
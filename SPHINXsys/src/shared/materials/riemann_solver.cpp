@@ -24,6 +24,20 @@ namespace SPH
 		return (state_i.vel_ * state_i.rho_ + state_j.vel_ * state_j.rho_) / (state_i.rho_ + state_j.rho_);
 	}
 	//=================================================================================================//
+	void NoRiemannSolver::
+		getPStars(const FluidState &state_i, const FluidStateBatch &batch, Real *p_star)
+	{
+		for (int l = 0; l < batch.size_; ++l)
+			p_star[l] = (state_i.p_ * batch.rho_[l] + batch.p_[l] * state_i.rho_) / (state_i.rho_ + batch.rho_[l]);
+	}
+	//=================================================================================================//
+	void NoRiemannSolver::
+		getVStars(const FluidState &state_i, const FluidStateBatch &batch, Vecd *v_star)
+	{
+		for (int l = 0; l < batch.size_; ++l)
+			v_star[l] = (state_i.vel_ * state_i.rho_ + batch.vel_[l] * batch.rho_[l]) / (state_i.rho_ + batch.rho_[l]);
+	}
+	//=================================================================================================//
 	void BaseAcousticRiemannSolver::
 		prepareSolver(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij,
 					  Real &ul, Real &ur, Real &rhol_cl, Real &rhor_cr)
@@ -34,6 +48,12 @@ namespace SPH
 		rhor_cr = fluid_j_.getSoundSpeed(state_j.p_, state_j.rho_) * state_j.rho_;
 	}
 	//=================================================================================================//
+	void BaseAcousticRiemannSolver::
+		prepareSolvers(FluidStateBatch &batch)
+	{
+		fluid_j_.getSoundSpeeds(batch.p_, batch.rho_, batch.c_j_, batch.size_);
+	}
+	//=================================================================================================//
 	Real AcousticRiemannSolver::
 		getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
 	{
@@ -57,6 +77,39 @@ namespace SPH
 			   e_ij * (u_star - (ul * state_i.rho_ + ur * state_j.rho_) / (state_i.rho_ + state_j.rho_));
 	}
 	//=================================================================================================//
+	void AcousticRiemannSolver::
+		getPStars(const FluidState &state_i, FluidStateBatch &batch, Real *p_star)
+	{
+		prepareSolvers(batch);
+		Real rhol_cl = fluid_i_.getSoundSpeed(state_i.p_, state_i.rho_) * state_i.rho_;
+		for (int l = 0; l < batch.size_; ++l)
+		{
+			Real ul = dot(-batch.e_ij_[l], state_i.vel_);
+			Real ur = dot(-batch.e_ij_[l], batch.vel_[l]);
+			Real rhor_cr = batch.c_j_[l] * batch.rho_[l];
+			Real clr = (rhol_cl + rhor_cr) / (state_i.rho_ + batch.rho_[l]);
+			p_star[l] = (rhol_cl * batch.p_[l] + rhor_cr * state_i.p_ +
+						 rhol_cl * rhor_cr * (ul - ur) * SMIN(3.0 * SMAX((ul - ur) / clr, 0.0), 1.0)) /
+						(rhol_cl + rhor_cr);
+		}
+	}
+	//=================================================================================================//
+	void AcousticRiemannSolver::
+		getVStars(const FluidState &state_i, FluidStateBatch &batch, Vecd *v_star)
+	{
+		prepareSolvers(batch);
+		Real rhol_cl = fluid_i_.getSoundSpeed(state_i.p_, state_i.rho_) * state_i.rho_;
+		for (int l = 0; l < batch.size_; ++l)
+		{
+			Real ul = dot(-batch.e_ij_[l], state_i.vel_);
+			Real ur = dot(-batch.e_ij_[l], batch.vel_[l]);
+			Real rhor_cr = batch.c_j_[l] * batch.rho_[l];
+			Real u_star = (rhol_cl * ul + rhor_cr * ur + state_i.p_ - batch.p_[l]) / (rhol_cl + rhor_cr);
+			v_star[l] = (state_i.vel_ * state_i.rho_ + batch.vel_[l] * batch.rho_[l]) / (state_i.rho_ + batch.rho_[l]) -
+						batch.e_ij_[l] * (u_star - (ul * state_i.rho_ + ur * batch.rho_[l]) / (state_i.rho_ + batch.rho_[l]));
+		}
+	}
+	//=================================================================================================//
 	Real DissipativeRiemannSolver::
 		getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
 	{
@@ -31,6 +31,8 @@
 
 #include "base_data_package.h"
 
+#include <type_traits>
+
 namespace SPH
 {
 	struct FluidState
@@ -48,6 +50,31 @@ namespace SPH
 			: FluidState(rho, vel, p), E_(E){};
 	};
 
+	/** number of neighbor states processed together by the batched Riemann solvers */
+	const int riemann_batch_size = 4;
+
+	/**
+	 * @struct FluidStateBatch
+	 * @brief The states of a batch of neighbor particles gathered in lane arrays,
+	 * so that the material is called once for the batch and the scalar part of a Riemann solver
+	 * runs in a single straight loop over the lanes. The results are bitwise identical to the
+	 * Riemann solver called neighbor by neighbor.
+	 */
+	struct FluidStateBatch
+	{
+		int size_; /**< number of lanes in use */
+		Real rho_[riemann_batch_size], p_[riemann_batch_size];
+		Vecd vel_[riemann_batch_size], e_ij_[riemann_batch_size];
+		/** sound speeds, prepared by the acoustic Riemann solvers */
+		Real c_j_[riemann_batch_size];
+	};
+
+	/** whether a Riemann solver provides the batched getPStars and getVStars */
+	template <class RiemannSolverType>
+	struct IsBatchedRiemannSolver : std::false_type
+	{
+	};
+
 	class Fluid;
 	class CompressibleFluid;
 
@@ -59,6 +86,12 @@ namespace SPH
 		NoRiemannSolver(Fluid &fluid_i, Fluid &fluid_j) : fluid_l_(fluid_i), fluid_r_(fluid_j){};
 		Real getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
 		Vecd getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
+		void getPStars(const FluidState &state_i, const FluidStateBatch &batch, Real *p_star);
+		void getVStars(const FluidState &state_i, const FluidStateBatch &batch, Vecd *v_star);
+	};
+	template <>
+	struct IsBatchedRiemannSolver<NoRiemannSolver> : std::true_type
+	{
 	};
 
 	class BaseAcousticRiemannSolver
@@ -70,6 +103,8 @@ namespace SPH
 		BaseAcousticRiemannSolver(Fluid &fluid_i, Fluid &fluid_j) : fluid_i_(fluid_i), fluid_j_(fluid_j){};
 		inline void prepareSolver(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i,
 								  Real &ul, Real &ur, Real &rhol_cl, Real &rhor_cr);
+		/** the sound speeds of the neighbor states with a single call to the material for the batch */
+		void prepareSolvers(FluidStateBatch &batch);
 	};
 	class AcousticRiemannSolver : public BaseAcousticRiemannSolver
 	{
@@ -77,6 +112,12 @@ namespace SPH
 		AcousticRiemannSolver(Fluid &fluid_i, Fluid &fluid_j) : BaseAcousticRiemannSolver(fluid_i, fluid_j){};
 		Real getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
 		Vecd getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
+		void getPStars(const FluidState &state_i, FluidStateBatch &batch, Real *p_star);
+		void getVStars(const FluidState &state_i, FluidStateBatch &batch, Vecd *v_star);
+	};
+	template <>
+	struct IsBatchedRiemannSolver<AcousticRiemannSolver> : std::true_type
+	{
 	};
 
 	class DissipativeRiemannSolver : public BaseAcousticRiemannSolver
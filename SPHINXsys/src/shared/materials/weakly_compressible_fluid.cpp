@@ -23,6 +23,12 @@ namespace SPH
 		return c0_;
 	}
 	//=================================================================================================//
+	void WeaklyCompressibleFluid::getSoundSpeeds(const Real *p, const Real *rho, Real *c, int size)
+	{
+		for (int l = 0; l < size; ++l)
+			c[l] = c0_;
+	}
+	//=================================================================================================//
 	Real SymmetricTaitFluid::getPressure(Real rho)
 	{
 		Real rho_ratio = rho / rho0_;
@@ -46,4 +52,10 @@ namespace SPH
 				   : sqrt((p0_ - Real(gamma_) * p) / rho);
 	}
 	//=================================================================================================//
+	void SymmetricTaitFluid::getSoundSpeeds(const Real *p, const Real *rho, Real *c, int size)
+	{
+		for (int l = 0; l < size; ++l)
+			c[l] = SymmetricTaitFluid::getSoundSpeed(p[l], rho[l]);
+	}
+	//=================================================================================================//
 }
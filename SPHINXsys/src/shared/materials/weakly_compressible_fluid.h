@@ -58,6 +58,7 @@ namespace SPH
 		virtual Real getPressure(Real rho) override;
 		virtual Real DensityFromPressure(Real p) override;
 		virtual Real getSoundSpeed(Real p = 0.0, Real rho = 1.0) override;
+		virtual void getSoundSpeeds(const Real *p, const Real *rho, Real *c, int size) override;
 		virtual WeaklyCompressibleFluid *ThisObjectPtr() override { return this; };
 	};
 
@@ -107,6 +108,7 @@ namespace SPH
 		virtual Real getPressure(Real rho) override;
 		virtual Real DensityFromPressure(Real p) override;
 		virtual Real getSoundSpeed(Real p = 0.0, Real rho = 1.0) override;
+		virtual void getSoundSpeeds(const Real *p, const Real *rho, Real *c, int size) override;
 	};
 
 	/**
@@ -116,6 +116,8 @@ namespace SPH
 		/** The array for of mesh cells, i.e. mesh data.
 		 * Within each cell, a list is saved with the indexes of particles.*/
 		MeshDataMatrix<CellList> cell_linked_lists_;
+		/** affinity history of the loops over the cells of this mesh only */
+		tbb::affinity_partitioner affinity_partitioner_;
 
 		virtual void updateSplitCellLists(SplitCellLists &split_cell_lists) override;
 
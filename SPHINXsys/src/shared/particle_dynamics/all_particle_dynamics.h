@@ -6,4 +6,7 @@
 
 #include "particle_dynamics_algorithms.h"
 #include "particle_dynamics_bodypart.h"
+#include "particle_dynamics_local_time_stepping.h"
+#include "particle_dynamics_task_graph.h"
+#include "particle_dynamics_cache_blocking.h"
 #endif //ALL_PARTICLE_DYNAMICS_H
\ No newline at end of file
@@ -4,6 +4,8 @@
  */
 #include "base_particle_dynamics.h"
 #include "base_particle_dynamics.hpp"
+
+#include <algorithm>
 //=============================================================================================//
 namespace SPH
 {
@@ -24,6 +26,143 @@ namespace SPH
 			}
 		}, ap);
 	}
+	//=============================================================================================//
+	void ParticleIterator_parallel(size_t total_real_particles, ParticleFunctor &particle_functor,
+		ExecutionPolicy &execution_policy, Real dt)
+	{
+		execution_policy.parallelFor(total_real_particles,
+			[&](const blocked_range<size_t>& r) {
+			for (size_t i = r.begin(); i < r.end(); ++i) {
+				particle_functor(i, dt);
+			}
+		});
+	}
+	//=============================================================================================//
+	void ParticleIteratorByIndexes(const IndexVector &particle_indexes, ParticleFunctor &particle_functor, Real dt)
+	{
+		for (size_t i = 0; i < particle_indexes.size(); ++i)
+			particle_functor(particle_indexes[i], dt);
+	}
+	//=============================================================================================//
+	void ParticleIteratorByIndexes_parallel(const IndexVector &particle_indexes, ParticleFunctor &particle_functor, Real dt)
+	{
+		parallel_for(blocked_range<size_t>(0, particle_indexes.size()),
+			[&](const blocked_range<size_t>& r) {
+			for (size_t i = r.begin(); i < r.end(); ++i) {
+				particle_functor(particle_indexes[i], dt);
+			}
+		}, ap);
+	}
+	//=============================================================================================//
+	void ParticleIteratorByIndexes_parallel(const IndexVector &particle_indexes, ParticleFunctor &particle_functor,
+		ExecutionPolicy &execution_policy, Real dt)
+	{
+		execution_policy.parallelFor(particle_indexes.size(),
+			[&](const blocked_range<size_t>& r) {
+			for (size_t i = r.begin(); i < r.end(); ++i) {
+				particle_functor(particle_indexes[i], dt);
+			}
+		});
+	}
+	//=============================================================================================//
+	void ParticleIteratorByRanges_parallel(const IndexVector &range_bounds, ParticleFunctor &particle_functor,
+		ExecutionPolicy &execution_policy, Real dt)
+	{
+		execution_policy.parallelFor(range_bounds.size() - 1,
+			[&](const blocked_range<size_t>& r) {
+			for (size_t k = r.begin(); k < r.end(); ++k) {
+				for (size_t i = range_bounds[k]; i < range_bounds[k + 1]; ++i)
+					particle_functor(i, dt);
+			}
+		});
+	}
+	//=============================================================================================//
+	void NeighborWeightedPartition::addRelation(BaseBodyRelationInner &inner_relation)
+	{
+		configurations_.push_back(&inner_relation.inner_configuration_);
+		addRelationUpdates(inner_relation);
+	}
+	//=============================================================================================//
+	void NeighborWeightedPartition::addRelation(BaseBodyRelationContact &contact_relation)
+	{
+		for (size_t k = 0; k != contact_relation.contact_configuration_.size(); ++k)
+			configurations_.push_back(&contact_relation.contact_configuration_[k]);
+		addRelationUpdates(contact_relation);
+	}
+	//=============================================================================================//
+	void NeighborWeightedPartition::addRelationUpdates(SPHBodyRelation &relation)
+	{
+		relations_.push_back(&relation);
+		/** an update number which can not be the current one, so that the ranges are rebuilt first */
+		relation_updates_.push_back(relation.configuration_updates_ - 1);
+	}
+	//=============================================================================================//
+	bool NeighborWeightedPartition::isOutdated(size_t total_real_particles)
+	{
+		bool is_outdated = total_real_particles != total_real_particles_;
+		for (size_t k = 0; k != relations_.size(); ++k)
+		{
+			if (relations_[k]->configuration_updates_ != relation_updates_[k])
+			{
+				relation_updates_[k] = relations_[k]->configuration_updates_;
+				is_outdated = true;
+			}
+		}
+		total_real_particles_ = total_real_particles;
+		return is_outdated;
+	}
+	//=============================================================================================//
+	size_t NeighborWeightedPartition::Workload(size_t index_i)
+	{
+		size_t workload = 1;
+		for (size_t k = 0; k != configurations_.size(); ++k)
+			workload += (*configurations_[k])[index_i].current_size_;
+		return workload;
+	}
+	//=============================================================================================//
+	void NeighborWeightedPartition::update(size_t total_real_particles)
+	{
+		if (!isOutdated(total_real_particles))
+			return;
+
+		size_t number_of_ranges = SMAX(size_t(1), ranges_per_thread_ * size_t(this_task_arena::max_concurrency()));
+		size_t block_size = (total_real_particles + number_of_ranges - 1) / number_of_ranges;
+		workload_sum_.resize(total_real_particles);
+
+		/** prefix sum within blocks, then the block offsets are added */
+		IndexVector block_sums(number_of_ranges + 1, 0);
+		parallel_for(blocked_range<size_t>(0, number_of_ranges),
+			[&](const blocked_range<size_t>& r) {
+			for (size_t b = r.begin(); b < r.end(); ++b) {
+				size_t sum = 0;
+				for (size_t i = b * block_size; i < SMIN(total_real_particles, (b + 1) * block_size); ++i) {
+					sum += Workload(i);
+					workload_sum_[i] = sum;
+				}
+				block_sums[b + 1] = sum;
+			}
+		}, ap);
+		for (size_t b = 0; b != number_of_ranges; ++b)
+			block_sums[b + 1] += block_sums[b];
+		parallel_for(blocked_range<size_t>(0, number_of_ranges),
+			[&](const blocked_range<size_t>& r) {
+			for (size_t b = r.begin(); b < r.end(); ++b) {
+				for (size_t i = b * block_size; i < SMIN(total_real_particles, (b + 1) * block_size); ++i)
+					workload_sum_[i] += block_sums[b];
+			}
+		}, ap);
+
+		/** range k starts at the first particle with the work sum beyond k parts of the total work */
+		size_t total_workload = block_sums[number_of_ranges];
+		range_bounds_.resize(number_of_ranges + 1);
+		range_bounds_[0] = 0;
+		range_bounds_[number_of_ranges] = total_real_particles;
+		for (size_t k = 1; k != number_of_ranges; ++k)
+		{
+			size_t target = total_workload * k / number_of_ranges;
+			range_bounds_[k] = std::upper_bound(workload_sum_.begin(), workload_sum_.end(), target) - workload_sum_.begin();
+		}
+	}
 	//=================================================================================================//
 	void ParticleIteratorSplittingSweep(SplitCellLists& split_cell_lists,
 		ParticleFunctor& particle_functor, Real dt)
@@ -38,9 +38,13 @@
 #include "neighbor_relation.h"
 #include "all_bodies.h"
 #include "cell_linked_list.h"
+#include "sph_system.h"
 #include "external_force.h"
 #include "body_relation.h"
+#include "counter_based_random.h"
+#include "execution_policy.h"
 #include <functional>
+#include <typeinfo>
 
 using namespace std::placeholders;
 
@@ -56,6 +60,22 @@ namespace SPH
 	void ParticleIterator(size_t total_real_particles, ParticleFunctor &particle_functor, Real dt = 0.0);
 	/** Iterators for particle functors. parallel computing. */
 	void ParticleIterator_parallel(size_t total_real_particles, ParticleFunctor &particle_functor, Real dt = 0.0);
+	/** Iterators for particle functors. parallel computing with a given execution policy. */
+	void ParticleIterator_parallel(size_t total_real_particles, ParticleFunctor &particle_functor,
+								   ExecutionPolicy &execution_policy, Real dt = 0.0);
+
+	/** Iterators for particle functors on a given set of particles. sequential computing. */
+	void ParticleIteratorByIndexes(const IndexVector &particle_indexes, ParticleFunctor &particle_functor, Real dt = 0.0);
+	/** Iterators for particle functors on a given set of particles. parallel computing. */
+	void ParticleIteratorByIndexes_parallel(const IndexVector &particle_indexes, ParticleFunctor &particle_functor, Real dt = 0.0);
+	/** Iterators for particle functors on a given set of particles. parallel computing with a given execution policy. */
+	void ParticleIteratorByIndexes_parallel(const IndexVector &particle_indexes, ParticleFunctor &particle_functor,
+											ExecutionPolicy &execution_policy, Real dt = 0.0);
+
+	/** Iterators for particle functors over consecutive ranges, range k is [range_bounds[k], range_bounds[k + 1]).
+	 *  parallel computing over the ranges with a given execution policy. */
+	void ParticleIteratorByRanges_parallel(const IndexVector &range_bounds, ParticleFunctor &particle_functor,
+										   ExecutionPolicy &execution_policy, Real dt = 0.0);
 
 	/** Iterators for reduce functors. sequential computing. */
 	template <class ReturnType, typename ReduceOperation>
@@ -65,6 +85,11 @@ namespace SPH
 	template <class ReturnType, typename ReduceOperation>
 	ReturnType ReduceIterator_parallel(size_t total_real_particles, ReturnType temp,
 									   ReduceFunctor<ReturnType> &reduce_functor, ReduceOperation &reduce_operation, Real dt = 0.0);
+	/** Iterators for reduce functors. parallel computing with a given execution policy. */
+	template <class ReturnType, typename ReduceOperation>
+	ReturnType ReduceIterator_parallel(size_t total_real_particles, ReturnType temp,
+									   ReduceFunctor<ReturnType> &reduce_functor, ReduceOperation &reduce_operation,
+									   ExecutionPolicy &execution_policy, Real dt = 0.0);
 
 	/** Iterators for particle functors with splitting. sequential computing. */
 	void ParticleIteratorSplittingSweep(SplitCellLists &split_cell_lists,
@@ -127,10 +152,48 @@ namespace SPH
 		explicit GlobalStaticVariables(){};
 		virtual ~GlobalStaticVariables(){};
 
-		/** the physical time is global value for all dynamics */
+		/** the physical time is global value for all dynamics,
+		 *  unless an SPH system uses its own physical time, see SPHSystem::useOwnPhysicalTime. */
 		static Real physical_time_;
 	};
 
+	/**
+	 * @class NeighborWeightedPartition
+	 * @brief Consecutive particle ranges of about equal work for the parallel interaction loops.
+	 * The work of a particle is estimated as one plus its number of neighbors in the given configurations,
+	 * and the ranges are split from the prefix sum of the work. There are several ranges per thread,
+	 * so that the remaining imbalance is removed by work stealing.
+	 * The ranges are rebuilt only when a relation has updated its configurations
+	 * or the number of particles has changed.
+	 */
+	class NeighborWeightedPartition
+	{
+	public:
+		explicit NeighborWeightedPartition(size_t ranges_per_thread = 8)
+			: ranges_per_thread_(ranges_per_thread), total_real_particles_(0){};
+		virtual ~NeighborWeightedPartition(){};
+
+		void addRelation(BaseBodyRelationInner &inner_relation);
+		void addRelation(BaseBodyRelationContact &contact_relation);
+		bool isActive() { return !configurations_.empty(); };
+		/** rebuild the ranges from the neighbor counts if the configurations have been updated since */
+		void update(size_t total_real_particles);
+		const IndexVector &RangeBounds() { return range_bounds_; };
+
+	protected:
+		size_t ranges_per_thread_;
+		StdVec<ParticleConfiguration *> configurations_;
+		StdVec<SPHBodyRelation *> relations_;
+		IndexVector relation_updates_; /**< the configuration updates of the relations at the last rebuild */
+		size_t total_real_particles_;  /**< the number of particles at the last rebuild */
+		StdLargeVec<size_t> workload_sum_; /**< inclusive prefix sum of the work of the particles */
+		IndexVector range_bounds_;
+
+		void addRelationUpdates(SPHBodyRelation &relation);
+		bool isOutdated(size_t total_real_particles);
+		size_t Workload(size_t index_i);
+	};
+
 	/**
 	* @class ParticleDynamics
 	* @brief The base class for all particle dynamics
@@ -144,7 +207,14 @@ namespace SPH
 		explicit ParticleDynamics(SPHBody &sph_body)
 			: GlobalStaticVariables(), sph_body_(&sph_body),
 			  sph_adaptation_(sph_body.sph_adaptation_),
-			  base_particles_(sph_body.base_particles_){};
+			  base_particles_(sph_body.base_particles_),
+			  random_(uint32_t(sph_body.getSPHSystem().random_seed_),
+					  uint32_t(sph_body.getSPHSystem().newRandomStream())),
+			  random_step_(0),
+			  execution_policy_(sph_body.getSPHSystem().numa_aware_
+									? PartitionerType::Static
+									: PartitionerType::Affinity),
+			  is_autotune_requested_(sph_body.getSPHSystem().tune_execution_policies_){};
 		virtual ~ParticleDynamics(){};
 
 		SPHBody *getSPHBody() { return sph_body_; };
@@ -153,14 +223,71 @@ namespace SPH
 		virtual ReturnType exec(Real dt = 0.0) = 0;
 		virtual ReturnType parallel_exec(Real dt = 0.0) = 0;
 
+		ExecutionPolicy &executionPolicy() { return execution_policy_; };
+		/** balance the parallel interaction loop by the neighbor counts of the relation,
+		 *  may be called for several relations, e.g. the inner and the contact ones */
+		void balanceWorkloadByNeighbors(BaseBodyRelationInner &inner_relation)
+		{
+			workload_partition_.addRelation(inner_relation);
+		};
+		void balanceWorkloadByNeighbors(BaseBodyRelationContact &contact_relation)
+		{
+			workload_partition_.addRelation(contact_relation);
+		};
+		const IndexVector &WorkloadRangeBounds() { return workload_partition_.RangeBounds(); };
+		/** tune the partitioner and grain size of the parallel loops during the next executions,
+		 *  or use the setting tuned before under the same name, by default
+		 *  the body name and the type of the particle dynamics. */
+		void autotuneExecutionPolicy(const std::string &name = "", size_t samples_per_candidate = 5)
+		{
+			std::string policy_name = name.empty() ? sph_body_->getBodyName() + "_" + typeid(*this).name() : name;
+			execution_policy_.autotune(policy_name, samples_per_candidate);
+		};
+
 	protected:
 		SPHBody *sph_body_;
 		SPHAdaptation *sph_adaptation_;
 		BaseParticles *base_particles_;
 
 		void setBodyUpdated() { sph_body_->setNewlyUpdated(); };
+		/** the physical time of the SPH system the body belongs to */
+		Real &PhysicalTime() { return sph_body_->getSPHSystem().PhysicalTime(); };
 		/** the function for set global parameters for the particle dynamics */
 		virtual void setupDynamics(Real dt = 0.0){};
+
+		CounterBasedRandom random_;
+		size_t random_step_;
+		/** uniform random number in (0, 1) determined by the system seed, this dynamics,
+		 *  the random step and the given index, e.g. the unsorted particle index. */
+		Real UniformRandom(size_t index, size_t draw = 0) { return random_.uniform(random_step_, index, draw); };
+		/** draw new random numbers for the next execution */
+		void advanceRandomStep() { ++random_step_; };
+
+		ExecutionPolicy execution_policy_;
+		bool is_autotune_requested_; /**< start autotuning at the first parallel execution, when the type is known */
+		NeighborWeightedPartition workload_partition_;
+		/** bracket a parallel execution, so that the execution policy is tuned by whole executions */
+		void startParallelExecution()
+		{
+			if (is_autotune_requested_)
+			{
+				is_autotune_requested_ = false;
+				autotuneExecutionPolicy();
+			}
+			execution_policy_.startExecution();
+		};
+		void finishParallelExecution() { execution_policy_.finishExecution(); };
+		/** the parallel loop for the interaction step, balanced by the neighbor counts if requested */
+		void iterateInteraction_parallel(size_t total_real_particles, ParticleFunctor &particle_functor, Real dt)
+		{
+			if (!workload_partition_.isActive())
+			{
+				ParticleIterator_parallel(total_real_particles, particle_functor, execution_policy_, dt);
+				return;
+			}
+			workload_partition_.update(total_real_particles);
+			ParticleIteratorByRanges_parallel(workload_partition_.RangeBounds(), particle_functor, execution_policy_, dt);
+		};
 	};
 
 	/**
@@ -212,14 +339,24 @@ namespace SPH
 	class DataDelegateInner : public BaseDataDelegateType
 	{
 	public:
+		/** registered as reading the stored pair fields directly, see readPairFieldsThroughAccessor */
 		explicit DataDelegateInner(BaseBodyRelationInner &body_inner_relation)
 			: BaseDataDelegateType(*body_inner_relation.sph_body_),
-			  inner_configuration_(body_inner_relation.inner_configuration_){};
-		virtual ~DataDelegateInner(){};
+			  inner_relation_(&body_inner_relation),
+			  inner_configuration_(body_inner_relation.inner_configuration_)
+		{
+			inner_relation_->registerPairFieldReader(this, false);
+		};
+		virtual ~DataDelegateInner() { inner_relation_->unregisterPairFieldReader(this); };
 
 	protected:
+		BaseBodyRelationInner *inner_relation_;
 		/** inner configuration of the designated body */
 		ParticleConfiguration &inner_configuration_;
+
+		/** to be called by a dynamics reading all the pair fields through a NeighborFieldAccessor,
+		 * so that it works with a reduced storage policy of the inner relation */
+		void readPairFieldsThroughAccessor() { inner_relation_->registerPairFieldReader(this, true); };
 	};
 
 	/**
@@ -61,6 +61,24 @@ namespace SPH {
 			);
 	}
 	//=================================================================================================//
+	template <class ReturnType, typename ReduceOperation>
+	ReturnType ReduceIterator_parallel(size_t total_real_particles, ReturnType temp,
+		ReduceFunctor<ReturnType>& reduce_functor, ReduceOperation& reduce_operation,
+		ExecutionPolicy& execution_policy, Real dt)
+	{
+		return execution_policy.parallelReduce(total_real_particles,
+			temp, [&](const blocked_range<size_t>& r, ReturnType temp0)->ReturnType {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					temp0 = reduce_operation(temp0, reduce_functor(i, dt));
+				}
+				return temp0;
+			},
+			[&](ReturnType x, ReturnType y)->ReturnType {
+				return reduce_operation(x, y);
+			}
+			);
+	}
+	//=================================================================================================//
 	template<class ParticleDynamicsInnerType, class ContactDataType>
 	ParticleDynamicsComplex<ParticleDynamicsInnerType, ContactDataType>:: 
 		ParticleDynamicsComplex(ComplexBodyRelation &complex_relation, 
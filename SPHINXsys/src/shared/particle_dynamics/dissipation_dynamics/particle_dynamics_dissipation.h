@@ -42,6 +42,10 @@ namespace SPH
 	typedef DataDelegateContact<SPHBody, BaseParticles, BaseMaterial,
 		SolidBody, SolidParticles, Solid, DataDelegateEmptyBase> DissipationDataWithWall;
 
+	/** inner products of the damped variables, used by the conjugate gradient damping */
+	inline Real dampingInnerProduct(const Real &a, const Real &b) { return a * b; };
+	inline Real dampingInnerProduct(const Vecd &a, const Vecd &b) { return SimTK::dot(a, b); };
+
 	template <typename VariableType>
 	struct ErrorAndParameters
 	{
@@ -169,6 +173,75 @@ namespace SPH
 		StdVec<StdLargeVec<VariableType>*> wall_variable_;
 	};
 
+	/**
+	* @class DampingByConjugateGradientInner
+	* @brief A quantity damping by solving the implicit viscous operator
+	* with a Jacobi preconditioned conjugate gradient method.
+	* The same pairwise operator as DampingBySplittingInner is applied matrix-free
+	* from the inner configuration, so that all loops are plain parallel loops over particles
+	* instead of sweeps over split cell lists.
+	* The operator is symmetric only for symmetric neighbor pairs,
+	* i.e. with a uniform smoothing length.
+	* Neighbors which are not real particles, such as ghosts, are kept fixed during the solve.
+	*/
+	template <int DataTypeIndex, typename VariableType>
+	class DampingByConjugateGradientInner :
+		public ParticleDynamics<void>, public DissipationDataInner
+	{
+	public:
+		DampingByConjugateGradientInner(BaseBodyRelationInner &inner_relation, const std::string &variable_name, Real eta);
+		virtual ~DampingByConjugateGradientInner() {};
+		void resetDampingCoefficient(Real reset_ratio) { eta_ *= reset_ratio; };
+		/** the solve stops when the residual norm is below residual_tolerance times the norm of the source. */
+		void setSolverParameters(Real residual_tolerance, size_t max_iterations);
+		size_t NumberOfIterations() { return number_of_iterations_; };
+
+		virtual void exec(Real dt = 0.0) override;
+		virtual void parallel_exec(Real dt = 0.0) override;
+	protected:
+		Real eta_; /**< damping coefficient */
+		StdLargeVec<Real>& Vol_, & mass_;
+		StdLargeVec<VariableType>& variable_;
+		Real residual_tolerance_;
+		size_t max_iterations_, number_of_iterations_;
+		StdLargeVec<Real> diagonal_;
+		StdLargeVec<VariableType> source_, residual_, preconditioned_residual_, direction_, operator_direction_;
+
+		Real pairParameter(Real dW_ij, Real Vol_i, Real Vol_j, Real r_ij, Real dt)
+		{
+			return -2.0 * eta_ * dW_ij * Vol_i * Vol_j * dt / r_ij;
+		};
+		/** diagonal of the operator and source of the linear system of particle i */
+		virtual void assembleDiagonalAndSource(size_t index_i, Real dt);
+		/** operator applied on a field, only the coupling among real particles */
+		VariableType applyOperator(size_t index_i, StdLargeVec<VariableType> &field, Real dt);
+		void solve(Real dt, bool parallel);
+
+		template <class FunctionOnParticle>
+		void particleLoop(bool parallel, const FunctionOnParticle &function);
+		template <class FunctionOnParticle>
+		Real particleSum(bool parallel, const FunctionOnParticle &function);
+	};
+
+	/**
+	* @class DampingByConjugateGradientWithWall
+	* @brief Damping with wall by the conjugate gradient method,
+	* the wall variable is not updated and enters the source term.
+	*/
+	template <int DataTypeIndex, typename VariableType>
+	class DampingByConjugateGradientWithWall :
+		public DampingByConjugateGradientInner<DataTypeIndex, VariableType>, public DissipationDataWithWall
+	{
+	public:
+		DampingByConjugateGradientWithWall(ComplexBodyRelation &complex_wall_relation, const std::string &variable_name, Real eta);
+		virtual ~DampingByConjugateGradientWithWall() {};
+	protected:
+		virtual void assembleDiagonalAndSource(size_t index_i, Real dt) override;
+	private:
+		StdVec<StdLargeVec<Real>*> wall_Vol_;
+		StdVec<StdLargeVec<VariableType>*> wall_variable_;
+	};
+
 	/**
 	* @class DampingWithRandomChoice
 	* @brief A random choice method for obstaining static equilibrium state
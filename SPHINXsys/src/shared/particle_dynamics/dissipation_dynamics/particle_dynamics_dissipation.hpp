@@ -369,6 +369,214 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	template <int DataTypeIndex, typename VariableType>
+	DampingByConjugateGradientInner<DataTypeIndex, VariableType>::
+		DampingByConjugateGradientInner(BaseBodyRelationInner &inner_relation,
+										const std::string &variable_name, Real eta)
+		: ParticleDynamics<void>(*inner_relation.sph_body_),
+		  DissipationDataInner(inner_relation), eta_(eta),
+		  Vol_(particles_->Vol_), mass_(particles_->mass_),
+		  variable_(*particles_->getVariableByName<DataTypeIndex, VariableType>(variable_name)),
+		  residual_tolerance_(1.0e-6), max_iterations_(100), number_of_iterations_(0) {}
+	//=================================================================================================//
+	template <int DataTypeIndex, typename VariableType>
+	void DampingByConjugateGradientInner<DataTypeIndex, VariableType>::
+		setSolverParameters(Real residual_tolerance, size_t max_iterations)
+	{
+		residual_tolerance_ = residual_tolerance;
+		max_iterations_ = max_iterations;
+	}
+	//=================================================================================================//
+	template <int DataTypeIndex, typename VariableType>
+	template <class FunctionOnParticle>
+	void DampingByConjugateGradientInner<DataTypeIndex, VariableType>::
+		particleLoop(bool parallel, const FunctionOnParticle &function)
+	{
+		size_t total_real_particles = particles_->total_real_particles_;
+		if (!parallel)
+		{
+			for (size_t i = 0; i != total_real_particles; ++i)
+				function(i);
+			return;
+		}
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					function(i);
+			},
+			ap);
+	}
+	//=================================================================================================//
+	template <int DataTypeIndex, typename VariableType>
+	template <class FunctionOnParticle>
+	Real DampingByConjugateGradientInner<DataTypeIndex, VariableType>::
+		particleSum(bool parallel, const FunctionOnParticle &function)
+	{
+		size_t total_real_particles = particles_->total_real_particles_;
+		if (!parallel)
+		{
+			Real sum = 0.0;
+			for (size_t i = 0; i != total_real_particles; ++i)
+				sum += function(i);
+			return sum;
+		}
+		return parallel_reduce(
+			blocked_range<size_t>(0, total_real_particles), Real(0),
+			[&](const blocked_range<size_t> &r, Real sum) -> Real
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					sum += function(i);
+				return sum;
+			},
+			[](Real x, Real y) -> Real
+			{ return x + y; });
+	}
+	//=================================================================================================//
+	template <int DataTypeIndex, typename VariableType>
+	void DampingByConjugateGradientInner<DataTypeIndex, VariableType>::
+		assembleDiagonalAndSource(size_t index_i, Real dt)
+	{
+		Real Vol_i = Vol_[index_i];
+		Real diagonal = mass_[index_i];
+		Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+		for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+		{
+			size_t index_j = inner_neighborhood.j_[n];
+			diagonal += pairParameter(inner_neighborhood.dW_ij_[n], Vol_i, Vol_[index_j], inner_neighborhood.r_ij_[n], dt);
+		}
+		diagonal_[index_i] = diagonal;
+		source_[index_i] = mass_[index_i] * variable_[index_i];
+	}
+	//=================================================================================================//
+	template <int DataTypeIndex, typename VariableType>
+	VariableType DampingByConjugateGradientInner<DataTypeIndex, VariableType>::
+		applyOperator(size_t index_i, StdLargeVec<VariableType> &field, Real dt)
+	{
+		Real Vol_i = Vol_[index_i];
+		VariableType result = diagonal_[index_i] * field[index_i];
+		Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+		for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+		{
+			size_t index_j = inner_neighborhood.j_[n];
+			result -= pairParameter(inner_neighborhood.dW_ij_[n], Vol_i, Vol_[index_j], inner_neighborhood.r_ij_[n], dt) * field[index_j];
+		}
+		return result;
+	}
+	//=================================================================================================//
+	template <int DataTypeIndex, typename VariableType>
+	void DampingByConjugateGradientInner<DataTypeIndex, VariableType>::solve(Real dt, bool parallel)
+	{
+		size_t total_real_particles = particles_->total_real_particles_;
+		size_t total_size = variable_.size();
+		diagonal_.resize(total_size);
+		source_.resize(total_size);
+		residual_.resize(total_size);
+		preconditioned_residual_.resize(total_size);
+		direction_.resize(total_size);
+		operator_direction_.resize(total_size);
+		/** the non-real particles are fixed, therefore, no search direction for them */
+		for (size_t i = total_real_particles; i != total_size; ++i)
+			direction_[i] = VariableType(0);
+
+		particleLoop(parallel, [&](size_t i)
+					 { assembleDiagonalAndSource(i, dt); });
+		Real source_norm_square = particleSum(parallel, [&](size_t i) -> Real
+											  { return dampingInnerProduct(source_[i], source_[i]); });
+
+		/** the initial guess is the current variable, with the non-real neighbors included */
+		particleLoop(parallel, [&](size_t i)
+					 {
+						 residual_[i] = source_[i] - applyOperator(i, variable_, dt);
+						 preconditioned_residual_[i] = residual_[i] / diagonal_[i];
+						 direction_[i] = preconditioned_residual_[i];
+					 });
+		Real residual_dot_preconditioned = particleSum(parallel, [&](size_t i) -> Real
+													   { return dampingInnerProduct(residual_[i], preconditioned_residual_[i]); });
+
+		Real tolerance_square = residual_tolerance_ * residual_tolerance_ * source_norm_square;
+		number_of_iterations_ = 0;
+		while (number_of_iterations_ < max_iterations_)
+		{
+			particleLoop(parallel, [&](size_t i)
+						 { operator_direction_[i] = applyOperator(i, direction_, dt); });
+			Real direction_energy = particleSum(parallel, [&](size_t i) -> Real
+												{ return dampingInnerProduct(direction_[i], operator_direction_[i]); });
+			Real alpha = residual_dot_preconditioned / (direction_energy + TinyReal);
+			particleLoop(parallel, [&](size_t i)
+						 {
+							 variable_[i] += alpha * direction_[i];
+							 residual_[i] -= alpha * operator_direction_[i];
+						 });
+			++number_of_iterations_;
+
+			Real residual_norm_square = particleSum(parallel, [&](size_t i) -> Real
+													{ return dampingInnerProduct(residual_[i], residual_[i]); });
+			if (residual_norm_square <= tolerance_square)
+				break;
+
+			particleLoop(parallel, [&](size_t i)
+						 { preconditioned_residual_[i] = residual_[i] / diagonal_[i]; });
+			Real new_residual_dot_preconditioned = particleSum(parallel, [&](size_t i) -> Real
+															   { return dampingInnerProduct(residual_[i], preconditioned_residual_[i]); });
+			Real beta = new_residual_dot_preconditioned / (residual_dot_preconditioned + TinyReal);
+			residual_dot_preconditioned = new_residual_dot_preconditioned;
+			particleLoop(parallel, [&](size_t i)
+						 { direction_[i] = preconditioned_residual_[i] + beta * direction_[i]; });
+		}
+	}
+	//=================================================================================================//
+	template <int DataTypeIndex, typename VariableType>
+	void DampingByConjugateGradientInner<DataTypeIndex, VariableType>::exec(Real dt)
+	{
+		solve(dt, false);
+	}
+	//=================================================================================================//
+	template <int DataTypeIndex, typename VariableType>
+	void DampingByConjugateGradientInner<DataTypeIndex, VariableType>::parallel_exec(Real dt)
+	{
+		solve(dt, true);
+	}
+	//=================================================================================================//
+	template <int DataTypeIndex, typename VariableType>
+	DampingByConjugateGradientWithWall<DataTypeIndex, VariableType>::
+		DampingByConjugateGradientWithWall(ComplexBodyRelation &complex_wall_relation,
+										   const std::string &variable_name, Real eta)
+		: DampingByConjugateGradientInner<DataTypeIndex, VariableType>(complex_wall_relation.inner_relation_, variable_name, eta),
+		  DissipationDataWithWall(complex_wall_relation.contact_relation_)
+	{
+		for (size_t k = 0; k != contact_particles_.size(); ++k)
+		{
+			wall_Vol_.push_back(&(contact_particles_[k]->Vol_));
+			wall_variable_.push_back(contact_particles_[k]->template getVariableByName<DataTypeIndex, VariableType>(variable_name));
+		}
+	}
+	//=================================================================================================//
+	template <int DataTypeIndex, typename VariableType>
+	void DampingByConjugateGradientWithWall<DataTypeIndex, VariableType>::
+		assembleDiagonalAndSource(size_t index_i, Real dt)
+	{
+		DampingByConjugateGradientInner<DataTypeIndex, VariableType>::assembleDiagonalAndSource(index_i, dt);
+
+		Real Vol_i = this->Vol_[index_i];
+		/** Contact interaction. */
+		for (size_t k = 0; k < contact_configuration_.size(); ++k)
+		{
+			StdLargeVec<Real> &Vol_k = *(wall_Vol_[k]);
+			StdLargeVec<VariableType> &variable_k = *(wall_variable_[k]);
+			Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
+			for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+			{
+				size_t index_j = contact_neighborhood.j_[n];
+				Real parameter_b = this->pairParameter(contact_neighborhood.dW_ij_[n], Vol_i, Vol_k[index_j], contact_neighborhood.r_ij_[n], dt);
+
+				this->diagonal_[index_i] += parameter_b;
+				this->source_[index_i] += parameter_b * variable_k[index_j];
+			}
+		}
+	}
+	//=================================================================================================//
 	template <class DampingAlgorithmType>
 	template <class BodyRelationType>
 	DampingWithRandomChoice<DampingAlgorithmType>::
@@ -380,7 +588,9 @@ namespace SPH
 	template <class DampingAlgorithmType>
 	bool DampingWithRandomChoice<DampingAlgorithmType>::RandomChoice()
 	{
-		return ((double)rand() / (RAND_MAX)) < random_ratio_ ? true : false;
+		Real random_number = this->UniformRandom(0);
+		this->advanceRandomStep();
+		return random_number < random_ratio_ ? true : false;
 	}
 	//=================================================================================================//
 	template <class DampingAlgorithmType>
@@ -24,8 +24,10 @@ namespace SPH
 			  thereshold_by_dimensions_(thereshold * (Real)Dimensions),
 			  Vol_(particles_->Vol_),
 			  surface_indicator_(particles_->surface_indicator_),
-			  smoothing_length_(inner_relation.sph_body_->sph_adaptation_->ReferenceSmoothingLength())
+			  smoothing_length_(inner_relation.sph_body_->sph_adaptation_->ReferenceSmoothingLength()),
+			  inner_neighbor_fields_(inner_relation)
 		{
+			readPairFieldsThroughAccessor();
 			particles_->registerAVariable<indexScalar, Real>(pos_div_, "PositionDivergence");
 		}
 		//=================================================================================================//
@@ -35,7 +37,8 @@ namespace SPH
 			const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
-				pos_div -= inner_neighborhood.dW_ij_[n] * inner_neighborhood.r_ij_[n] * Vol_[inner_neighborhood.j_[n]];
+				pos_div -= inner_neighbor_fields_.dW(inner_neighborhood, index_i, n) *
+						   inner_neighbor_fields_.r(inner_neighborhood, index_i, n) * Vol_[inner_neighborhood.j_[n]];
 			}
 			pos_div_[index_i] = pos_div;
 		}
@@ -49,7 +52,7 @@ namespace SPH
 			{
 				/** Two layer particles.*/
 				if (pos_div_[inner_neighborhood.j_[n]] < thereshold_by_dimensions_ &&
-					inner_neighborhood.r_ij_[n] < smoothing_length_)
+					inner_neighbor_fields_.r(inner_neighborhood, index_i, n) < smoothing_length_)
 				{
 					is_free_surface = true;
 					break;
@@ -64,7 +67,11 @@ namespace SPH
 			  Vol_(particles_->Vol_), rho_n_(particles_->rho_n_), mass_(particles_->mass_),
 			  rho_sum_(particles_->rho_sum_),
 			  W0_(sph_adaptation_->getKernel()->W0(Vecd(0))),
-			  rho0_(particles_->rho0_), inv_sigma0_(1.0 / particles_->sigma0_) {}
+			  rho0_(particles_->rho0_), inv_sigma0_(1.0 / particles_->sigma0_),
+			  inner_neighbor_fields_(inner_relation)
+		{
+			readPairFieldsThroughAccessor();
+		}
 		//=================================================================================================//
 		void DensitySummationInner::Interaction(size_t index_i, Real dt)
 		{
@@ -72,7 +79,7 @@ namespace SPH
 			Real sigma = W0_;
 			const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-				sigma += inner_neighborhood.W_ij_[n];
+				sigma += inner_neighbor_fields_.W(inner_neighborhood, index_i, n);
 
 			rho_sum_[index_i] = sigma * rho0_ * inv_sigma0_;
 		}
@@ -100,7 +107,11 @@ namespace SPH
 			  vel_n_(particles_->vel_n_),
 			  dvel_dt_prior_(particles_->dvel_dt_prior_),
 			  mu_(material_->ReferenceViscosity()),
-			  smoothing_length_(sph_adaptation_->ReferenceSmoothingLength()) {}
+			  smoothing_length_(sph_adaptation_->ReferenceSmoothingLength()),
+			  inner_neighbor_fields_(inner_relation)
+		{
+			readPairFieldsThroughAccessor();
+		}
 		//=================================================================================================//
 		void ViscousAccelerationInner::Interaction(size_t index_i, Real dt)
 		{
@@ -114,8 +125,10 @@ namespace SPH
 				size_t index_j = inner_neighborhood.j_[n];
 
 				//viscous force
-				vel_derivative = (vel_i - vel_n_[index_j]) / (inner_neighborhood.r_ij_[n] + 0.01 * smoothing_length_);
-				acceleration += 2.0 * mu_ * vel_derivative * Vol_[index_j] * inner_neighborhood.dW_ij_[n] / rho_i;
+				vel_derivative = (vel_i - vel_n_[index_j]) /
+								 (inner_neighbor_fields_.r(inner_neighborhood, index_i, n) + 0.01 * smoothing_length_);
+				acceleration += 2.0 * mu_ * vel_derivative * Vol_[index_j] *
+								inner_neighbor_fields_.dW(inner_neighborhood, index_i, n) / rho_i;
 			}
 
 			dvel_dt_prior_[index_i] += acceleration;
@@ -131,14 +144,14 @@ namespace SPH
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
-				Vecd &e_ij = inner_neighborhood.e_ij_[n];
-				Real r_ij = inner_neighborhood.r_ij_[n];
+				Vecd e_ij = inner_neighbor_fields_.e(inner_neighborhood, index_i, n);
+				Real r_ij = inner_neighbor_fields_.r(inner_neighborhood, index_i, n);
 
 				/** The following viscous force is given in Monaghan 2005 (Rep. Prog. Phys.), it seems that 
 				 * this formulation is more accurate than the previous one for Taylor-Green-Vortex flow. */
 				Real v_r_ij = dot(vel_i - vel_n_[index_j], r_ij * e_ij);
 				Real eta_ij = 8.0 * mu_ * v_r_ij / (r_ij * r_ij + 0.01 * smoothing_length_);
-				acceleration += eta_ij * Vol_[index_j] / rho_i * inner_neighborhood.dW_ij_[n] * e_ij;
+				acceleration += eta_ij * Vol_[index_j] / rho_i * inner_neighbor_fields_.dW(inner_neighborhood, index_i, n) * e_ij;
 			}
 
 			dvel_dt_prior_[index_i] += acceleration;
@@ -150,7 +163,11 @@ namespace SPH
 			  FluidDataInner(inner_relation),
 			  Vol_(particles_->Vol_), rho_n_(particles_->rho_n_),
 			  pos_n_(particles_->pos_n_),
-			  surface_indicator_(particles_->surface_indicator_), p_background_(0) {}
+			  surface_indicator_(particles_->surface_indicator_), p_background_(0),
+			  inner_neighbor_fields_(inner_relation)
+		{
+			readPairFieldsThroughAccessor();
+		}
 		//=================================================================================================//
 		void TransportVelocityCorrectionInner::setupDynamics(Real dt)
 		{
@@ -168,7 +185,8 @@ namespace SPH
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
-				Vecd nablaW_ij = inner_neighborhood.dW_ij_[n] * inner_neighborhood.e_ij_[n];
+				Vecd nablaW_ij = inner_neighbor_fields_.dW(inner_neighborhood, index_i, n) *
+								inner_neighbor_fields_.e(inner_neighborhood, index_i, n);
 
 				//acceleration for transport velocity
 				acceleration_trans -= 2.0 * p_background_ * Vol_[index_j] * nablaW_ij / rho_i;
@@ -200,6 +218,31 @@ namespace SPH
 			return 0.6 * smoothing_length_ / (reduced_value + TinyReal);
 		}
 		//=================================================================================================//
+		LocalAcousticTimeStepSize::
+			LocalAcousticTimeStepSize(FluidBody &fluid_body, LocalTimeStepLevels &time_step_levels)
+			: ParticleDynamicsReduce<Real, ReduceMin>(fluid_body),
+			  FluidDataSimple(fluid_body), time_step_levels_(time_step_levels),
+			  rho_n_(particles_->rho_n_), p_(particles_->p_), local_dt_(time_step_levels.local_dt_),
+			  vel_n_(particles_->vel_n_),
+			  smoothing_length_(sph_adaptation_->ReferenceSmoothingLength())
+		{
+			initial_reference_ = Infinity;
+		}
+		//=================================================================================================//
+		Real LocalAcousticTimeStepSize::ReduceFunction(size_t index_i, Real dt)
+		{
+			Real signal_speed = material_->getSoundSpeed(p_[index_i], rho_n_[index_i]) + vel_n_[index_i].norm();
+			Real smoothing_length = smoothing_length_ / sph_adaptation_->SmoothingLengthRatio(index_i);
+			local_dt_[index_i] = 0.6 * smoothing_length / (signal_speed + TinyReal);
+			return local_dt_[index_i];
+		}
+		//=================================================================================================//
+		Real LocalAcousticTimeStepSize::OutputResult(Real reduced_value)
+		{
+			time_step_levels_.updateLevels(reduced_value);
+			return time_step_levels_.CoarsestTimeStepSize();
+		}
+		//=================================================================================================//
 		AdvectionTimeStepSize::AdvectionTimeStepSize(FluidBody &fluid_body, Real U_max)
 			: ParticleDynamicsReduce<Real, ReduceMax>(fluid_body),
 			  FluidDataSimple(fluid_body), vel_n_(particles_->vel_n_),
@@ -266,7 +309,11 @@ namespace SPH
 			  p_(particles_->p_), drho_dt_(particles_->drho_dt_),
 			  pos_n_(particles_->pos_n_), vel_n_(particles_->vel_n_),
 			  dvel_dt_(particles_->dvel_dt_),
-			  dvel_dt_prior_(particles_->dvel_dt_prior_) {}
+			  dvel_dt_prior_(particles_->dvel_dt_prior_),
+			  inner_neighbor_fields_(inner_relation)
+		{
+			readPairFieldsThroughAccessor();
+		}
 		//=================================================================================================//
 		BasePressureRelaxation::
 			BasePressureRelaxation(BaseBodyRelationInner &inner_relation) : BaseRelaxation(inner_relation) {}
@@ -293,8 +340,8 @@ namespace SPH
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
-				Real dW_ij = inner_neighborhood.dW_ij_[n];
-				const Vecd &e_ij = inner_neighborhood.e_ij_[n];
+				Real dW_ij = inner_neighbor_fields_.dW(inner_neighborhood, index_i, n);
+				Vecd e_ij = inner_neighbor_fields_.e(inner_neighborhood, index_i, n);
 
 				Real rho_j = rho_n_[index_j];
 				Real p_j = p_[index_j];
@@ -325,7 +372,7 @@ namespace SPH
 
 			if (surface_indicator_[index_i] == 1)
 			{
-				Real run_time_ = GlobalStaticVariables::physical_time_;
+				Real run_time_ = PhysicalTime();
 				Real u_ave_ = run_time_ < t_ref_ ? 0.5 * u_ref_ * (1.0 - cos(Pi * run_time_ / t_ref_)) : u_ref_;
 				vel_n_[index_i][0] = u_ave_ + SMIN(rho_sum[index_i], rho_ref_) * (vel_n_[index_i][0] - u_ave_) / rho_ref_;
 			}
@@ -356,7 +403,8 @@ namespace SPH
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
-				Vecd nablaW_ij = inner_neighborhood.dW_ij_[n] * inner_neighborhood.e_ij_[n];
+				Vecd nablaW_ij = inner_neighbor_fields_.dW(inner_neighborhood, index_i, n) *
+								inner_neighbor_fields_.e(inner_neighborhood, index_i, n);
 
 				//elastic force
 				acceleration += (tau_i + tau_[index_j]) * nablaW_ij * Vol_[index_j] / rho_i;
@@ -388,7 +436,8 @@ namespace SPH
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
-				Vecd nablaW_ij = inner_neighborhood.dW_ij_[n] * inner_neighborhood.e_ij_[n];
+				Vecd nablaW_ij = inner_neighbor_fields_.dW(inner_neighborhood, index_i, n) *
+								inner_neighbor_fields_.e(inner_neighborhood, index_i, n);
 
 				Matd velocity_gradient = -SimTK::outer((vel_i - vel_n_[index_j]), nablaW_ij) * Vol_[index_j];
 				stress_rate += ~velocity_gradient * tau_i + tau_i * velocity_gradient - tau_i / lambda_ +
@@ -520,7 +569,7 @@ namespace SPH
 														size_t body_buffer_width, int axis_direction, bool positive)
 			: PartSimpleDynamicsByParticle(fluid_body, body_part), FluidDataSimple(fluid_body),
 			  pos_n_(particles_->pos_n_), rho_n_(particles_->rho_n_), p_(particles_->p_),
-			  axis_(axis_direction), periodic_translation_(0), body_buffer_width_(body_buffer_width),
+			  axis_(axis_direction), positive_(positive), periodic_translation_(0), body_buffer_width_(body_buffer_width),
 			  body_part_bounds_(body_part.body_part_shape_.findBounds())
 		{
 			periodic_translation_[axis_] = body_part_bounds_.second[axis_] - body_part_bounds_.first[axis_];
@@ -576,6 +625,49 @@ namespace SPH
 			}
 		}
 		//=================================================================================================//
+		void EmitterInflowInjecting::parallel_exec(Real dt)
+		{
+			setBodyUpdated();
+			setupDynamics(dt);
+			parallel_for(
+				blocked_range<size_t>(0, body_part_particles_.size()),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i < r.end(); ++i)
+					{
+						size_t sorted_index_i = sorted_id_[body_part_particles_[i]];
+						Real position = pos_n_[sorted_index_i][axis_];
+						if (positive_ ? position > body_part_bounds_.second[axis_]
+									  : position < body_part_bounds_.first[axis_])
+							particles_->requestToSpawnParticle(sorted_index_i);
+					}
+				},
+				ap);
+
+			const IndexVector &injected_particles = particles_->spawnRequestedParticles();
+			parallel_for(
+				blocked_range<size_t>(0, injected_particles.size()),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i < r.end(); ++i)
+					{
+						size_t sorted_index_i = injected_particles[i];
+						if (positive_)
+						{
+							/** Periodic bounding. */
+							pos_n_[sorted_index_i][axis_] -= periodic_translation_[axis_];
+							rho_n_[sorted_index_i] = material_->ReferenceDensity();
+							p_[sorted_index_i] = material_->getPressure(rho_n_[sorted_index_i]);
+						}
+						else
+						{
+							pos_n_[sorted_index_i][axis_] += periodic_translation_[axis_];
+						}
+					}
+				},
+				ap);
+		}
+		//=================================================================================================//
 		ColorFunctionGradientInner::ColorFunctionGradientInner(BaseBodyRelationInner &inner_relation)
 			: InteractionDynamics(*inner_relation.sph_body_), FluidDataInner(inner_relation),
 			  Vol_(particles_->Vol_),
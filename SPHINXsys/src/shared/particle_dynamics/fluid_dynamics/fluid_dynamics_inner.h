@@ -78,6 +78,7 @@ namespace SPH
 			StdLargeVec<int> &surface_indicator_;
 			StdLargeVec<Real> pos_div_;
 			Real smoothing_length_;
+			NeighborFieldAccessor inner_neighbor_fields_;
 
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 			virtual void Update(size_t index_i, Real dt = 0.0) override;
@@ -119,6 +120,7 @@ namespace SPH
 		protected:
 			Real W0_, rho0_, inv_sigma0_;
 			StdLargeVec<Real> &Vol_, &rho_n_, &mass_, &rho_sum_;
+			NeighborFieldAccessor inner_neighbor_fields_;
 
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 			virtual void Update(size_t index_i, Real dt = 0.0) override;
@@ -176,6 +178,7 @@ namespace SPH
 			Real smoothing_length_;
 			StdLargeVec<Real> &Vol_, &rho_n_, &p_;
 			StdLargeVec<Vecd> &vel_n_, &dvel_dt_prior_;
+			NeighborFieldAccessor inner_neighbor_fields_;
 
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 		};
@@ -211,6 +214,7 @@ namespace SPH
 			StdLargeVec<Vecd> &pos_n_;
 			StdLargeVec<int> &surface_indicator_;
 			Real p_background_;
+			NeighborFieldAccessor inner_neighbor_fields_;
 
 			virtual void setupDynamics(Real dt = 0.0) override;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
@@ -234,6 +238,28 @@ namespace SPH
 			Real OutputResult(Real reduced_value) override;
 		};
 
+		/**
+		* @class LocalAcousticTimeStepSize
+		* @brief Computing the individual acoustic time step sizes of particles
+		* from their own smoothing lengths and signal speeds,
+		* and binning the particles into local time-step levels.
+		* The returned value is the coarsest time step size.
+		*/
+		class LocalAcousticTimeStepSize : public ParticleDynamicsReduce<Real, ReduceMin>, public FluidDataSimple
+		{
+		public:
+			LocalAcousticTimeStepSize(FluidBody &fluid_body, LocalTimeStepLevels &time_step_levels);
+			virtual ~LocalAcousticTimeStepSize(){};
+
+		protected:
+			LocalTimeStepLevels &time_step_levels_;
+			StdLargeVec<Real> &rho_n_, &p_, &local_dt_;
+			StdLargeVec<Vecd> &vel_n_;
+			Real smoothing_length_;
+			Real ReduceFunction(size_t index_i, Real dt = 0.0) override;
+			Real OutputResult(Real reduced_value) override;
+		};
+
 		/**
 		* @class AdvectionTimeStepSize
 		* @brief Computing the advection time step size
@@ -292,6 +318,7 @@ namespace SPH
 		protected:
 			StdLargeVec<Real> &Vol_, &mass_, &rho_n_, &p_, &drho_dt_;
 			StdLargeVec<Vecd> &pos_n_, &vel_n_, &dvel_dt_, &dvel_dt_prior_;
+			NeighborFieldAccessor inner_neighbor_fields_;
 		};
 
 		/**
@@ -322,9 +349,26 @@ namespace SPH
 			explicit BasePressureRelaxationInner(BaseBodyRelationInner &inner_relation);
 			virtual ~BasePressureRelaxationInner(){};
 			RiemannSolverType riemann_solver_;
+			/** switch on the batched neighbor loop, which gives identical results, off by default */
+			void useBatchedNeighborLoop(bool use_batches) { use_batches_ = use_batches; };
+			/** register the pair impulses across the interfaces of time-step levels for the momentum correction */
+			void useLevelInterfaceRegister(LevelInterfaceMomentumRegister &interface_register)
+			{
+				interface_register_ = &interface_register;
+			};
 
 		protected:
+			bool use_batches_;
+			LevelInterfaceMomentumRegister *interface_register_;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			bool isRegisteredParticle(size_t index_i)
+			{
+				return interface_register_ != nullptr && interface_register_->isInterfaceParticle(index_i);
+			};
+			void scalarInteraction(size_t index_i, Real dt);
+			/** neighbors in batches of riemann_batch_size for Riemann solvers with batched interfaces */
+			void batchedInteraction(size_t index_i, Real dt, std::true_type);
+			void batchedInteraction(size_t index_i, Real dt, std::false_type) { scalarInteraction(index_i, dt); };
 		};
 		using PressureRelaxationInner = BasePressureRelaxationInner<NoRiemannSolver>;
 		/** define the mostly used pressure relaxation scheme using Riemann solver */
@@ -382,9 +426,16 @@ namespace SPH
 			explicit BaseDensityRelaxationInner(BaseBodyRelationInner &inner_relation);
 			virtual ~BaseDensityRelaxationInner(){};
 			RiemannSolverType riemann_solver_;
+			/** switch on the batched neighbor loop, which gives identical results, off by default */
+			void useBatchedNeighborLoop(bool use_batches) { use_batches_ = use_batches; };
 
 		protected:
+			bool use_batches_;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			void scalarInteraction(size_t index_i, Real dt);
+			/** neighbors in batches of riemann_batch_size for Riemann solvers with batched interfaces */
+			void batchedInteraction(size_t index_i, Real dt, std::true_type);
+			void batchedInteraction(size_t index_i, Real dt, std::false_type) { scalarInteraction(index_i, dt); };
 		};
 		using DensityRelaxationInner = BaseDensityRelaxationInner<NoRiemannSolver>;
 		/** define the mostly used density relaxation scheme using Riemann solver */
@@ -614,13 +665,15 @@ namespace SPH
 											size_t body_buffer_width, int axis_direction, bool positive);
 			virtual ~EmitterInflowInjecting(){};
 
-			/** This class is only implemented in sequential due to memory conflicts. */
-			virtual void parallel_exec(Real dt = 0.0) override { exec(); };
+			/** The injections are requested concurrently and
+			 * then realized together in a range of buffer particles. */
+			virtual void parallel_exec(Real dt = 0.0) override;
 
 		protected:
 			StdLargeVec<Vecd> &pos_n_;
 			StdLargeVec<Real> &rho_n_, &p_;
 			const int axis_; /**< the axis direction for bounding*/
+			bool positive_;
 			Vecd periodic_translation_;
 			size_t body_buffer_width_;
 			BoundingBox body_part_bounds_;
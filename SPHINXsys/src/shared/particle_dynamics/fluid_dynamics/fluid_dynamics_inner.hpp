@@ -71,35 +71,93 @@ namespace SPH
 		BasePressureRelaxationInner<RiemannSolverType>::
             BasePressureRelaxationInner(BaseBodyRelationInner &inner_relation) :
 				BasePressureRelaxation(inner_relation), 
-				riemann_solver_(*material_, *material_) {}		
+				riemann_solver_(*material_, *material_), use_batches_(false), interface_register_(nullptr) {}
         //=================================================================================================//
 		template<class RiemannSolverType>
     	void BasePressureRelaxationInner<RiemannSolverType>::Interaction(size_t index_i, Real dt)
+		{
+			if (use_batches_)
+				batchedInteraction(index_i, dt, IsBatchedRiemannSolver<RiemannSolverType>());
+			else
+				scalarInteraction(index_i, dt);
+		}
+        //=================================================================================================//
+		template<class RiemannSolverType>
+    	void BasePressureRelaxationInner<RiemannSolverType>::scalarInteraction(size_t index_i, Real dt)
 		{
 			FluidState state_i(rho_n_[index_i], vel_n_[index_i], p_[index_i]);
 			Vecd acceleration = dvel_dt_prior_[index_i];
+			bool is_registered_particle = isRegisteredParticle(index_i);
 			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
-				Real dW_ij = inner_neighborhood.dW_ij_[n];
-				Vecd& e_ij = inner_neighborhood.e_ij_[n];
+				Real dW_ij = inner_neighbor_fields_.dW(inner_neighborhood, index_i, n);
+				Vecd e_ij = inner_neighbor_fields_.e(inner_neighborhood, index_i, n);
 
 				FluidState state_j(rho_n_[index_j], vel_n_[index_j], p_[index_j]);
 				Real p_star = riemann_solver_.getPStar(state_i, state_j, e_ij);
-				acceleration -= 2.0 * p_star * Vol_[index_j] * dW_ij * e_ij / state_i.rho_;
+				Vecd pair_acceleration = -2.0 * p_star * Vol_[index_j] * dW_ij * e_ij / state_i.rho_;
+				acceleration += pair_acceleration;
+				if (is_registered_particle && interface_register_->isAcrossLevels(index_i, index_j))
+					interface_register_->registerPairImpulse(index_i, n, mass_[index_i] * pair_acceleration * dt);
+			}
+			dvel_dt_[index_i] = acceleration;
+		}
+        //=================================================================================================//
+		template<class RiemannSolverType>
+    	void BasePressureRelaxationInner<RiemannSolverType>::
+			batchedInteraction(size_t index_i, Real dt, std::true_type)
+		{
+			FluidState state_i(rho_n_[index_i], vel_n_[index_i], p_[index_i]);
+			Vecd acceleration = dvel_dt_prior_[index_i];
+			bool is_registered_particle = isRegisteredParticle(index_i);
+			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			FluidStateBatch batch;
+			Real dW_ij[riemann_batch_size], Vol_j[riemann_batch_size], p_star[riemann_batch_size];
+			for (size_t n0 = 0; n0 < inner_neighborhood.current_size_; n0 += riemann_batch_size)
+			{
+				batch.size_ = int(SMIN(size_t(riemann_batch_size), inner_neighborhood.current_size_ - n0));
+				for (int l = 0; l != batch.size_; ++l)
+				{
+					size_t index_j = inner_neighborhood.j_[n0 + l];
+					dW_ij[l] = inner_neighbor_fields_.dW(inner_neighborhood, index_i, n0 + l);
+					batch.e_ij_[l] = inner_neighbor_fields_.e(inner_neighborhood, index_i, n0 + l);
+					batch.rho_[l] = rho_n_[index_j];
+					batch.vel_[l] = vel_n_[index_j];
+					batch.p_[l] = p_[index_j];
+					Vol_j[l] = Vol_[index_j];
+				}
+
+				riemann_solver_.getPStars(state_i, batch, p_star);
+				for (int l = 0; l != batch.size_; ++l)
+				{
+					Vecd pair_acceleration = -2.0 * p_star[l] * Vol_j[l] * dW_ij[l] * batch.e_ij_[l] / state_i.rho_;
+					acceleration += pair_acceleration;
+					if (is_registered_particle && interface_register_->isAcrossLevels(index_i, inner_neighborhood.j_[n0 + l]))
+						interface_register_->registerPairImpulse(index_i, n0 + l, mass_[index_i] * pair_acceleration * dt);
+				}
 			}
 			dvel_dt_[index_i] = acceleration;
-		}    
+		}
         //=================================================================================================//
 		template<class RiemannSolverType>
 		BaseDensityRelaxationInner<RiemannSolverType>::
             BaseDensityRelaxationInner(BaseBodyRelationInner &inner_relation) :
 				BaseDensityRelaxation(inner_relation),
-				riemann_solver_(*material_, *material_) {}
+				riemann_solver_(*material_, *material_), use_batches_(false) {}
          //=================================================================================================//
  		template<class RiemannSolverType>
         void BaseDensityRelaxationInner<RiemannSolverType>::Interaction(size_t index_i, Real dt)
+		{
+			if (use_batches_)
+				batchedInteraction(index_i, dt, IsBatchedRiemannSolver<RiemannSolverType>());
+			else
+				scalarInteraction(index_i, dt);
+		}
+         //=================================================================================================//
+ 		template<class RiemannSolverType>
+        void BaseDensityRelaxationInner<RiemannSolverType>::scalarInteraction(size_t index_i, Real dt)
 		{
 			FluidState state_i(rho_n_[index_i], vel_n_[index_i], p_[index_i]);
 			Real density_change_rate = 0.0;
@@ -107,15 +165,46 @@ namespace SPH
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
-				Vecd& e_ij = inner_neighborhood.e_ij_[n];
-				Real dW_ij = inner_neighborhood.dW_ij_[n];
+				Vecd e_ij = inner_neighbor_fields_.e(inner_neighborhood, index_i, n);
+				Real dW_ij = inner_neighbor_fields_.dW(inner_neighborhood, index_i, n);
 
 				FluidState state_j(rho_n_[index_j], vel_n_[index_j], p_[index_j]);
 				Vecd vel_star = riemann_solver_.getVStar(state_i, state_j, e_ij);
 				density_change_rate += 2.0 * state_i.rho_ * Vol_[index_j] * dot(state_i.vel_ - vel_star, e_ij) * dW_ij;
 			}
 			drho_dt_[index_i] = density_change_rate;
-		};   
+		}
+         //=================================================================================================//
+ 		template<class RiemannSolverType>
+        void BaseDensityRelaxationInner<RiemannSolverType>::
+			batchedInteraction(size_t index_i, Real dt, std::true_type)
+		{
+			FluidState state_i(rho_n_[index_i], vel_n_[index_i], p_[index_i]);
+			Real density_change_rate = 0.0;
+			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			FluidStateBatch batch;
+			Real dW_ij[riemann_batch_size], Vol_j[riemann_batch_size];
+			Vecd vel_star[riemann_batch_size];
+			for (size_t n0 = 0; n0 < inner_neighborhood.current_size_; n0 += riemann_batch_size)
+			{
+				batch.size_ = int(SMIN(size_t(riemann_batch_size), inner_neighborhood.current_size_ - n0));
+				for (int l = 0; l != batch.size_; ++l)
+				{
+					size_t index_j = inner_neighborhood.j_[n0 + l];
+					batch.e_ij_[l] = inner_neighbor_fields_.e(inner_neighborhood, index_i, n0 + l);
+					dW_ij[l] = inner_neighbor_fields_.dW(inner_neighborhood, index_i, n0 + l);
+					batch.rho_[l] = rho_n_[index_j];
+					batch.vel_[l] = vel_n_[index_j];
+					batch.p_[l] = p_[index_j];
+					Vol_j[l] = Vol_[index_j];
+				}
+
+				riemann_solver_.getVStars(state_i, batch, vel_star);
+				for (int l = 0; l != batch.size_; ++l)
+					density_change_rate += 2.0 * state_i.rho_ * Vol_j[l] * dot(state_i.vel_ - vel_star[l], batch.e_ij_[l]) * dW_ij[l];
+			}
+			drho_dt_[index_i] = density_change_rate;
+		}
         //=================================================================================================//
     }
 //=================================================================================================//
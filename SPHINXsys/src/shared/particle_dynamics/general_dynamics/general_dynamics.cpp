@@ -37,7 +37,7 @@ namespace SPH
 		Vecd &pos_n_i = pos_n_[index_i];
 		for (int k = 0; k < pos_n_i.size(); ++k)
 		{
-			pos_n_i[k] += dt * (((double)rand() / (RAND_MAX)) - 0.5) * 2.0 * randomize_scale_;
+			pos_n_i[k] += dt * (UniformRandom(unsorted_id_[index_i], k) - 0.5) * 2.0 * randomize_scale_;
 		}
 	}
 	//=================================================================================================//
@@ -51,6 +51,18 @@ namespace SPH
 		cut_off_radius_max_ = sph_adaptation_->getKernel()->CutOffRadius(h_ratio_min);
 	}
 	//=================================================================================================//
+	bool BoundingInAxisDirection::isInLowerBoundLayer(const Vecd &position)
+	{
+		return position[axis_] > body_domain_bounds_.first[axis_] &&
+			   position[axis_] < (body_domain_bounds_.first[axis_] + cut_off_radius_max_);
+	}
+	//=================================================================================================//
+	bool BoundingInAxisDirection::isInUpperBoundLayer(const Vecd &position)
+	{
+		return position[axis_] < body_domain_bounds_.second[axis_] &&
+			   position[axis_] > (body_domain_bounds_.second[axis_] - cut_off_radius_max_);
+	}
+	//=================================================================================================//
 	void PeriodicConditionInAxisDirection::
 		setPeriodicTranslation(BoundingBox &body_domain_bounds, int axis_direction)
 	{
@@ -72,6 +84,15 @@ namespace SPH
 			std::cout << "\n Periodic bounding failure: bounds not defined!" << std::endl;
 			exit(1);
 		}
+		/** the neighbor candidates searched with a skin do not follow the periodic images */
+		if (real_body.use_verlet_skin_)
+		{
+			std::cout << "\n Error: periodic condition is not supported for a body whose relations use Verlet skin!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		real_body.is_periodic_ = true;
+		real_body.periodic_translation_[axis_direction] = periodic_translation_[axis_direction];
 	}
 	//=================================================================================================//
 	void PeriodicConditionInAxisDirection::PeriodicBounding::checkLowerBound(size_t index_i, Real dt)
@@ -242,6 +263,37 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	bool OpenBoundaryConditionInAxisDirection::ParticleTypeTransfer::isOutOfBound(size_t index_i)
+	{
+		return positive_ ? pos_n_[index_i][axis_] > body_domain_bounds_.second[axis_]
+						 : pos_n_[index_i][axis_] < body_domain_bounds_.first[axis_];
+	}
+	//=================================================================================================//
+	void OpenBoundaryConditionInAxisDirection::ParticleTypeTransfer::parallel_exec(Real dt)
+	{
+		setupDynamics(dt);
+
+		for (size_t k = 0; k != bound_cells_.size(); ++k)
+		{
+			CellLists &cells = bound_cells_[k];
+			parallel_for(
+				blocked_range<size_t>(0, cells.size()),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i < r.end(); ++i)
+					{
+						IndexVector &particle_indexes = cells[i]->real_particle_indexes_;
+						for (size_t num = 0; num < particle_indexes.size(); ++num)
+							if (isOutOfBound(particle_indexes[num]))
+								particles_->requestToDeleteParticle(particle_indexes[num]);
+					}
+				},
+				ap);
+		}
+
+		particles_->deleteRequestedParticles();
+	}
+	//=================================================================================================//
 	void PeriodicConditionInAxisDirectionUsingGhostParticles::
 		CreatPeriodicGhostParticles::setupDynamics(Real dt)
 	{
@@ -253,8 +305,7 @@ namespace SPH
 		CreatPeriodicGhostParticles::checkLowerBound(size_t index_i, Real dt)
 	{
 		Vecd particle_position = pos_n_[index_i];
-		if (particle_position[axis_] > body_domain_bounds_.first[axis_] &&
-			particle_position[axis_] < (body_domain_bounds_.first[axis_] + cut_off_radius_max_))
+		if (isInLowerBoundLayer(particle_position))
 		{
 			size_t expected_particle_index = particles_->insertAGhostParticle(index_i);
 			ghost_particles_[0].push_back(expected_particle_index);
@@ -268,8 +319,7 @@ namespace SPH
 		CreatPeriodicGhostParticles::checkUpperBound(size_t index_i, Real dt)
 	{
 		Vecd particle_position = pos_n_[index_i];
-		if (particle_position[axis_] < body_domain_bounds_.second[axis_] &&
-			particle_position[axis_] > (body_domain_bounds_.second[axis_] - cut_off_radius_max_))
+		if (isInUpperBoundLayer(particle_position))
 		{
 			size_t expected_particle_index = particles_->insertAGhostParticle(index_i);
 			ghost_particles_[1].push_back(expected_particle_index);
@@ -279,6 +329,87 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	bool PeriodicConditionInAxisDirectionUsingGhostParticles::
+		CreatPeriodicGhostParticles::isGhostCandidate(size_t bound_side, size_t index_i)
+	{
+		return bound_side == 0 ? isInLowerBoundLayer(pos_n_[index_i]) : isInUpperBoundLayer(pos_n_[index_i]);
+	}
+	//=================================================================================================//
+	void PeriodicConditionInAxisDirectionUsingGhostParticles::
+		CreatPeriodicGhostParticles::parallel_exec(Real dt)
+	{
+		setupDynamics(dt);
+
+		/** count the ghosts from each bounding cell and sum them up to ghost offsets */
+		size_t total_ghosts = 0;
+		for (size_t k = 0; k != bound_cells_.size(); ++k)
+		{
+			CellLists &cells = bound_cells_[k];
+			IndexVector &offsets = ghost_offsets_[k];
+			offsets.resize(cells.size() + 1);
+			offsets[0] = 0;
+			parallel_for(
+				blocked_range<size_t>(0, cells.size()),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i < r.end(); ++i)
+					{
+						size_t count = 0;
+						IndexVector &particle_indexes = cells[i]->real_particle_indexes_;
+						for (size_t num = 0; num < particle_indexes.size(); ++num)
+							if (isGhostCandidate(k, particle_indexes[num]))
+								++count;
+						offsets[i + 1] = count;
+					}
+				},
+				ap);
+			for (size_t i = 0; i != cells.size(); ++i)
+				offsets[i + 1] += offsets[i];
+			ghost_particles_[k].resize(offsets.back());
+			total_ghosts += offsets.back();
+		}
+
+		/** reserve all ghosts at once and copy particle data into the reserved slots */
+		size_t ghost_start = particles_->reserveGhostParticles(total_ghosts);
+		for (size_t k = 0; k != bound_cells_.size(); ++k)
+		{
+			CellLists &cells = bound_cells_[k];
+			IndexVector &offsets = ghost_offsets_[k];
+			IndexVector &ghosts = ghost_particles_[k];
+			parallel_for(
+				blocked_range<size_t>(0, cells.size()),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i < r.end(); ++i)
+					{
+						size_t ghost_index = offsets[i];
+						IndexVector &particle_indexes = cells[i]->real_particle_indexes_;
+						for (size_t num = 0; num < particle_indexes.size(); ++num)
+						{
+							size_t index_i = particle_indexes[num];
+							if (isGhostCandidate(k, index_i))
+							{
+								ghosts[ghost_index] = ghost_start + ghost_index;
+								particles_->copyToAGhostParticle(ghosts[ghost_index], index_i);
+								++ghost_index;
+							}
+						}
+					}
+				},
+				ap);
+			ghost_start += ghosts.size();
+		}
+
+		/** insert ghost particles to cell linked list, which is not thread safe */
+		Vecd translation[2] = {periodic_translation_, -periodic_translation_};
+		for (size_t k = 0; k != ghost_particles_.size(); ++k)
+			for (size_t i = 0; i != ghost_particles_[k].size(); ++i)
+			{
+				size_t ghost_index = ghost_particles_[k][i];
+				cell_linked_list_->InsertACellLinkedListDataEntry(ghost_index, pos_n_[ghost_index] + translation[k]);
+			}
+	}
+	//=================================================================================================//
 	void PeriodicConditionInAxisDirectionUsingGhostParticles::
 		UpdatePeriodicGhostParticles::checkLowerBound(size_t index_i, Real dt)
 	{
@@ -345,7 +476,8 @@ namespace SPH
 	MirrorBoundaryConditionInAxisDirection::CreatingGhostParticles::
 		CreatingGhostParticles(IndexVector &ghost_particles,
 							   CellLists &bound_cells, RealBody &real_body, int axis_direction, bool positive)
-		: MirrorBounding(bound_cells, real_body, axis_direction, positive), ghost_particles_(ghost_particles) {}
+		: MirrorBounding(bound_cells, real_body, axis_direction, positive),
+		  ghost_particles_(ghost_particles), positive_(positive) {}
 	//=================================================================================================//
 	MirrorBoundaryConditionInAxisDirection::UpdatingGhostStates::
 		UpdatingGhostStates(IndexVector &ghost_particles, CellLists &bound_cells,
@@ -411,8 +543,7 @@ namespace SPH
 	void MirrorBoundaryConditionInAxisDirection::CreatingGhostParticles ::checkLowerBound(size_t index_i, Real dt)
 	{
 		Vecd particle_position = pos_n_[index_i];
-		if (particle_position[axis_] > body_domain_bounds_.first[axis_] &&
-			particle_position[axis_] < (body_domain_bounds_.first[axis_] + cut_off_radius_max_))
+		if (isInLowerBoundLayer(particle_position))
 		{
 			size_t expected_particle_index = particles_->insertAGhostParticle(index_i);
 			ghost_particles_.push_back(expected_particle_index);
@@ -427,8 +558,7 @@ namespace SPH
 	void MirrorBoundaryConditionInAxisDirection::CreatingGhostParticles::checkUpperBound(size_t index_i, Real dt)
 	{
 		Vecd particle_position = pos_n_[index_i];
-		if (particle_position[axis_] < body_domain_bounds_.second[axis_] &&
-			particle_position[axis_] > (body_domain_bounds_.second[axis_] - cut_off_radius_max_))
+		if (isInUpperBoundLayer(particle_position))
 		{
 			size_t expected_particle_index = particles_->insertAGhostParticle(index_i);
 			ghost_particles_.push_back(expected_particle_index);
@@ -440,6 +570,72 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	bool MirrorBoundaryConditionInAxisDirection::CreatingGhostParticles::isGhostCandidate(size_t index_i)
+	{
+		return positive_ ? isInUpperBoundLayer(pos_n_[index_i]) : isInLowerBoundLayer(pos_n_[index_i]);
+	}
+	//=================================================================================================//
+	void MirrorBoundaryConditionInAxisDirection::CreatingGhostParticles::parallel_exec(Real dt)
+	{
+		setupDynamics(dt);
+
+		/** count the ghosts from each bounding cell and sum them up to ghost offsets */
+		ghost_offsets_.resize(bound_cells_.size() + 1);
+		ghost_offsets_[0] = 0;
+		parallel_for(
+			blocked_range<size_t>(0, bound_cells_.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i < r.end(); ++i)
+				{
+					size_t count = 0;
+					ListDataVector &list_data = bound_cells_[i]->cell_list_data_;
+					for (size_t num = 0; num < list_data.size(); ++num)
+						if (isGhostCandidate(list_data[num].first))
+							++count;
+					ghost_offsets_[i + 1] = count;
+				}
+			},
+			ap);
+		for (size_t i = 0; i != bound_cells_.size(); ++i)
+			ghost_offsets_[i + 1] += ghost_offsets_[i];
+		ghost_particles_.resize(ghost_offsets_.back());
+
+		/** reserve all ghosts at once, then copy and mirror them in the reserved slots */
+		size_t ghost_start = particles_->reserveGhostParticles(ghost_particles_.size());
+		Vecd &body_bound = positive_ ? body_domain_bounds_.second : body_domain_bounds_.first;
+		parallel_for(
+			blocked_range<size_t>(0, bound_cells_.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i < r.end(); ++i)
+				{
+					size_t ghost_index = ghost_offsets_[i];
+					ListDataVector &list_data = bound_cells_[i]->cell_list_data_;
+					for (size_t num = 0; num < list_data.size(); ++num)
+					{
+						size_t index_i = list_data[num].first;
+						if (isGhostCandidate(index_i))
+						{
+							size_t expected_particle_index = ghost_start + ghost_index;
+							ghost_particles_[ghost_index] = expected_particle_index;
+							particles_->copyToAGhostParticle(expected_particle_index, index_i);
+							mirrorInAxisDirection(expected_particle_index, body_bound, axis_);
+							++ghost_index;
+						}
+					}
+				}
+			},
+			ap);
+
+		/** insert ghost particles to cell linked list, which is not thread safe */
+		for (size_t i = 0; i != ghost_particles_.size(); ++i)
+		{
+			size_t ghost_index = ghost_particles_[i];
+			cell_linked_list_->InsertACellLinkedListDataEntry(ghost_index, pos_n_[ghost_index]);
+		}
+	}
+	//=================================================================================================//
 	void MirrorBoundaryConditionInAxisDirection::UpdatingGhostStates::checkLowerBound(size_t index_i, Real dt)
 	{
 		particles_->updateFromAnotherParticle(index_i, sorted_id_[index_i]);
@@ -535,8 +731,8 @@ namespace SPH
 										GeneralDataDelegateSimple(sph_body),
 										pos_n_(particles_->pos_n_)
 	{
-		constexpr double min_real_number = (std::numeric_limits<double>::min)();
-		initial_reference_ = Vecd(min_real_number);
+		constexpr double lowest_real_number = (std::numeric_limits<double>::lowest)();
+		initial_reference_ = Vecd(lowest_real_number);
 	}
 	//=================================================================================================//
 	Vecd BodyUpperBound::ReduceFunction(size_t index_i, Real dt)
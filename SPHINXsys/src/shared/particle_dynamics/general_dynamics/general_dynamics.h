@@ -68,6 +68,8 @@ namespace SPH
 	/**
 	* @class RandomizePartilePosition
 	* @brief Randomize the initial particle position
+	* The random numbers are keyed by the unsorted particle index,
+	* so that the result does not depend on the parallel scheduling.
 	*/
 	class RandomizePartilePosition
 		: public ParticleDynamicsSimple,
@@ -80,6 +82,7 @@ namespace SPH
 	protected:
 		StdLargeVec<Vecd> &pos_n_;
 		Real randomize_scale_;
+		virtual void setupDynamics(Real dt = 0.0) override { advanceRandomStep(); };
 		virtual void Update(size_t index_i, Real dt = 0.0) override;
 	};
 
@@ -96,6 +99,10 @@ namespace SPH
 		StdLargeVec<Vecd> &pos_n_;
 		BaseCellLinkedList *cell_linked_list_;
 		Real cut_off_radius_max_; /**< maximum cut off radius to avoid boundary particle depletion */
+		/** whether a position lies within the cut-off layer inside the lower or upper bound */
+		bool isInLowerBoundLayer(const Vecd &position);
+		bool isInUpperBoundLayer(const Vecd &position);
+
 	public:
 		BoundingInAxisDirection(RealBody &real_body, int axis_direction);
 		virtual ~BoundingInAxisDirection(){};
@@ -222,25 +229,26 @@ namespace SPH
 		{
 		protected:
 			StdVec<CellLists> &bound_cells_;
+			bool positive_;
 			ParticleFunctor checking_bound_;
 			virtual void checkLowerBound(size_t index_i, Real dt = 0.0);
 			virtual void checkUpperBound(size_t index_i, Real dt = 0.0);
+			bool isOutOfBound(size_t index_i);
 
 		public:
 			ParticleTypeTransfer(StdVec<CellLists> &bound_cells, RealBody &real_body, int axis_direction, bool positive)
 				: BoundingInAxisDirection(real_body, axis_direction),
-				  bound_cells_(bound_cells)
+				  bound_cells_(bound_cells), positive_(positive)
 			{
 				checking_bound_ = positive ? std::bind(&OpenBoundaryConditionInAxisDirection::ParticleTypeTransfer::checkUpperBound, this, _1, _2)
 										   : std::bind(&OpenBoundaryConditionInAxisDirection::ParticleTypeTransfer::checkLowerBound, this, _1, _2);
 			};
 			virtual ~ParticleTypeTransfer(){};
 
-			/** This class is only implemented in sequential due to memory conflicts.
-			* Because the cell list data is not concurrent vector.
-			*/
 			virtual void exec(Real dt = 0.0) override;
-			virtual void parallel_exec(Real dt = 0.0) override { exec(); };
+			/** The particles out of bound are requested for deletion concurrently
+			 * and then switched to buffer particles together. */
+			virtual void parallel_exec(Real dt = 0.0) override;
 		};
 
 	public:
@@ -268,26 +276,29 @@ namespace SPH
 		/**
 		 * @class CreatPeriodicGhostParticles
 		 * @brief create ghost particles in an axis direction
+		 * @details The parallel version works in two phases. The ghosts from each bounding cell
+		 * are counted first and a contiguous ghost range is reserved once by a prefix sum.
+		 * Then, particle data are copied concurrently into the reserved slots.
+		 * The ghosts are inserted into the cell linked list afterwards, in the same order as the sequential version.
 		 */
 		class CreatPeriodicGhostParticles : public PeriodicBounding
 		{
 		protected:
 			StdVec<IndexVector> &ghost_particles_;
+			StdVec<IndexVector> ghost_offsets_; /**< start of the ghosts from each bounding cell */
 			virtual void setupDynamics(Real dt = 0.0) override;
 			virtual void checkLowerBound(size_t index_i, Real dt = 0.0) override;
 			virtual void checkUpperBound(size_t index_i, Real dt = 0.0) override;
+			bool isGhostCandidate(size_t bound_side, size_t index_i);
 
 		public:
 			CreatPeriodicGhostParticles(Vecd &periodic_translation, StdVec<CellLists> &bound_cells,
 										StdVec<IndexVector> &ghost_particles, RealBody &real_body, int axis_direction)
 				: PeriodicBounding(periodic_translation, bound_cells, real_body, axis_direction),
-				  ghost_particles_(ghost_particles){};
+				  ghost_particles_(ghost_particles), ghost_offsets_(2){};
 			virtual ~CreatPeriodicGhostParticles(){};
 
-			/** This class is only implemented in sequential due to memory conflicts.
-			 * Because creating ghost particle allocate memory.
-			 */
-			virtual void parallel_exec(Real dt = 0.0) override { exec(); };
+			virtual void parallel_exec(Real dt = 0.0) override;
 		};
 
 		/**
@@ -362,21 +373,25 @@ namespace SPH
 		/**
 		* @class CreatingGhostParticles
 		* @brief ghost particle created according to its corresponding real particle
+		* @details The parallel version counts, reserves and then copies the ghosts,
+		* as CreatPeriodicGhostParticles does.
 		*/
 		class CreatingGhostParticles : public MirrorBounding
 		{
 		protected:
 			IndexVector &ghost_particles_;
+			bool positive_;
+			IndexVector ghost_offsets_; /**< start of the ghosts from each bounding cell */
 			virtual void setupDynamics(Real dt = 0.0) override { ghost_particles_.clear(); };
 			virtual void checkLowerBound(size_t index_i, Real dt = 0.0) override;
 			virtual void checkUpperBound(size_t index_i, Real dt = 0.0) override;
+			bool isGhostCandidate(size_t index_i);
 
 		public:
 			CreatingGhostParticles(IndexVector &ghost_particles, CellLists &bound_cells,
 								   RealBody &real_body, int axis_direction, bool positive);
 			virtual ~CreatingGhostParticles(){};
-			/** This class is only implemented in sequential due to memory conflicts. */
-			virtual void parallel_exec(Real dt = 0.0) override { exec(); };
+			virtual void parallel_exec(Real dt = 0.0) override;
 		};
 
 		/**
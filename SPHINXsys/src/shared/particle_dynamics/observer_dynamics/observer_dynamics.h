@@ -40,6 +40,22 @@ namespace SPH
 									SPHBody, BaseParticles, BaseMaterial>
 			InterpolationContactData;
 
+		/**
+		* @class CorrectInterpolationKernelWeights
+		* @brief  correct kernel weights for interpolation between general bodies
+		*/
+		class CorrectInterpolationKernelWeights : public InteractionDynamics,
+												  public InterpolationContactData
+		{
+		public:
+			explicit CorrectInterpolationKernelWeights(BaseBodyRelationContact &contact_relation);
+			virtual ~CorrectInterpolationKernelWeights(){};
+
+		protected:
+			StdVec<StdLargeVec<Real> *> contact_Vol_;
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+		};
+
 		/**
 		 * @class BaseInterpolation
 		 * @brief Base class for interpolation.
@@ -50,7 +66,8 @@ namespace SPH
 		public:
 			explicit BaseInterpolation(BaseBodyRelationContact &contact_relation, const std::string &variable_name)
 				: InteractionDynamics(*contact_relation.sph_body_), InterpolationContactData(contact_relation),
-				  interpolated_quantities_(nullptr)
+				  interpolated_quantities_(nullptr), contact_relation_(contact_relation),
+				  configuration_on_demand_(false), kernel_weights_correction_(nullptr)
 			{
 				for (size_t k = 0; k != this->contact_particles_.size(); ++k)
 				{
@@ -62,10 +79,39 @@ namespace SPH
 			};
 			virtual ~BaseInterpolation(){};
 
+			/**
+			 * Rebuild the neighborhoods of the observing particles only before interpolating,
+			 * so that the contact relation is not required to be updated every time step.
+			 * Optionally, the kernel weights are corrected to first order after each rebuild.
+			 */
+			void updateConfigurationOnDemand(bool correct_kernel_weights = false)
+			{
+				configuration_on_demand_ = true;
+				if (correct_kernel_weights && kernel_weights_correction_ == nullptr)
+					kernel_weights_correction_ =
+						kernel_weights_correction_ptr_keeper_.createPtr<CorrectInterpolationKernelWeights>(contact_relation_);
+			};
+
+		private:
+			UniquePtrKeeper<CorrectInterpolationKernelWeights> kernel_weights_correction_ptr_keeper_;
+
 		protected:
 			StdLargeVec<VariableType> *interpolated_quantities_;
 			StdVec<StdLargeVec<Real> *> contact_Vol_;
 			StdVec<StdLargeVec<VariableType> *> contact_data_;
+			BaseBodyRelationContact &contact_relation_;
+			bool configuration_on_demand_;
+			CorrectInterpolationKernelWeights *kernel_weights_correction_;
+
+			virtual void setupDynamics(Real dt = 0.0) override
+			{
+				if (configuration_on_demand_)
+				{
+					contact_relation_.updateConfiguration();
+					if (kernel_weights_correction_ != nullptr)
+						kernel_weights_correction_->parallel_exec();
+				}
+			};
 
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override
 			{
@@ -139,22 +185,6 @@ namespace SPH
 				return particles->getVariableByName<DataTypeIndex, VariableType>(variable_name);
 			};
 		};
-
-		/**
-		* @class CorrectInterpolationKernelWeights
-		* @brief  correct kernel weights for interpolation between general bodies
-		*/
-		class CorrectInterpolationKernelWeights : public InteractionDynamics,
-												  public InterpolationContactData
-		{
-		public:
-			explicit CorrectInterpolationKernelWeights(BaseBodyRelationContact &contact_relation);
-			virtual ~CorrectInterpolationKernelWeights(){};
-
-		protected:
-			StdVec<StdLargeVec<Real> *> contact_Vol_;
-			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
-		};
 	}
 }
 #endif //OBSERVER_DYNAMICS_H
\ No newline at end of file
@@ -5,6 +5,8 @@
 */
 
 #include "particle_dynamics_algorithms.h"
+#include "particle_dynamics_local_time_stepping.h"
+#include "particle_dynamics_cache_blocking.h"
 
 //=================================================================================================//
 namespace SPH
@@ -20,10 +22,12 @@ namespace SPH
 	//=================================================================================================//
 	void ParticleDynamicsSimple::parallel_exec(Real dt)
 	{
+		startParallelExecution();
 		setBodyUpdated();
 		setupDynamics(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
-		ParticleIterator_parallel(total_real_particles, functor_update_, dt);
+		ParticleIterator_parallel(total_real_particles, functor_update_, execution_policy_, dt);
+		finishParallelExecution();
 	}
 	//=================================================================================================//
 	void InteractionDynamics::exec(Real dt)
@@ -40,14 +44,16 @@ namespace SPH
 	//=================================================================================================//
 	void InteractionDynamics::parallel_exec(Real dt)
 	{
+		startParallelExecution();
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k)
 			pre_processes_[k]->parallel_exec(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
-		ParticleIterator_parallel(total_real_particles, functor_interaction_, dt);
+		iterateInteraction_parallel(total_real_particles, functor_interaction_, dt);
 		for (size_t k = 0; k < post_processes_.size(); ++k)
 			post_processes_[k]->parallel_exec(dt);
+		finishParallelExecution();
 	}
 	//=================================================================================================//
 	CombinedInteractionDynamics::
@@ -100,15 +106,53 @@ namespace SPH
 	//=================================================================================================//
 	void InteractionDynamicsWithUpdate::parallel_exec(Real dt)
 	{
+		startParallelExecution();
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k)
 			pre_processes_[k]->parallel_exec(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
-		ParticleIterator_parallel(total_real_particles, functor_interaction_, dt);
+		iterateInteraction_parallel(total_real_particles, functor_interaction_, dt);
 		for (size_t k = 0; k < post_processes_.size(); ++k)
 			post_processes_[k]->parallel_exec(dt);
-		ParticleIterator_parallel(total_real_particles, functor_update_, dt);
+		ParticleIterator_parallel(total_real_particles, functor_update_, execution_policy_, dt);
+		finishParallelExecution();
+	}
+	//=================================================================================================//
+	void InteractionDynamicsWithUpdate::exec_by_level(LocalTimeStepLevels &time_step_levels, size_t sub_step)
+	{
+		Real dt_min = time_step_levels.MinimumTimeStepSize();
+		size_t active_levels = time_step_levels.ActiveLevels(sub_step);
+		setBodyUpdated();
+		setupDynamics(dt_min);
+		for (size_t k = 0; k < pre_processes_.size(); ++k)
+			pre_processes_[k]->exec(dt_min);
+		for (size_t l = 0; l != active_levels; ++l)
+			ParticleIteratorByIndexes(time_step_levels.level_particles_[l], functor_interaction_,
+									  time_step_levels.LevelTimeStepSize(l));
+		for (size_t k = 0; k < post_processes_.size(); ++k)
+			post_processes_[k]->exec(dt_min);
+		for (size_t l = 0; l != active_levels; ++l)
+			ParticleIteratorByIndexes(time_step_levels.level_particles_[l], functor_update_,
+									  time_step_levels.LevelTimeStepSize(l));
+	}
+	//=================================================================================================//
+	void InteractionDynamicsWithUpdate::parallel_exec_by_level(LocalTimeStepLevels &time_step_levels, size_t sub_step)
+	{
+		Real dt_min = time_step_levels.MinimumTimeStepSize();
+		size_t active_levels = time_step_levels.ActiveLevels(sub_step);
+		setBodyUpdated();
+		setupDynamics(dt_min);
+		for (size_t k = 0; k < pre_processes_.size(); ++k)
+			pre_processes_[k]->parallel_exec(dt_min);
+		for (size_t l = 0; l != active_levels; ++l)
+			ParticleIteratorByIndexes_parallel(time_step_levels.level_particles_[l], functor_interaction_,
+											   time_step_levels.LevelTimeStepSize(l));
+		for (size_t k = 0; k < post_processes_.size(); ++k)
+			post_processes_[k]->parallel_exec(dt_min);
+		for (size_t l = 0; l != active_levels; ++l)
+			ParticleIteratorByIndexes_parallel(time_step_levels.level_particles_[l], functor_update_,
+											   time_step_levels.LevelTimeStepSize(l));
 	}
 	//=================================================================================================//
 	void ParticleDynamics1Level::exec(Real dt)
@@ -127,16 +171,116 @@ namespace SPH
 	//=================================================================================================//
 	void ParticleDynamics1Level::parallel_exec(Real dt)
 	{
+		startParallelExecution();
 		setBodyUpdated();
 		setupDynamics(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
-		ParticleIterator_parallel(total_real_particles, functor_initialization_, dt);
+		ParticleIterator_parallel(total_real_particles, functor_initialization_, execution_policy_, dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k)
 			pre_processes_[k]->parallel_exec(dt);
-		ParticleIterator_parallel(total_real_particles, functor_interaction_, dt);
+		iterateInteraction_parallel(total_real_particles, functor_interaction_, dt);
 		for (size_t k = 0; k < post_processes_.size(); ++k)
 			post_processes_[k]->parallel_exec(dt);
-		ParticleIterator_parallel(total_real_particles, functor_update_, dt);
+		ParticleIterator_parallel(total_real_particles, functor_update_, execution_policy_, dt);
+		finishParallelExecution();
+	}
+	//=================================================================================================//
+	void ParticleDynamics1Level::exec_by_level(LocalTimeStepLevels &time_step_levels, size_t sub_step)
+	{
+		Real dt_min = time_step_levels.MinimumTimeStepSize();
+		size_t active_levels = time_step_levels.ActiveLevels(sub_step);
+		setBodyUpdated();
+		setupDynamics(dt_min);
+		for (size_t l = 0; l != active_levels; ++l)
+			ParticleIteratorByIndexes(time_step_levels.level_particles_[l], functor_initialization_,
+									  time_step_levels.LevelTimeStepSize(l));
+		for (size_t k = 0; k < pre_processes_.size(); ++k)
+			pre_processes_[k]->exec(dt_min);
+		for (size_t l = 0; l != active_levels; ++l)
+			ParticleIteratorByIndexes(time_step_levels.level_particles_[l], functor_interaction_,
+									  time_step_levels.LevelTimeStepSize(l));
+		for (size_t k = 0; k < post_processes_.size(); ++k)
+			post_processes_[k]->exec(dt_min);
+		for (size_t l = 0; l != active_levels; ++l)
+			ParticleIteratorByIndexes(time_step_levels.level_particles_[l], functor_update_,
+									  time_step_levels.LevelTimeStepSize(l));
+	}
+	//=================================================================================================//
+	void ParticleDynamics1Level::parallel_exec_by_level(LocalTimeStepLevels &time_step_levels, size_t sub_step)
+	{
+		Real dt_min = time_step_levels.MinimumTimeStepSize();
+		size_t active_levels = time_step_levels.ActiveLevels(sub_step);
+		setBodyUpdated();
+		setupDynamics(dt_min);
+		for (size_t l = 0; l != active_levels; ++l)
+			ParticleIteratorByIndexes_parallel(time_step_levels.level_particles_[l], functor_initialization_,
+											   time_step_levels.LevelTimeStepSize(l));
+		for (size_t k = 0; k < pre_processes_.size(); ++k)
+			pre_processes_[k]->parallel_exec(dt_min);
+		for (size_t l = 0; l != active_levels; ++l)
+			ParticleIteratorByIndexes_parallel(time_step_levels.level_particles_[l], functor_interaction_,
+											   time_step_levels.LevelTimeStepSize(l));
+		for (size_t k = 0; k < post_processes_.size(); ++k)
+			post_processes_[k]->parallel_exec(dt_min);
+		for (size_t l = 0; l != active_levels; ++l)
+			ParticleIteratorByIndexes_parallel(time_step_levels.level_particles_[l], functor_update_,
+											   time_step_levels.LevelTimeStepSize(l));
+	}
+	//=================================================================================================//
+	void ParticleDynamics1Level::exec_by_blocks(CacheBlocks &blocks, Real dt)
+	{
+		if (!pre_processes_.empty() || !post_processes_.empty())
+		{
+			exec(dt);
+			return;
+		}
+
+		setBodyUpdated();
+		setupDynamics(dt);
+		size_t total_layers = blocks.TotalLayers();
+		size_t blocks_per_layer = blocks.BlocksPerLayer();
+		ParticleFunctor *functors[3] = {&functor_initialization_, &functor_interaction_, &functor_update_};
+		for (size_t k = 0; k != total_layers + 4; ++k)
+			for (size_t step = 0; step != 3; ++step)
+			{
+				size_t layer = k - 2 * step;
+				if (k >= 2 * step && layer < total_layers)
+					for (size_t n = 0; n != blocks_per_layer; ++n)
+						ParticleIteratorByIndexes(blocks.block_particles_[layer * blocks_per_layer + n], *functors[step], dt);
+			}
+	}
+	//=================================================================================================//
+	void ParticleDynamics1Level::parallel_exec_by_blocks(CacheBlocks &blocks, Real dt)
+	{
+		if (!pre_processes_.empty() || !post_processes_.empty())
+		{
+			parallel_exec(dt);
+			return;
+		}
+
+		startParallelExecution();
+		setBodyUpdated();
+		setupDynamics(dt);
+		size_t total_layers = blocks.TotalLayers();
+		size_t blocks_per_layer = blocks.BlocksPerLayer();
+		ParticleFunctor *functors[3] = {&functor_initialization_, &functor_interaction_, &functor_update_};
+		for (size_t k = 0; k != total_layers + 4; ++k)
+		{
+			execution_policy_.parallelFor(
+				3 * blocks_per_layer,
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t task = r.begin(); task != r.end(); ++task)
+					{
+						size_t step = task / blocks_per_layer;
+						size_t layer = k - 2 * step;
+						if (k >= 2 * step && layer < total_layers)
+							ParticleIteratorByIndexes(blocks.block_particles_[layer * blocks_per_layer + task % blocks_per_layer],
+													  *functors[step], dt);
+					}
+				});
+		}
+		finishParallelExecution();
 	}
 	//=================================================================================================//
 	void InteractionDynamicsSplitting::exec(Real dt)
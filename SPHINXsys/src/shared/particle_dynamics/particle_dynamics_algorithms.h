@@ -41,6 +41,10 @@
 
 namespace SPH
 {
+	class LocalTimeStepLevels;
+	class SpatialTaskGraph;
+	class CacheBlocks;
+
 	/**
 	* @class ParticleDynamicsSimple
 	* @brief Simple particle dynamics without considering particle interaction
@@ -88,11 +92,13 @@ namespace SPH
 		};
 		virtual ReturnType parallel_exec(Real dt = 0.0) override
 		{
+			this->startParallelExecution();
 			size_t total_real_particles = this->base_particles_->total_real_particles_;
 			this->setBodyUpdated();
 			SetupReduce();
-			ReturnType temp = ReduceIterator_parallel(total_real_particles,
-													  initial_reference_, functor_reduce_function_, reduce_operation_, dt);
+			ReturnType temp = ReduceIterator_parallel(total_real_particles, initial_reference_, functor_reduce_function_,
+													  reduce_operation_, this->execution_policy_, dt);
+			this->finishParallelExecution();
 			return this->OutputResult(temp);
 		};
 
@@ -131,6 +137,7 @@ namespace SPH
 
 	protected:
 		friend class CombinedInteractionDynamics;
+		friend class SpatialTaskGraph;
 		virtual void Interaction(size_t index_i, Real dt = 0.0) = 0;
 		ParticleFunctor functor_interaction_;
 	};
@@ -168,8 +175,12 @@ namespace SPH
 
 		virtual void exec(Real dt = 0.0) override;
 		virtual void parallel_exec(Real dt = 0.0) override;
+		/** only the particles in the levels active at the sub-step are advanced with their level time-step sizes */
+		virtual void exec_by_level(LocalTimeStepLevels &time_step_levels, size_t sub_step);
+		virtual void parallel_exec_by_level(LocalTimeStepLevels &time_step_levels, size_t sub_step);
 
 	protected:
+		friend class SpatialTaskGraph;
 		virtual void Update(size_t index_i, Real dt = 0.0) = 0;
 		ParticleFunctor functor_update_;
 	};
@@ -189,8 +200,15 @@ namespace SPH
 
 		virtual void exec(Real dt = 0.0) override;
 		virtual void parallel_exec(Real dt = 0.0) override;
+		virtual void exec_by_level(LocalTimeStepLevels &time_step_levels, size_t sub_step) override;
+		virtual void parallel_exec_by_level(LocalTimeStepLevels &time_step_levels, size_t sub_step) override;
+		/** the three steps are fused in a wavefront sweep over the layers of blocks for cache reuse,
+		 * which falls back to the step-by-step execution if there are pre- or post-processes */
+		virtual void exec_by_blocks(CacheBlocks &blocks, Real dt = 0.0);
+		virtual void parallel_exec_by_blocks(CacheBlocks &blocks, Real dt = 0.0);
 
 	protected:
+		friend class SpatialTaskGraph;
 		virtual void Initialization(size_t index_i, Real dt = 0.0) = 0;
 		ParticleFunctor functor_initialization_;
 	};
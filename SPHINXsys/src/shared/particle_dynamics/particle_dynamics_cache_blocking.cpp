@@ -0,0 +1,98 @@
+/**
+ * @file 	particle_dynamics_cache_blocking.cpp
+ * @brief 	This is the implementation of the blocks for cache-blocked execution
+ * @author	Chi ZHang and Xiangyu Hu
+ */
+
+#include "particle_dynamics_cache_blocking.h"
+
+//=================================================================================================//
+namespace SPH
+{
+	//=================================================================================================//
+	CacheBlocks::CacheBlocks(RealBody &real_body, size_t cells_per_block)
+		: base_particles_(real_body.base_particles_),
+		  cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.cell_linked_list_)),
+		  cells_per_block_(SMAX(cells_per_block, (size_t)1)), number_of_blocks_(0), sweep_axis_(0)
+	{
+		Vecu number_of_cells = cell_linked_list_->NumberOfCells();
+		size_t total_blocks = 1;
+		for (size_t axis = 0; axis != number_of_cells.size(); ++axis)
+		{
+			number_of_blocks_[axis] = (number_of_cells[axis] + cells_per_block_ - 1) / cells_per_block_;
+			total_blocks *= number_of_blocks_[axis];
+			if (number_of_blocks_[axis] > number_of_blocks_[sweep_axis_])
+				sweep_axis_ = axis;
+		}
+		total_layers_ = number_of_blocks_[sweep_axis_];
+		blocks_per_layer_ = total_blocks / total_layers_;
+		block_particles_.resize(total_blocks);
+	}
+	//=================================================================================================//
+	size_t CacheBlocks::BlockIndex(const Vecd &position)
+	{
+		Vecu block_index = cell_linked_list_->CellIndexFromPosition(position);
+		for (size_t axis = 0; axis != block_index.size(); ++axis)
+			block_index[axis] = SMIN(block_index[axis] / cells_per_block_, number_of_blocks_[axis] - 1);
+		size_t layer = block_index[sweep_axis_];
+		Vecu blocks_in_layer = number_of_blocks_;
+		blocks_in_layer[sweep_axis_] = 1;
+		block_index[sweep_axis_] = 0;
+		return layer * blocks_per_layer_ + cell_linked_list_->transferMeshIndexTo1D(blocks_in_layer, block_index);
+	}
+	//=================================================================================================//
+	void CacheBlocks::updateBlocks()
+	{
+		StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		size_t total_blocks = block_particles_.size();
+		size_t chunk_size = 4096;
+		size_t number_of_chunks = (total_real_particles + chunk_size - 1) / chunk_size;
+		StdVec<IndexVector> chunk_offsets(number_of_chunks, IndexVector(total_blocks, 0));
+
+		parallel_for(
+			blocked_range<size_t>(0, number_of_chunks),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t chunk = r.begin(); chunk != r.end(); ++chunk)
+				{
+					size_t chunk_end = SMIN((chunk + 1) * chunk_size, total_real_particles);
+					for (size_t index_i = chunk * chunk_size; index_i != chunk_end; ++index_i)
+						chunk_offsets[chunk][BlockIndex(pos_n[index_i])]++;
+				}
+			},
+			ap);
+
+		/** the chunks are placed in sequence, so that the particles of a block are in the order of their indexes */
+		for (size_t block = 0; block != total_blocks; ++block)
+		{
+			size_t block_size = 0;
+			for (size_t chunk = 0; chunk != number_of_chunks; ++chunk)
+			{
+				size_t chunk_count = chunk_offsets[chunk][block];
+				chunk_offsets[chunk][block] = block_size;
+				block_size += chunk_count;
+			}
+			block_particles_[block].resize(block_size);
+		}
+
+		parallel_for(
+			blocked_range<size_t>(0, number_of_chunks),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t chunk = r.begin(); chunk != r.end(); ++chunk)
+				{
+					IndexVector &offsets = chunk_offsets[chunk];
+					size_t chunk_end = SMIN((chunk + 1) * chunk_size, total_real_particles);
+					for (size_t index_i = chunk * chunk_size; index_i != chunk_end; ++index_i)
+					{
+						size_t block = BlockIndex(pos_n[index_i]);
+						block_particles_[block][offsets[block]++] = index_i;
+					}
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+}
+//=================================================================================================//
@@ -0,0 +1,81 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+* @file 	particle_dynamics_cache_blocking.h
+* @brief 	This is the classes for executing the particle-wise steps 
+*			of a particle dynamics block by block so that the data stay in cache.
+* @author	Chi ZHang and Xiangyu Hu
+*/
+
+#ifndef PARTICLE_DYNAMICS_CACHE_BLOCKING_H
+#define PARTICLE_DYNAMICS_CACHE_BLOCKING_H
+
+#include "base_particle_dynamics.h"
+
+namespace SPH
+{
+	/**
+	 * @class CacheBlocks
+	 * @brief Blocks of cells of the cell linked list in all axes, 
+	 * grouped into layers for the cache-blocked execution of particle dynamics.
+	 * @details The particles of a body are binned into blocks with one or more cells in each axis.
+	 * The blocks are grouped into layers across the sweep axis, which is the axis with the most blocks,
+	 * so that a layer is the smallest cross-section of the body.
+	 * Since the interaction range is not larger than a cell,
+	 * the neighbors of a particle are in the same or the two adjacent layers.
+	 * The initialization, interaction and update steps are then carried out in a wavefront sweep, 
+	 * i.e. initialization on layer s + 2, interaction on layer s and update on layer s - 2,
+	 * as long as the initialization and update steps only use the data of the particle itself.
+	 * As the three steps of a sweep step do not depend on each other, 
+	 * they are executed together on the blocks of the three layers with one barrier only,
+	 * and the results are the same as those of the step-by-step execution.
+	 * Note that, with the cell index in Morton order, a block of the sorted particles 
+	 * is in a contiguous range of memory for a power of two cells per block,
+	 * and that the blocks should be updated after the cell linked list and configuration are updated.
+	 */
+	class CacheBlocks
+	{
+	public:
+		CacheBlocks(RealBody &real_body, size_t cells_per_block = 8);
+		virtual ~CacheBlocks(){};
+
+		StdVec<IndexVector> block_particles_; /**< particles binned into blocks, layer by layer */
+
+		size_t TotalLayers() { return total_layers_; };
+		size_t BlocksPerLayer() { return blocks_per_layer_; };
+		/** bin the particles into blocks, in parallel and in the order of their indexes */
+		void updateBlocks();
+
+	protected:
+		BaseParticles *base_particles_;
+		CellLinkedList *cell_linked_list_;
+		size_t cells_per_block_;
+		Vecu number_of_blocks_;
+		size_t sweep_axis_;
+		size_t total_layers_;
+		size_t blocks_per_layer_;
+
+		size_t BlockIndex(const Vecd &position);
+	};
+}
+#endif //PARTICLE_DYNAMICS_CACHE_BLOCKING_H
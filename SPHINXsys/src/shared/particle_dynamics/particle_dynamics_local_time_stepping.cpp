@@ -0,0 +1,257 @@
+/**
+* @file 	particle_dynamics_local_time_stepping.cpp
+* @brief 	This is the implementation of the hierarchical local time stepping
+* @author	Chi ZHang and Xiangyu Hu
+*/
+
+#include "particle_dynamics_local_time_stepping.h"
+
+//=================================================================================================//
+namespace SPH
+{
+	//=================================================================================================//
+	LocalTimeStepLevels::
+		LocalTimeStepLevels(BaseBodyRelationInner &inner_relation, size_t total_levels)
+		: base_particles_(inner_relation.base_particles_),
+		  inner_configuration_(inner_relation.inner_configuration_),
+		  total_levels_(SMAX(total_levels, (size_t)1)), dt_min_(0.0)
+	{
+		level_particles_.resize(total_levels_);
+		base_particles_->registerAVariable<indexScalar, Real>(local_dt_, "LocalTimeStepSize");
+		base_particles_->registerAVariable<indexInteger, int>(time_step_level_, "TimeStepLevel");
+		base_particles_->addAVariableToWrite<indexInteger, int>("TimeStepLevel");
+		smoothed_level_.resize(base_particles_->real_particles_bound_, 0);
+	}
+	//=================================================================================================//
+	size_t LocalTimeStepLevels::ActiveLevels(size_t sub_step)
+	{
+		size_t active_levels = 1;
+		size_t level_sub_steps = 2;
+		while (active_levels < total_levels_ && sub_step % level_sub_steps == 0)
+		{
+			active_levels++;
+			level_sub_steps *= 2;
+		}
+		return active_levels;
+	}
+	//=================================================================================================//
+	void LocalTimeStepLevels::updateLevels(Real dt_min)
+	{
+		dt_min_ = dt_min;
+		assignLevelsByTimeStepSize();
+		smoothLevelsByNeighbors();
+		binParticlesIntoLevels();
+		for (size_t k = 0; k != interface_registers_.size(); ++k)
+			interface_registers_[k]->resetRegisters();
+	}
+	//=================================================================================================//
+	void LocalTimeStepLevels::addInterfaceRegister(LevelInterfaceMomentumRegister *interface_register)
+	{
+		interface_registers_.push_back(interface_register);
+	}
+	//=================================================================================================//
+	void LocalTimeStepLevels::assignLevelsByTimeStepSize()
+	{
+		parallel_for(
+			blocked_range<size_t>(0, base_particles_->total_real_particles_),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+				{
+					Real time_step_ratio = local_dt_[index_i] / (dt_min_ + TinyReal);
+					int level = 0;
+					Real level_ratio = 2.0;
+					while (level + 1 < (int)total_levels_ && time_step_ratio >= level_ratio)
+					{
+						level++;
+						level_ratio *= 2.0;
+					}
+					time_step_level_[index_i] = level;
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	void LocalTimeStepLevels::smoothLevelsByNeighbors()
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		if (smoothed_level_.size() < total_real_particles)
+			smoothed_level_.resize(base_particles_->real_particles_bound_, 0);
+
+		/** a level difference can be propagated at most one neighbor further by each sweep */
+		for (size_t sweep = 1; sweep < total_levels_; ++sweep)
+		{
+			parallel_for(
+				blocked_range<size_t>(0, total_real_particles),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+					{
+						int level = time_step_level_[index_i];
+						const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+						for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+						{
+							level = SMIN(level, time_step_level_[inner_neighborhood.j_[n]] + 1);
+						}
+						smoothed_level_[index_i] = level;
+					}
+				},
+				ap);
+
+			parallel_for(
+				blocked_range<size_t>(0, total_real_particles),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+					{
+						time_step_level_[index_i] = smoothed_level_[index_i];
+					}
+				},
+				ap);
+		}
+	}
+	//=================================================================================================//
+	void LocalTimeStepLevels::binParticlesIntoLevels()
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		size_t block_size = 4096;
+		size_t number_of_blocks = (total_real_particles + block_size - 1) / block_size;
+		StdVec<IndexVector> block_offsets(number_of_blocks, IndexVector(total_levels_, 0));
+
+		parallel_for(
+			blocked_range<size_t>(0, number_of_blocks),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t block = r.begin(); block != r.end(); ++block)
+				{
+					size_t block_end = SMIN((block + 1) * block_size, total_real_particles);
+					for (size_t index_i = block * block_size; index_i != block_end; ++index_i)
+						block_offsets[block][time_step_level_[index_i]]++;
+				}
+			},
+			ap);
+
+		/** the blocks are placed in sequence, so that the particles of a level are in the order of their indexes */
+		for (size_t l = 0; l != total_levels_; ++l)
+		{
+			size_t level_size = 0;
+			for (size_t block = 0; block != number_of_blocks; ++block)
+			{
+				size_t block_count = block_offsets[block][l];
+				block_offsets[block][l] = level_size;
+				level_size += block_count;
+			}
+			level_particles_[l].resize(level_size);
+		}
+
+		parallel_for(
+			blocked_range<size_t>(0, number_of_blocks),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t block = r.begin(); block != r.end(); ++block)
+				{
+					IndexVector &offsets = block_offsets[block];
+					size_t block_end = SMIN((block + 1) * block_size, total_real_particles);
+					for (size_t index_i = block * block_size; index_i != block_end; ++index_i)
+					{
+						int level = time_step_level_[index_i];
+						level_particles_[level][offsets[level]++] = index_i;
+					}
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	LevelInterfaceMomentumRegister::
+		LevelInterfaceMomentumRegister(LocalTimeStepLevels &time_step_levels, BaseBodyRelationInner &inner_relation)
+		: base_particles_(inner_relation.base_particles_),
+		  inner_configuration_(inner_relation.inner_configuration_),
+		  time_step_level_(time_step_levels.time_step_level_),
+		  vel_n_(base_particles_->vel_n_), mass_(base_particles_->mass_)
+	{
+		time_step_levels.addInterfaceRegister(this);
+		resetRegisters();
+	}
+	//=================================================================================================//
+	void LevelInterfaceMomentumRegister::resetRegisters()
+	{
+		if (pair_impulses_.size() < base_particles_->real_particles_bound_)
+			pair_impulses_.resize(base_particles_->real_particles_bound_);
+
+		parallel_for(
+			blocked_range<size_t>(0, base_particles_->total_real_particles_),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+				{
+					bool is_interface_particle = false;
+					const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+					for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+					{
+						if (isAcrossLevels(index_i, inner_neighborhood.j_[n]))
+							is_interface_particle = true;
+					}
+					if (is_interface_particle)
+						pair_impulses_[index_i].assign(inner_neighborhood.current_size_, Vecd(0));
+					else
+						pair_impulses_[index_i].clear();
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	size_t LevelInterfaceMomentumRegister::findReverseNeighbor(size_t index_i, size_t index_j)
+	{
+		const Neighborhood &neighborhood_j = inner_configuration_[index_j];
+		size_t n = 0;
+		while (n != neighborhood_j.current_size_ && neighborhood_j.j_[n] != index_i)
+			n++;
+		return n;
+	}
+	//=================================================================================================//
+	void LevelInterfaceMomentumRegister::correctCoarseMomenta()
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+				{
+					if (!isInterfaceParticle(index_i))
+						continue;
+
+					Vecd correction(0);
+					const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+					for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+					{
+						size_t index_j = inner_neighborhood.j_[n];
+						/** only the coarser particle of a pair is corrected, and only if the pair is seen by both */
+						if (time_step_level_[index_j] < time_step_level_[index_i])
+						{
+							size_t reverse_n = findReverseNeighbor(index_i, index_j);
+							if (reverse_n != inner_configuration_[index_j].current_size_)
+								correction -= pair_impulses_[index_j][reverse_n] + pair_impulses_[index_i][n];
+						}
+					}
+					vel_n_[index_i] += correction / mass_[index_i];
+				}
+			},
+			ap);
+
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+				{
+					StdVec<Vecd> &impulses = pair_impulses_[index_i];
+					for (size_t n = 0; n != impulses.size(); ++n)
+						impulses[n] = Vecd(0);
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+}
+//=================================================================================================//
@@ -0,0 +1,142 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+* @file 	particle_dynamics_local_time_stepping.h
+* @brief 	This is the classes for hierarchical local time stepping.
+* @detail	The particles of a body are binned into power-of-two time-step levels
+*			according to their own smoothing lengths and signal speeds.
+*			The particles of a coarse level are advanced less often
+*			than those of a fine level.
+* @author	Chi ZHang and Xiangyu Hu
+*/
+
+#ifndef PARTICLE_DYNAMICS_LOCAL_TIME_STEPPING_H
+#define PARTICLE_DYNAMICS_LOCAL_TIME_STEPPING_H
+
+#include "base_particle_dynamics.h"
+
+namespace SPH
+{
+	class LevelInterfaceMomentumRegister;
+
+	/**
+	 * @class LocalTimeStepLevels
+	 * @brief Hierarchical time-step levels for the particles of a body.
+	 * @details A particle in level l is advanced with the time-step size 2^l dt_min,
+	 * in which dt_min is the minimum individual time-step size of the body.
+	 * There are 2^(total_levels - 1) sub-steps within the coarsest time step
+	 * and the particles in level l are active only at the sub-steps which are multiples of 2^l.
+	 * Therefore, all finer levels are active whenever a level is active,
+	 * and all levels are synchronized at the beginning of each coarsest time step.
+	 * The levels are smoothed so that those of neighboring particles differ at most by one.
+	 * A typical usage in the dual time-stepping loop is:
+	 *		Real Dt_coarse = local_acoustic_time_step.parallel_exec();
+	 *		for (size_t sub_step = 0; sub_step != time_step_levels.SubStepsInCoarsestStep(); ++sub_step)
+	 *		{
+	 *			pressure_relaxation.parallel_exec_by_level(time_step_levels, sub_step);
+	 *			density_relaxation.parallel_exec_by_level(time_step_levels, sub_step);
+	 *		}
+	 *		momentum_register.correctCoarseMomenta();
+	 * Note that the levels should be updated after particle sorting as they are saved by particle indexes.
+	 */
+	class LocalTimeStepLevels
+	{
+	public:
+		LocalTimeStepLevels(BaseBodyRelationInner &inner_relation, size_t total_levels = 3);
+		virtual ~LocalTimeStepLevels(){};
+
+		StdLargeVec<Real> local_dt_;		  /**< individual time-step size of particles */
+		StdLargeVec<int> time_step_level_;	  /**< time-step level of particles */
+		StdVec<IndexVector> level_particles_; /**< particles binned into levels */
+
+		size_t TotalLevels() { return total_levels_; };
+		size_t SubStepsInCoarsestStep() { return (size_t)1 << (total_levels_ - 1); };
+		/** number of the active levels, counted from the finest one, at a sub-step */
+		size_t ActiveLevels(size_t sub_step);
+		Real MinimumTimeStepSize() { return dt_min_; };
+		Real LevelTimeStepSize(size_t level) { return dt_min_ * (Real)((size_t)1 << level); };
+		Real CoarsestTimeStepSize() { return LevelTimeStepSize(total_levels_ - 1); };
+		/** bin particles into levels by their individual time-step sizes and the minimum one,
+		 *  the level interface registers are reset for the new levels */
+		void updateLevels(Real dt_min);
+		void addInterfaceRegister(LevelInterfaceMomentumRegister *interface_register);
+
+	protected:
+		BaseParticles *base_particles_;
+		ParticleConfiguration &inner_configuration_;
+		size_t total_levels_;
+		Real dt_min_;
+		StdLargeVec<int> smoothed_level_;
+		StdVec<LevelInterfaceMomentumRegister *> interface_registers_;
+
+		void assignLevelsByTimeStepSize();
+		void smoothLevelsByNeighbors();
+		void binParticlesIntoLevels();
+	};
+
+	/**
+	 * @class LevelInterfaceMomentumRegister
+	 * @brief Conservative correction of the momentum exchanged across time-step level interfaces.
+	 * @details Within a coarsest time step, a fine particle sees its coarser neighbor at each of its sub-steps,
+	 * while the coarser particle sees the fine one less often with a larger time-step size,
+	 * so that the pair impulses do not cancel and the momentum is not conserved.
+	 * The pressure relaxation registers the pair impulses across level interfaces
+	 * after pressure_relaxation.useLevelInterfaceRegister(momentum_register).
+	 * At the end of the coarsest time step, the impulses received by a coarser particle from its finer neighbors
+	 * are replaced by the opposite of those received by the finer neighbors from it,
+	 * as the refluxing in adaptive mesh refinement.
+	 * Only the momentum is corrected, as the particle masses are constant,
+	 * and the positions of the coarser particles are not corrected.
+	 */
+	class LevelInterfaceMomentumRegister
+	{
+	public:
+		LevelInterfaceMomentumRegister(LocalTimeStepLevels &time_step_levels, BaseBodyRelationInner &inner_relation);
+		virtual ~LevelInterfaceMomentumRegister(){};
+
+		/** whether a particle has neighbors in other levels, only valid after the levels are updated */
+		bool isInterfaceParticle(size_t index_i) { return !pair_impulses_[index_i].empty(); };
+		bool isAcrossLevels(size_t index_i, size_t index_j)
+		{
+			return time_step_level_[index_i] != time_step_level_[index_j];
+		};
+		/** register the impulse on a particle from its n-th neighbor within the time step of the particle */
+		void registerPairImpulse(size_t index_i, size_t n, const Vecd &impulse) { pair_impulses_[index_i][n] += impulse; };
+		/** clear the registers and find the interface particles for the current levels and configuration */
+		void resetRegisters();
+		/** replace the impulses on the coarser particles at the end of a coarsest time step */
+		void correctCoarseMomenta();
+
+	protected:
+		BaseParticles *base_particles_;
+		ParticleConfiguration &inner_configuration_;
+		StdLargeVec<int> &time_step_level_;
+		StdLargeVec<Vecd> &vel_n_;
+		StdLargeVec<Real> &mass_;
+		StdLargeVec<StdVec<Vecd>> pair_impulses_; /**< impulses from each neighbor, only for interface particles */
+
+		/** the position of a particle in the neighborhood of its neighbor, or the size of the neighborhood if not found */
+		size_t findReverseNeighbor(size_t index_i, size_t index_j);
+	};
+}
+#endif //PARTICLE_DYNAMICS_LOCAL_TIME_STEPPING_H
@@ -0,0 +1,280 @@
+/**
+ * @file 	particle_dynamics_task_graph.cpp
+ * @brief 	This is the implementation of the tile-by-tile task graph execution
+ * @author	Chi ZHang and Xiangyu Hu
+ */
+
+#include "particle_dynamics_task_graph.h"
+
+//=================================================================================================//
+namespace SPH
+{
+	//=================================================================================================//
+	SpatialTaskGraph::SpatialTaskGraph(RealBody &real_body, size_t cells_per_tile)
+		: real_body_(&real_body), base_particles_(real_body.base_particles_),
+		  cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.cell_linked_list_)),
+		  cells_per_tile_(SMAX(cells_per_tile, (size_t)1)), number_of_tiles_(0), total_tiles_(1),
+		  dt_(0.0), is_graph_built_(false)
+	{
+		Vecu number_of_cells = cell_linked_list_->NumberOfCells();
+		for (size_t axis = 0; axis != number_of_cells.size(); ++axis)
+		{
+			number_of_tiles_[axis] = (number_of_cells[axis] + cells_per_tile_ - 1) / cells_per_tile_;
+			total_tiles_ *= number_of_tiles_[axis];
+		}
+		tile_particles_.resize(total_tiles_);
+		neighbor_tiles_.resize(total_tiles_);
+
+		size_t number_of_neighbor_offsets = powerN(3, Vecd(0).size());
+		for (size_t tile = 0; tile != total_tiles_; ++tile)
+		{
+			Vecu tile_index = cell_linked_list_->transfer1DtoMeshIndex(number_of_tiles_, tile);
+			for (size_t k = 0; k != number_of_neighbor_offsets; ++k)
+			{
+				Vecu offset = cell_linked_list_->transfer1DtoMeshIndex(Vecu(3), k);
+				Vecu neighbor_index(0);
+				bool is_inside = true;
+				for (size_t axis = 0; axis != tile_index.size(); ++axis)
+				{
+					int index = (int)tile_index[axis] + (int)offset[axis] - 1;
+					is_inside = is_inside && index >= 0 && index < (int)number_of_tiles_[axis];
+					neighbor_index[axis] = is_inside ? (size_t)index : 0;
+				}
+				if (is_inside)
+					neighbor_tiles_[tile].push_back(cell_linked_list_->transferMeshIndexTo1D(number_of_tiles_, neighbor_index));
+			}
+		}
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::addTileFunctor(ParticleFunctor &tile_functor)
+	{
+		TaskGraphPhase phase = {&tile_functor, nullptr, nullptr};
+		phases_.push_back(phase);
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::addSetup(InteractionDynamics &dynamics, bool has_global_setup)
+	{
+		if (is_graph_built_)
+		{
+			std::cout << "\n Error: dynamics can not be added after the task graph is built!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+
+		if (has_global_setup)
+		{
+			TaskGraphPhase phase = {nullptr, &dynamics, nullptr};
+			phases_.push_back(phase);
+		}
+		else
+		{
+			dynamics_set_up_at_start_.push_back(&dynamics);
+		}
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::addBarrierProcesses(StdVec<ParticleDynamics<void> *> &barrier_processes)
+	{
+		if (!barrier_processes.empty())
+		{
+			TaskGraphPhase phase = {nullptr, nullptr, &barrier_processes};
+			phases_.push_back(phase);
+		}
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::addInteractionPhases(InteractionDynamics &dynamics)
+	{
+		addBarrierProcesses(dynamics.pre_processes_);
+		addTileFunctor(dynamics.functor_interaction_);
+		addBarrierProcesses(dynamics.post_processes_);
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::addDynamics(InteractionDynamics &dynamics, bool has_global_setup)
+	{
+		addSetup(dynamics, has_global_setup);
+		addInteractionPhases(dynamics);
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::addDynamics(InteractionDynamicsWithUpdate &dynamics, bool has_global_setup)
+	{
+		addSetup(dynamics, has_global_setup);
+		addInteractionPhases(dynamics);
+		addTileFunctor(dynamics.functor_update_);
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::addDynamics(ParticleDynamics1Level &dynamics, bool has_global_setup)
+	{
+		addSetup(dynamics, has_global_setup);
+		addTileFunctor(dynamics.functor_initialization_);
+		addInteractionPhases(dynamics);
+		addTileFunctor(dynamics.functor_update_);
+	}
+	//=================================================================================================//
+	size_t SpatialTaskGraph::TileIndex(const Vecd &position)
+	{
+		Vecu tile_index = cell_linked_list_->CellIndexFromPosition(position);
+		for (size_t axis = 0; axis != tile_index.size(); ++axis)
+			tile_index[axis] = SMIN(tile_index[axis] / cells_per_tile_, number_of_tiles_[axis] - 1);
+		return cell_linked_list_->transferMeshIndexTo1D(number_of_tiles_, tile_index);
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::updateTiles()
+	{
+		StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		size_t block_size = 4096;
+		size_t number_of_blocks = (total_real_particles + block_size - 1) / block_size;
+		StdVec<IndexVector> block_offsets(number_of_blocks, IndexVector(total_tiles_, 0));
+
+		parallel_for(
+			blocked_range<size_t>(0, number_of_blocks),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t block = r.begin(); block != r.end(); ++block)
+				{
+					size_t block_end = SMIN((block + 1) * block_size, total_real_particles);
+					for (size_t index_i = block * block_size; index_i != block_end; ++index_i)
+						block_offsets[block][TileIndex(pos_n[index_i])]++;
+				}
+			},
+			ap);
+
+		/** the blocks are placed in sequence, so that the particles of a tile are in the order of their indexes */
+		for (size_t tile = 0; tile != total_tiles_; ++tile)
+		{
+			size_t tile_size = 0;
+			for (size_t block = 0; block != number_of_blocks; ++block)
+			{
+				size_t block_count = block_offsets[block][tile];
+				block_offsets[block][tile] = tile_size;
+				tile_size += block_count;
+			}
+			tile_particles_[tile].resize(tile_size);
+		}
+
+		parallel_for(
+			blocked_range<size_t>(0, number_of_blocks),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t block = r.begin(); block != r.end(); ++block)
+				{
+					IndexVector &offsets = block_offsets[block];
+					size_t block_end = SMIN((block + 1) * block_size, total_real_particles);
+					for (size_t index_i = block * block_size; index_i != block_end; ++index_i)
+					{
+						size_t tile = TileIndex(pos_n[index_i]);
+						tile_particles_[tile][offsets[tile]++] = index_i;
+					}
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::startExecution(Real dt)
+	{
+		dt_ = dt;
+		real_body_->setNewlyUpdated();
+		for (size_t k = 0; k != dynamics_set_up_at_start_.size(); ++k)
+			dynamics_set_up_at_start_[k]->setupDynamics(dt);
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::executePhaseOnTile(size_t phase, size_t tile)
+	{
+		ParticleIteratorByIndexes(tile_particles_[tile], *phases_[phase].tile_functor_, dt_);
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::executeBarrier(size_t phase)
+	{
+		if (phases_[phase].setup_dynamics_ != nullptr)
+		{
+			phases_[phase].setup_dynamics_->setupDynamics(dt_);
+			return;
+		}
+
+		StdVec<ParticleDynamics<void> *> &barrier_processes = *phases_[phase].barrier_processes_;
+		for (size_t k = 0; k != barrier_processes.size(); ++k)
+			barrier_processes[k]->parallel_exec(dt_);
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::buildTaskGraph()
+	{
+		using namespace tbb::flow;
+		start_node_.reset(new broadcast_node<continue_msg>(task_graph_));
+
+		/** the nodes of the previous phase, one for a barrier or one for each tile */
+		StdVec<continue_node<continue_msg> *> previous_nodes;
+		for (size_t phase = 0; phase != phases_.size(); ++phase)
+		{
+			StdVec<continue_node<continue_msg> *> current_nodes;
+			if (phases_[phase].tile_functor_ != nullptr)
+			{
+				for (size_t tile = 0; tile != total_tiles_; ++tile)
+				{
+					task_nodes_.emplace_back(new continue_node<continue_msg>(
+						task_graph_, [this, phase, tile](const continue_msg &) -> continue_msg
+						{
+							executePhaseOnTile(phase, tile);
+							return continue_msg();
+						}));
+					current_nodes.push_back(task_nodes_.back().get());
+				}
+
+				for (size_t tile = 0; tile != total_tiles_; ++tile)
+				{
+					if (previous_nodes.empty())
+						make_edge(*start_node_, *current_nodes[tile]);
+					else if (previous_nodes.size() == 1)
+						make_edge(*previous_nodes[0], *current_nodes[tile]);
+					else
+						for (size_t n = 0; n != neighbor_tiles_[tile].size(); ++n)
+							make_edge(*previous_nodes[neighbor_tiles_[tile][n]], *current_nodes[tile]);
+				}
+			}
+			else
+			{
+				task_nodes_.emplace_back(new continue_node<continue_msg>(
+					task_graph_, [this, phase](const continue_msg &) -> continue_msg
+					{
+						executeBarrier(phase);
+						return continue_msg();
+					}));
+				current_nodes.push_back(task_nodes_.back().get());
+
+				if (previous_nodes.empty())
+					make_edge(*start_node_, *current_nodes[0]);
+				for (size_t n = 0; n != previous_nodes.size(); ++n)
+					make_edge(*previous_nodes[n], *current_nodes[0]);
+			}
+			previous_nodes = current_nodes;
+		}
+		is_graph_built_ = true;
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::exec(Real dt)
+	{
+		startExecution(dt);
+		for (size_t phase = 0; phase != phases_.size(); ++phase)
+		{
+			if (phases_[phase].tile_functor_ != nullptr)
+			{
+				for (size_t tile = 0; tile != total_tiles_; ++tile)
+					executePhaseOnTile(phase, tile);
+			}
+			else
+			{
+				executeBarrier(phase);
+			}
+		}
+	}
+	//=================================================================================================//
+	void SpatialTaskGraph::parallel_exec(Real dt)
+	{
+		if (!is_graph_built_)
+			buildTaskGraph();
+
+		startExecution(dt);
+		start_node_->try_put(tbb::flow::continue_msg());
+		task_graph_.wait_for_all();
+	}
+	//=================================================================================================//
+}
+//=================================================================================================//
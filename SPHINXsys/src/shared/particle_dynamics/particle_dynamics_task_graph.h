@@ -0,0 +1,118 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+* @file 	particle_dynamics_task_graph.h
+* @brief 	This is the classes for executing a sequence of particle dynamics 
+*			tile by tile with a task graph.
+* @author	Chi ZHang and Xiangyu Hu
+*/
+
+#ifndef PARTICLE_DYNAMICS_TASK_GRAPH_H
+#define PARTICLE_DYNAMICS_TASK_GRAPH_H
+
+#include "particle_dynamics_algorithms.h"
+
+#include "tbb/flow_graph.h"
+
+namespace SPH
+{
+	/**
+	 * @class SpatialTaskGraph
+	 * @brief Executing a sequence of particle dynamics of a body tile by tile,
+	 * in which a tile is a block of cells of the cell linked list.
+	 * @details Each dynamics is divided into its particle-wise phases, i.e. initialization, interaction and update.
+	 * A phase on a tile starts as soon as the previous phase has finished on this tile and its neighboring tiles,
+	 * instead of waiting for the previous phase to finish on the whole body.
+	 * As the interaction range is not larger than a cell, all the data dependencies of 
+	 * the phase-by-phase execution are kept, while the global barriers between phases are removed.
+	 * The setup, pre- and post-processes of a dynamics are still executed as global barriers,
+	 * in the same order as the dynamics executed one after another.
+	 * The setup barrier can be left out for a dynamics whose setup neither depends on
+	 * nor modifies particle data, its setup is then carried out at the start of the execution.
+	 * Note that the tiles should be updated after the cell linked list and configuration are updated,
+	 * and the dynamics should only modify the data of this body.
+	 * A typical usage in the dual time-stepping loop is:
+	 *		SpatialTaskGraph fluid_relaxation(water_block);
+	 *		fluid_relaxation.addDynamics(fluid_pressure_relaxation, false);
+	 *		fluid_relaxation.addDynamics(fluid_density_relaxation, false);
+	 *		...
+	 *		fluid_relaxation.parallel_exec(dt);
+	 *		dt = fluid_acoustic_time_step.parallel_exec();
+	 *		...
+	 *		water_block.updateCellLinkedList();
+	 *		water_block_complex.updateConfiguration();
+	 *		fluid_relaxation.updateTiles();
+	 */
+	class SpatialTaskGraph
+	{
+	public:
+		SpatialTaskGraph(RealBody &real_body, size_t cells_per_tile = 4);
+		virtual ~SpatialTaskGraph(){};
+
+		/** the dynamics are executed in the order of adding */
+		void addDynamics(InteractionDynamics &dynamics, bool has_global_setup = true);
+		void addDynamics(InteractionDynamicsWithUpdate &dynamics, bool has_global_setup = true);
+		void addDynamics(ParticleDynamics1Level &dynamics, bool has_global_setup = true);
+		/** bin the particles into tiles according to their cells, in parallel and in the order of their indexes */
+		void updateTiles();
+		void exec(Real dt = 0.0);
+		void parallel_exec(Real dt = 0.0);
+
+	protected:
+		/** a phase is either particle-wise on each tile or a global barrier for a setup or processes */
+		struct TaskGraphPhase
+		{
+			ParticleFunctor *tile_functor_;
+			InteractionDynamics *setup_dynamics_;
+			StdVec<ParticleDynamics<void> *> *barrier_processes_;
+		};
+
+		RealBody *real_body_;
+		BaseParticles *base_particles_;
+		CellLinkedList *cell_linked_list_;
+		size_t cells_per_tile_;
+		Vecu number_of_tiles_;
+		size_t total_tiles_;
+		StdVec<IndexVector> tile_particles_;
+		StdVec<IndexVector> neighbor_tiles_;
+		StdVec<InteractionDynamics *> dynamics_set_up_at_start_;
+		StdVec<TaskGraphPhase> phases_;
+		Real dt_;
+
+		tbb::flow::graph task_graph_;
+		bool is_graph_built_;
+		UniquePtr<tbb::flow::broadcast_node<tbb::flow::continue_msg>> start_node_;
+		StdVec<UniquePtr<tbb::flow::continue_node<tbb::flow::continue_msg>>> task_nodes_;
+
+		void addTileFunctor(ParticleFunctor &tile_functor);
+		void addSetup(InteractionDynamics &dynamics, bool has_global_setup);
+		void addBarrierProcesses(StdVec<ParticleDynamics<void> *> &barrier_processes);
+		void addInteractionPhases(InteractionDynamics &dynamics);
+		size_t TileIndex(const Vecd &position);
+		void startExecution(Real dt);
+		void executePhaseOnTile(size_t phase, size_t tile);
+		void executeBarrier(size_t phase);
+		void buildTaskGraph();
+	};
+}
+#endif //PARTICLE_DYNAMICS_TASK_GRAPH_H
@@ -125,7 +125,7 @@ namespace SPH
 				// displacement from the initial position
 				Vecd pos_final = pos_0_[index_i] + translation_;
 				displacement = (pos_final - pos_n_[index_i]) * dt /
-							   (end_time_ - GlobalStaticVariables::physical_time_);
+							   (end_time_ - PhysicalTime());
 			}
 			catch (out_of_range &e)
 			{
@@ -139,8 +139,8 @@ namespace SPH
 			try
 			{
 				// only apply in the defined time period
-				if (GlobalStaticVariables::physical_time_ >= start_time_ &&
-					GlobalStaticVariables::physical_time_ <= end_time_)
+				if (PhysicalTime() >= start_time_ &&
+					PhysicalTime() <= end_time_)
 				{
 					pos_n_[index_i] = pos_n_[index_i] + getDisplacement(index_i, dt); // displacement from the initial position
 					vel_n_[index_i] = getVelocity();
@@ -173,7 +173,7 @@ namespace SPH
 				// displacement from the initial position
 				Vecd pos_final = pos_0_center_ + end_scale_ * (pos_0_[index_i] - pos_0_center_);
 				displacement = (pos_final - pos_n_[index_i]) * dt /
-							   (end_time_ - GlobalStaticVariables::physical_time_);
+							   (end_time_ - PhysicalTime());
 			}
 			catch (out_of_range &e)
 			{
@@ -187,8 +187,8 @@ namespace SPH
 			try
 			{
 				// only apply in the defined time period
-				if (GlobalStaticVariables::physical_time_ >= start_time_ &&
-					GlobalStaticVariables::physical_time_ <= end_time_)
+				if (PhysicalTime() >= start_time_ &&
+					PhysicalTime() <= end_time_)
 				{
 					pos_n_[index_i] = pos_n_[index_i] + getDisplacement(index_i, dt); // displacement from the initial position
 					vel_n_[index_i] = getVelocity();
@@ -240,7 +240,7 @@ namespace SPH
 			Vecd displacement(0);
 			try
 			{
-				displacement = (pos_end_[index_i] - pos_n_[index_i]) * dt / (end_time_ - GlobalStaticVariables::physical_time_);
+				displacement = (pos_end_[index_i] - pos_n_[index_i]) * dt / (end_time_ - PhysicalTime());
 			}
 			catch (out_of_range &e)
 			{
@@ -252,7 +252,7 @@ namespace SPH
 		void TranslateSolidBody::Update(size_t index_i, Real dt)
 		{
 			// only apply in the defined time period
-			if (GlobalStaticVariables::physical_time_ >= start_time_ && GlobalStaticVariables::physical_time_ <= end_time_)
+			if (PhysicalTime() >= start_time_ && PhysicalTime() <= end_time_)
 			{
 				try
 				{
@@ -279,7 +279,7 @@ namespace SPH
 				Vecd point = pos_0_[index_i];
 				if (checkIfPointInBoundingBox(point, bbox_))
 				{
-					if (GlobalStaticVariables::physical_time_ >= start_time_ && GlobalStaticVariables::physical_time_ <= end_time_)
+					if (PhysicalTime() >= start_time_ && PhysicalTime() <= end_time_)
 					{
 						vel_n_[index_i] = getDisplacement(index_i, dt) / dt;
 					}
@@ -607,7 +607,7 @@ namespace SPH
 		{
 			try
 			{
-				Real time_factor = SMIN(GlobalStaticVariables::physical_time_ / end_time_, 1.0);
+				Real time_factor = SMIN(PhysicalTime() / end_time_, 1.0);
 				dvel_dt_prior_[index_i] = acceleration_ * time_factor;
 			}
 			catch (out_of_range &e)
@@ -650,7 +650,7 @@ namespace SPH
 		Real SurfacePressureFromSource::getPressure()
 		{
 			// check if we have reached the max time, if yes, return the last pressure
-			bool max_time_reached = GlobalStaticVariables::physical_time_ > pressure_over_time_[pressure_over_time_.size() - 1][0];
+			bool max_time_reached = PhysicalTime() > pressure_over_time_[pressure_over_time_.size() - 1][0];
 			if (max_time_reached)
 				return pressure_over_time_[pressure_over_time_.size() - 1][1];
 
@@ -658,7 +658,7 @@ namespace SPH
 			// find out the interval
 			for (size_t i = 0; i < pressure_over_time_.size(); i++)
 			{
-				if (GlobalStaticVariables::physical_time_ < pressure_over_time_[i][0])
+				if (PhysicalTime() < pressure_over_time_[i][0])
 				{
 					interval = i;
 					break;
@@ -673,7 +673,7 @@ namespace SPH
 			Real p_0 = pressure_over_time_[interval - 1][1];
 			Real p_1 = pressure_over_time_[interval][1];
 
-			return p_0 + (p_1 - p_0) * (GlobalStaticVariables::physical_time_ - t_0) / (t_1 - t_0);
+			return p_0 + (p_1 - p_0) * (PhysicalTime() - t_0) / (t_1 - t_0);
 		}
 		//=================================================================================================//
 		void SurfacePressureFromSource::Update(size_t index_i, Real dt)
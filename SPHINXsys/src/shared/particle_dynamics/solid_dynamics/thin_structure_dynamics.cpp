@@ -125,6 +125,11 @@ namespace SPH
 			  F_bending_(particles_->F_bending_), dF_bending_dt_(particles_->dF_bending_dt_),
 			  transformation_matrix_(particles_->transformation_matrix_) {}
 		//=================================================================================================//
+		constexpr Real ThroughThicknessQuadrature<3>::points_[3];
+		constexpr Real ThroughThicknessQuadrature<3>::weights_[3];
+		constexpr Real ThroughThicknessQuadrature<5>::points_[5];
+		constexpr Real ThroughThicknessQuadrature<5>::weights_[5];
+		//=================================================================================================//
 		ShellStressRelaxationFirstHalf::
 			ShellStressRelaxationFirstHalf(BaseBodyRelationInner &inner_relation,
 										   int number_of_gaussian_points)
@@ -140,75 +145,56 @@ namespace SPH
 			  smoothing_length_(sph_adaptation_->ReferenceSmoothingLength())
 		{
 			/** Note that, only three-point and five-point Gaussian quadrature rules are defined. */
-			switch (number_of_gaussian_points)
-			{
-			case 5:
-				gaussian_point_ = five_gaussian_points_;
-				gaussian_weight_ = five_gaussian_weights_;
-				break;
-			default:
-				gaussian_point_ = three_gaussian_points_;
-				gaussian_weight_ = three_gaussian_weights_;
-			}
+			if (number_of_gaussian_points_ != 5)
+				number_of_gaussian_points_ = 3;
 		}
 		//=================================================================================================//
-		void ShellStressRelaxationFirstHalf::Initialization(size_t index_i, Real dt)
+		template <int NumberOfGaussianPoints>
+		void ShellStressRelaxationFirstHalf::
+			integrateThroughThickness(size_t index_i, const Matd &current_transformation_matrix)
 		{
-			// Note that F_[index_i], F_bending_[index_i], dF_dt_[index_i], dF_bending_dt_[index_i]
-			// and rotation_[index_i], angular_vel_[index_i], dangular_vel_dt_[index_i]
-			// are defined in local coordinates, while others in global coordinates.
-			pos_n_[index_i] += vel_n_[index_i] * dt * 0.5;
-			rotation_[index_i] += angular_vel_[index_i] * dt * 0.5;
-			pseudo_n_[index_i] += dpseudo_n_dt_[index_i] * dt * 0.5;
-
-			F_[index_i] += dF_dt_[index_i] * dt * 0.5;
-			F_bending_[index_i] += dF_bending_dt_[index_i] * dt * 0.5;
-			rho_n_[index_i] = rho0_ / det(F_[index_i]);
-
-			/** Calculate the current normal direction of mid-surface. */
-			Matd F_i = F_[index_i];
-			F_i.col(Dimensions - 1) = Vecd(0.0);
-			n_[index_i] = (~transformation_matrix_[index_i]) * getNormalFromDeformationGradientTensor(F_i);
-			/** Get transformation matrix from global coordinates to current local coordinates. */
-			Matd current_transformation_matrix = getTransformationMatrix(n_[index_i]);
+			typedef ThroughThicknessQuadrature<NumberOfGaussianPoints> Quadrature;
+			Real half_thickness = 0.5 * shell_thickness_[index_i];
+			Matd F_bending = F_bending_[index_i] * half_thickness;
+			Matd dF_bending_dt = dF_bending_dt_[index_i] * half_thickness;
+			/** Rotation from initial local coordinates to current local coordinates. */
+			Matd rotation = current_transformation_matrix * (~transformation_matrix_[index_i]);
+			Matd inverse_rotation = ~rotation;
 
 			/** Initialize the local stress to 0. */
 			Matd resultant_stress(0);
 			Matd resultant_moment(0);
 			Vecd resultant_shear_stress(0);
-			for (int i = 0; i != number_of_gaussian_points_; ++i)
+			for (int i = 0; i != NumberOfGaussianPoints; ++i)
 			{
-				Matd F_gaussian_point = F_[index_i] + gaussian_point_[i] * F_bending_[index_i] * shell_thickness_[index_i] * 0.5;
-				Matd dF_gaussian_point_dt = dF_dt_[index_i] + gaussian_point_[i] * dF_bending_dt_[index_i] * shell_thickness_[index_i] * 0.5;
+				Real gaussian_point = Quadrature::points_[i];
+				Matd F_gaussian_point = F_[index_i] + gaussian_point * F_bending;
+				Matd dF_gaussian_point_dt = dF_dt_[index_i] + gaussian_point * dF_bending_dt;
 				Matd stress_PK2_gaussian_point = material_->ConstitutiveRelation(F_gaussian_point, index_i) +
 												 material_->NumericalDampingRightCauchy(F_gaussian_point, dF_gaussian_point_dt, smoothing_length_, index_i);
+				Matd stress_PK1_gaussian_point = F_gaussian_point * stress_PK2_gaussian_point;
 
 				/** Get the mid-surface stress to output the von-Mises equivalent stress. */
 				if (i == 0)
-					stress_PK1_[index_i] = F_gaussian_point * stress_PK2_gaussian_point;
+					stress_PK1_[index_i] = stress_PK1_gaussian_point;
 
-				/** Get Cauchy stress. */
-				Matd cauchy_stress = current_transformation_matrix * (~transformation_matrix_[index_i]) *
-									 F_gaussian_point * stress_PK2_gaussian_point *
-									 (~F_gaussian_point) * transformation_matrix_[index_i] * (~current_transformation_matrix) / det(F_gaussian_point);
+				/** Get Cauchy stress in current local coordinates. */
+				Real J = det(F_gaussian_point);
+				Matd cauchy_stress = rotation * stress_PK1_gaussian_point * (~F_gaussian_point) * inverse_rotation / J;
 
 				/** Impose modeling assumptions. */
 				cauchy_stress.col(Dimensions - 1) *= shear_correction_factor_;
 				cauchy_stress.row(Dimensions - 1) *= shear_correction_factor_;
 				cauchy_stress[Dimensions - 1][Dimensions - 1] = 0.0;
 
-				stress_PK2_gaussian_point = det(F_gaussian_point) * SimTK::inverse(F_gaussian_point) * transformation_matrix_[index_i] *
-											(~current_transformation_matrix) * cauchy_stress * current_transformation_matrix *
-											(~transformation_matrix_[index_i]) * (~SimTK::inverse(F_gaussian_point));
-				Vecd shear_stress_PK2_gaussian_point = -stress_PK2_gaussian_point.col(Dimensions - 1);
-				Matd moment_PK2_gaussian_point = stress_PK2_gaussian_point * gaussian_point_[i] * shell_thickness_[index_i] * 0.5;
-
-				resultant_stress +=
-					0.5 * shell_thickness_[index_i] * gaussian_weight_[i] * F_gaussian_point * stress_PK2_gaussian_point;
-				resultant_moment +=
-					0.5 * shell_thickness_[index_i] * gaussian_weight_[i] * F_gaussian_point * moment_PK2_gaussian_point;
-				resultant_shear_stress +=
-					0.5 * shell_thickness_[index_i] * gaussian_weight_[i] * F_gaussian_point * shear_stress_PK2_gaussian_point;
+				/** First Piola-Kirchhoff stress of the corrected Cauchy stress,
+				 * from which stress, moment and shear stress resultants are obtained. */
+				Matd corrected_stress_PK1 = J * inverse_rotation * cauchy_stress * rotation *
+											(~SimTK::inverse(F_gaussian_point));
+				Real weight = half_thickness * Quadrature::weights_[i];
+				resultant_stress += weight * corrected_stress_PK1;
+				resultant_moment += weight * gaussian_point * half_thickness * corrected_stress_PK1;
+				resultant_shear_stress -= weight * corrected_stress_PK1.col(Dimensions - 1);
 			}
 			/** Only one (for 2D) or two (for 3D) angular momentum equations left. */
 			resultant_moment.col(Dimensions - 1) = Vecd(0);
@@ -223,6 +209,36 @@ namespace SPH
 			global_shear_stress_[index_i] = (~transformation_matrix_[index_i]) * resultant_shear_stress;
 		}
 		//=================================================================================================//
+		void ShellStressRelaxationFirstHalf::Initialization(size_t index_i, Real dt)
+		{
+			// Note that F_[index_i], F_bending_[index_i], dF_dt_[index_i], dF_bending_dt_[index_i]
+			// and rotation_[index_i], angular_vel_[index_i], dangular_vel_dt_[index_i]
+			// are defined in local coordinates, while others in global coordinates.
+			pos_n_[index_i] += vel_n_[index_i] * dt * 0.5;
+			rotation_[index_i] += angular_vel_[index_i] * dt * 0.5;
+			pseudo_n_[index_i] += dpseudo_n_dt_[index_i] * dt * 0.5;
+
+			F_[index_i] += dF_dt_[index_i] * dt * 0.5;
+			F_bending_[index_i] += dF_bending_dt_[index_i] * dt * 0.5;
+			rho_n_[index_i] = rho0_ / det(F_[index_i]);
+
+			/** Calculate the current normal direction of mid-surface. */
+			Matd F_i = F_[index_i];
+			F_i.col(Dimensions - 1) = Vecd(0.0);
+			n_[index_i] = (~transformation_matrix_[index_i]) * getNormalFromDeformationGradientTensor(F_i);
+			/** Get transformation matrix from global coordinates to current local coordinates. */
+			Matd current_transformation_matrix = getTransformationMatrix(n_[index_i]);
+
+			switch (number_of_gaussian_points_)
+			{
+			case 5:
+				integrateThroughThickness<5>(index_i, current_transformation_matrix);
+				break;
+			default:
+				integrateThroughThickness<3>(index_i, current_transformation_matrix);
+			}
+		}
+		//=================================================================================================//
 		void ShellStressRelaxationFirstHalf::Interaction(size_t index_i, Real dt)
 		{
 			const Vecd &global_shear_stress_i = global_shear_stress_[index_i];
@@ -475,7 +491,7 @@ namespace SPH
 		void DistributingAPointForceToShell::getWeight()
 		{
 			sum_of_weight_ = 0.0;
-			Real current_time = GlobalStaticVariables::physical_time_;
+			Real current_time = PhysicalTime();
 			Real h_spacing_ratio_time = current_time * (0.6 - h_spacing_ratio_) / time_to_smallest_h_ratio_ + h_spacing_ratio_;
 			Real h_spacing_ratio = current_time < time_to_smallest_h_ratio_ ? h_spacing_ratio_time : 0.6;
 
@@ -503,7 +519,7 @@ namespace SPH
 		//=================================================================================================//
 		void DistributingAPointForceToShell::getForce()
 		{
-			Real current_time = GlobalStaticVariables::physical_time_;
+			Real current_time = PhysicalTime();
 			point_force_time_ = current_time < time_to_full_external_force_ ? current_time * point_force_ / time_to_full_external_force_ : point_force_;
 		}
 		//=================================================================================================//
@@ -133,6 +133,28 @@ namespace SPH
 			StdLargeVec<Matd> &transformation_matrix_;
 		};
 
+		/**
+		 * @struct ThroughThicknessQuadrature
+		 * @brief Gaussian quadrature for the integration through the shell thickness.
+		 * Note that, only three-point and five-point rules are defined.
+		 */
+		template <int NumberOfPoints>
+		struct ThroughThicknessQuadrature;
+
+		template <>
+		struct ThroughThicknessQuadrature<3>
+		{
+			static constexpr Real points_[3] = {0.0, 0.77459667, -0.77459667};
+			static constexpr Real weights_[3] = {8.0 / 9.0, 5.0 / 9.0, 5.0 / 9.0};
+		};
+
+		template <>
+		struct ThroughThicknessQuadrature<5>
+		{
+			static constexpr Real points_[5] = {0.0, 0.538469, -0.538469, 0.90618, -0.90618};
+			static constexpr Real weights_[5] = {0.568889, 0.478629, 0.478629, 0.236927, 0.236927};
+		};
+
 		/**
 		* @class ShellStressRelaxationFirstHalf
 		* @brief computing stress relaxation process by verlet time stepping
@@ -152,14 +174,12 @@ namespace SPH
 			Real smoothing_length_;
 
 			const Real shear_correction_factor_ = 5.0 / 6.0;
-			const StdVec<Real> three_gaussian_points_ = {0.0, 0.77459667, -0.77459667};
-			const StdVec<Real> three_gaussian_weights_ = {8.0 / 9.0, 5.0 / 9.0, 5.0 / 9.0};
-			const StdVec<Real> five_gaussian_points_ = {0.0, 0.538469, -0.538469, 0.90618, -0.90618};
-			const StdVec<Real> five_gaussian_weights_ = {0.568889, 0.478629, 0.478629, 0.236927, 0.236927};
 			int number_of_gaussian_points_;
-			StdVec<Real> gaussian_point_;
-			StdVec<Real> gaussian_weight_;
 
+			/** integrate the stress, moment and shear stress through the thickness
+			 * with the number of Gaussian points known at compile time. */
+			template <int NumberOfGaussianPoints>
+			void integrateThroughThickness(size_t index_i, const Matd &current_transformation_matrix);
 			virtual void Initialization(size_t index_i, Real dt = 0.0) override;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 			virtual void Update(size_t index_i, Real dt = 0.0) override;
@@ -9,6 +9,7 @@
 #include "base_body.h"
 #include "base_material.h"
 #include "base_particle_generator.h"
+#include "sph_system.h"
 #include "xml_engine.h"
 
 namespace SPH
@@ -22,7 +23,8 @@ namespace SPH
 		  sigma0_(sph_body.sph_adaptation_->ReferenceNumberDensity()),
 		  speed_max_(0.0), signal_speed_max_(0.0),
 		  total_real_particles_(0), real_particles_bound_(0), total_ghost_particles_(0),
-		  sph_body_(&sph_body), body_name_(sph_body.getBodyName()),
+		  sph_body_(&sph_body), task_arena_(sph_body.getSPHSystem().task_arena_),
+		  body_name_(sph_body.getBodyName()),
 		  restart_xml_engine_("xml_restart", "particles"),
 		  reload_xml_engine_("xml_particle_reload", "particles")
 	{
@@ -53,6 +55,9 @@ namespace SPH
 		particle_generator->initialize(&sph_body);
 		particle_generator->createBaseParticles(this);
 		real_particles_bound_ = total_real_particles_;
+		/** the particle data registered above are filled serially while generating the particles */
+		if (parallelFirstTouch())
+			placeParticleDataInParallel();
 
 		sph_body.sph_adaptation_->assignBaseParticles(this);
 		base_material_->assignBaseParticles(this);
@@ -91,6 +96,20 @@ namespace SPH
 			addAParticleEntry();
 		}
 		real_particles_bound_ += buffer_size;
+		if (parallelFirstTouch())
+			placeParticleDataInParallel();
+	}
+	//=================================================================================================//
+	void BaseParticles::placeParticleDataInParallel()
+	{
+		task_arena_.execute(
+			[&]()
+			{
+				place_a_particle_data_in_parallel_(all_particle_data_);
+				placePagesInParallel(sequence_);
+				placePagesInParallel(sorted_id_);
+				placePagesInParallel(unsorted_id_);
+			});
 	}
 	//=================================================================================================//
 	void BaseParticles::copyFromAnotherParticle(size_t this_index, size_t another_index)
@@ -105,32 +124,118 @@ namespace SPH
 	//=================================================================================================//
 	size_t BaseParticles::insertAGhostParticle(size_t index_i)
 	{
-		total_ghost_particles_ += 1;
+		size_t expected_particle_index = reserveGhostParticles(1);
+		copyToAGhostParticle(expected_particle_index, index_i);
+		return expected_particle_index;
+	}
+	//=================================================================================================//
+	size_t BaseParticles::reserveGhostParticles(size_t number_of_ghosts)
+	{
+		size_t ghost_start = real_particles_bound_ + total_ghost_particles_;
+		total_ghost_particles_ += number_of_ghosts;
 		size_t expected_size = real_particles_bound_ + total_ghost_particles_;
-		size_t expected_particle_index = expected_size - 1;
-		if (expected_size <= pos_n_.size())
-		{
-			copyFromAnotherParticle(expected_particle_index, index_i);
-			/** For a ghost particle, its sorted id is that of corresponding real particle. */
-			sorted_id_[expected_particle_index] = index_i;
-		}
-		else
+		while (pos_n_.size() < expected_size)
 		{
 			addAParticleEntry();
-			copyFromAnotherParticle(expected_particle_index, index_i);
-			/** For a ghost particle, its sorted id is that of corresponding real particle. */
-			sorted_id_[expected_particle_index] = index_i;
 		}
-		return expected_particle_index;
+		return ghost_start;
+	}
+	//=================================================================================================//
+	void BaseParticles::copyToAGhostParticle(size_t ghost_index, size_t index_i)
+	{
+		copyFromAnotherParticle(ghost_index, index_i);
+		/** For a ghost particle, its sorted id is that of corresponding real particle. */
+		sorted_id_[ghost_index] = index_i;
 	}
 	//=================================================================================================//
 	void BaseParticles::switchToBufferParticle(size_t index_i)
 	{
 		size_t last_real_particle_index = total_real_particles_ - 1;
 		updateFromAnotherParticle(index_i, last_real_particle_index);
-		unsorted_id_[index_i] = unsorted_id_[last_real_particle_index];
+		std::swap(unsorted_id_[index_i], unsorted_id_[last_real_particle_index]);
+		sorted_id_[unsorted_id_[index_i]] = index_i;
+		sorted_id_[unsorted_id_[last_real_particle_index]] = last_real_particle_index;
 		total_real_particles_ -= 1;
 	}
+	//=================================================================================================//
+	void BaseParticles::gatherParticleRequests(ThreadLocalIndexVectors &requests, IndexVector &gathered_requests)
+	{
+		gathered_requests.clear();
+		for (IndexVector &local_requests : requests)
+		{
+			gathered_requests.insert(gathered_requests.end(), local_requests.begin(), local_requests.end());
+			local_requests.clear();
+		}
+		/** sorted for results independent of thread scheduling */
+		std::sort(gathered_requests.begin(), gathered_requests.end());
+		gathered_requests.erase(std::unique(gathered_requests.begin(), gathered_requests.end()),
+								gathered_requests.end());
+	}
+	//=================================================================================================//
+	const IndexVector &BaseParticles::spawnRequestedParticles()
+	{
+		gatherParticleRequests(spawn_requests_, spawned_particles_);
+		size_t spawn_start = total_real_particles_;
+		if (spawn_start + spawned_particles_.size() > real_particles_bound_)
+		{
+			std::cout << "\n Error: not enough buffer particles for " << spawned_particles_.size()
+					  << " new particles in " << body_name_ << "!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		total_real_particles_ += spawned_particles_.size();
+
+		parallel_for(
+			blocked_range<size_t>(0, spawned_particles_.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t k = r.begin(); k != r.end(); ++k)
+				{
+					size_t new_particle_index = spawn_start + k;
+					copyFromAnotherParticle(new_particle_index, spawned_particles_[k]);
+					sorted_id_[unsorted_id_[new_particle_index]] = new_particle_index;
+				}
+			},
+			ap);
+		return spawned_particles_;
+	}
+	//=================================================================================================//
+	void BaseParticles::deleteRequestedParticles()
+	{
+		gatherParticleRequests(delete_requests_, deleted_particles_);
+		size_t new_total_real_particles = total_real_particles_ - deleted_particles_.size();
+
+		/** deleted particles before the new bound are filled by the remaining particles after it */
+		size_t number_of_holes = std::lower_bound(deleted_particles_.begin(), deleted_particles_.end(),
+												  new_total_real_particles) -
+								 deleted_particles_.begin();
+		IndexVector remaining_particles;
+		size_t deleted_in_tail = number_of_holes;
+		for (size_t i = new_total_real_particles; i != total_real_particles_; ++i)
+		{
+			if (deleted_in_tail < deleted_particles_.size() && deleted_particles_[deleted_in_tail] == i)
+				++deleted_in_tail;
+			else
+				remaining_particles.push_back(i);
+		}
+
+		parallel_for(
+			blocked_range<size_t>(0, number_of_holes),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t k = r.begin(); k != r.end(); ++k)
+				{
+					size_t hole = deleted_particles_[k];
+					size_t remaining = remaining_particles[k];
+					updateFromAnotherParticle(hole, remaining);
+					std::swap(unsorted_id_[hole], unsorted_id_[remaining]);
+					sorted_id_[unsorted_id_[hole]] = hole;
+					sorted_id_[unsorted_id_[remaining]] = remaining;
+				}
+			},
+			ap);
+		total_real_particles_ = new_total_real_particles;
+	}
 //=================================================================================================//
 	void BaseParticles::writeParticlesToVtuFile(std::ostream& output_file)
 	{
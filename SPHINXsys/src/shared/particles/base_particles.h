@@ -33,11 +33,14 @@
 
 #include "base_data_package.h"
 #include "sph_data_containers.h"
+#include "component_major_data.h"
 #include "base_material.h"
 #include "xml_engine.h"
 
 #include <fstream>
 
+#include "tbb/task_arena.h"
+
 namespace SPH
 {
 
@@ -125,6 +128,12 @@ namespace SPH
 		void registerAVariable(StdLargeVec<VariableType> &variable_addrs,
 							   const std::string &new_variable_name, const std::string &old_variable_name);
 
+		/** register a vector or matrix variable stored in component-major order.
+		 *  Each component is registered as a scalar variable named by the variable name and the component index. */
+		template <typename VariableType>
+		void registerAVariable(ComponentMajorVariable<VariableType> &variable_addrs,
+							   const std::string &variable_name, VariableType initial_value = VariableType(0));
+
 		/** get a registered variable from particles by its name. return by pointer so that return nullptr if fail. */
 		template <int DataTypeIndex, typename VariableType>
 		StdLargeVec<VariableType> *getVariableByName(std::string variable_name);
@@ -154,14 +163,38 @@ namespace SPH
 		template <int DataTypeIndex, typename VariableType>
 		void registerASortableVariable(std::string variable_name);
 
+		/** register all components of an already defined component-major variable as sortable */
+		template <typename VariableType>
+		void registerASortableVariable(ComponentMajorVariable<VariableType> &variable_addrs);
+
 		SPHBody *getSPHBody() { return sph_body_; };
 		void initializeABaseParticle(Vecd pnt, Real Vol_0);
 		void addBufferParticles(size_t buffer_size);
+		/** Move the pages of all particle data to the memory nodes of the threads iterating them,
+		 *  for the data filled serially, done by the threads of the task arena of the SPH system,
+		 *  see SPHSystem::useNumaAwareExecution. */
+		void placeParticleDataInParallel();
 		void copyFromAnotherParticle(size_t this_index, size_t another_index);
 		void updateFromAnotherParticle(size_t this_index, size_t another_index);
 		size_t insertAGhostParticle(size_t index_i);
+		/** Reserve a contiguous range of ghost particles and return the index of the first one. */
+		size_t reserveGhostParticles(size_t number_of_ghosts);
+		/** Copy a real particle to a reserved ghost particle. Concurrent calls must use different ghosts. */
+		void copyToAGhostParticle(size_t ghost_index, size_t index_i);
 		void switchToBufferParticle(size_t index_i);
 
+		/** Request a copy of a real particle to be realized from a buffer particle.
+		 * Requests may be issued concurrently and are realized by spawnRequestedParticles. */
+		void requestToSpawnParticle(size_t index_i) { spawn_requests_.local().push_back(index_i); };
+		/** Request a real particle to be switched to a buffer particle.
+		 * Requests may be issued concurrently and are realized by deleteRequestedParticles. */
+		void requestToDeleteParticle(size_t index_i) { delete_requests_.local().push_back(index_i); };
+		/** Realize all spawn requests in one range of buffer particles.
+		 * Returns the sorted indexes of the particles which have been copied. */
+		const IndexVector &spawnRequestedParticles();
+		/** Realize all delete requests by compacting the real particles. */
+		void deleteRequestedParticles();
+
 
 		/** Write particle data in Vtu format for Paraview. */
 		virtual void writeParticlesToVtuFile(std::ostream& output_file);
@@ -192,12 +225,18 @@ namespace SPH
 
 	protected:
 		SPHBody *sph_body_; /**< The body in which the particles belongs to. */
+		tbb::task_arena &task_arena_; /**< The threads of the SPH system, by which the particle data are first touched. */
 		std::string body_name_;
 		XmlEngine restart_xml_engine_;
 		XmlEngine reload_xml_engine_;
 		ParticleVariableList variables_to_write_;
 		ParticleVariableList variables_to_restart_;
+		ThreadLocalIndexVectors spawn_requests_;
+		ThreadLocalIndexVectors delete_requests_;
+		IndexVector spawned_particles_;
+		IndexVector deleted_particles_;
 		void addAParticleEntry();
+		void gatherParticleRequests(ThreadLocalIndexVectors &requests, IndexVector &gathered_requests);
 
 		virtual void writePltFileHeader(std::ofstream &output_file);
 		virtual void writePltFileParticleData(std::ofstream &output_file, size_t index_i);
@@ -216,8 +255,16 @@ namespace SPH
 			void operator()(ParticleData &particle_data, size_t this_index, size_t another_index) const;
 		};
 
+		/** Move the pages of a particle variable to the threads iterating them. */
+		template <int DataTypeIndex, typename VariableType>
+		struct placeAParticleDataInParallel
+		{
+			void operator()(ParticleData &particle_data) const;
+		};
+
 		ParticleDataOperation<addAParticleDataValue> add_a_particle_value_;
 		ParticleDataOperation<copyAParticleDataValue> copy_a_particle_value_;
+		ParticleDataOperation<placeAParticleDataInParallel> place_a_particle_data_in_parallel_;
 	};
 
 	struct WriteAParticleVariableToXml
@@ -41,6 +41,9 @@ namespace SPH
     {
         if (all_variable_maps_[DataTypeIndex].find(variable_name) == all_variable_maps_[DataTypeIndex].end())
         {
+            if (parallelFirstTouch())
+                task_arena_.execute([&]()
+                                    { touchPagesInParallel(variable_addrs, real_particles_bound_); });
             variable_addrs.resize(real_particles_bound_, initial_value);
             std::get<DataTypeIndex>(all_particle_data_).push_back(&variable_addrs);
             all_variable_maps_[DataTypeIndex].insert(make_pair(variable_name, std::get<DataTypeIndex>(all_particle_data_).size() - 1));
@@ -75,6 +78,19 @@ namespace SPH
         }
     }
     //=================================================================================================//
+    template <typename VariableType>
+    void BaseParticles::
+        registerAVariable(ComponentMajorVariable<VariableType> &variable_addrs,
+                          const std::string &variable_name, VariableType initial_value)
+    {
+        variable_addrs.name_ = variable_name;
+        for (int k = 0; k != ComponentMajorVariable<VariableType>::number_of_components; ++k)
+        {
+            registerAVariable<indexScalar, Real>(variable_addrs.component(k), variable_name + "_" + std::to_string(k),
+                                                 ComponentMajorTraits<VariableType>::component(initial_value, k));
+        }
+    }
+    //=================================================================================================//
     template <int DataTypeIndex, typename VariableType>
     StdLargeVec<VariableType> *BaseParticles::getVariableByName(std::string variable_name)
     {
@@ -151,6 +167,13 @@ namespace SPH
         }
     }
     //=================================================================================================//
+    template <typename VariableType>
+    void BaseParticles::registerASortableVariable(ComponentMajorVariable<VariableType> &variable_addrs)
+    {
+        for (int k = 0; k != ComponentMajorVariable<VariableType>::number_of_components; ++k)
+            registerASortableVariable<indexScalar, Real>(variable_addrs.name_ + "_" + std::to_string(k));
+    }
+    //=================================================================================================//
     template <int DataTypeIndex, typename VariableType>
     void BaseParticles::addAParticleDataValue<DataTypeIndex, VariableType>::
     operator()(ParticleData &particle_data) const
@@ -168,6 +191,14 @@ namespace SPH
                 (*std::get<DataTypeIndex>(particle_data)[i])[another_index];
     }
     //=================================================================================================//
+    template <int DataTypeIndex, typename VariableType>
+    void BaseParticles::placeAParticleDataInParallel<DataTypeIndex, VariableType>::
+    operator()(ParticleData &particle_data) const
+    {
+        for (size_t i = 0; i != std::get<DataTypeIndex>(particle_data).size(); ++i)
+            placePagesInParallel(*std::get<DataTypeIndex>(particle_data)[i]);
+    }
+    //=================================================================================================//
     template <typename VariableType>
     void WriteAParticleVariableToXml::
     operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const
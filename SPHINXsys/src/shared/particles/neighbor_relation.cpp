@@ -15,20 +15,29 @@ namespace SPH
 	{
 		current_size_--;
 		j_[neighbor_n] = j_[current_size_];
-		W_ij_[neighbor_n] = W_ij_[current_size_];
-		dW_ij_[neighbor_n] = dW_ij_[current_size_];
-		r_ij_[neighbor_n] = r_ij_[current_size_];
-		e_ij_[neighbor_n] = e_ij_[current_size_];
+		/** the fields not stored are left empty */
+		if (!W_ij_.empty())
+			W_ij_[neighbor_n] = W_ij_[current_size_];
+		if (!dW_ij_.empty())
+			dW_ij_[neighbor_n] = dW_ij_[current_size_];
+		if (!r_ij_.empty())
+			r_ij_[neighbor_n] = r_ij_[current_size_];
+		if (!e_ij_.empty())
+			e_ij_[neighbor_n] = e_ij_[current_size_];
 	}
 	//=================================================================================================//
 	void NeighborRelation::createRelation(Neighborhood &neighborhood,
 										  Real &distance, Vecd &displacement, size_t j_index) const
 	{
 		neighborhood.j_.push_back(j_index);
-		neighborhood.W_ij_.push_back(kernel_->W(distance, displacement));
-		neighborhood.dW_ij_.push_back(kernel_->dW(distance, displacement));
-		neighborhood.r_ij_.push_back(distance);
-		neighborhood.e_ij_.push_back(displacement / (distance + TinyReal));
+		if (storage_policy_.store_W_ij_)
+			neighborhood.W_ij_.push_back(kernel_->W(distance, displacement));
+		if (storage_policy_.store_dW_ij_)
+			neighborhood.dW_ij_.push_back(kernel_->dW(distance, displacement));
+		if (storage_policy_.store_r_ij_)
+			neighborhood.r_ij_.push_back(distance);
+		if (storage_policy_.store_e_ij_)
+			neighborhood.e_ij_.push_back(displacement / (distance + TinyReal));
 		neighborhood.allocated_size_++;
 	}
 	//=================================================================================================//
@@ -37,10 +46,14 @@ namespace SPH
 	{
 		size_t current_size = neighborhood.current_size_;
 		neighborhood.j_[current_size] = j_index;
-		neighborhood.W_ij_[current_size] = kernel_->W(distance, displacement);
-		neighborhood.dW_ij_[current_size] = kernel_->dW(distance, displacement);
-		neighborhood.r_ij_[current_size] = distance;
-		neighborhood.e_ij_[current_size] = displacement / (distance + TinyReal);
+		if (storage_policy_.store_W_ij_)
+			neighborhood.W_ij_[current_size] = kernel_->W(distance, displacement);
+		if (storage_policy_.store_dW_ij_)
+			neighborhood.dW_ij_[current_size] = kernel_->dW(distance, displacement);
+		if (storage_policy_.store_r_ij_)
+			neighborhood.r_ij_[current_size] = distance;
+		if (storage_policy_.store_e_ij_)
+			neighborhood.e_ij_[current_size] = displacement / (distance + TinyReal);
 	}
 	//=================================================================================================//
 	void NeighborRelation::createRelation(Neighborhood &neighborhood, Real &distance,
@@ -193,5 +206,24 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	void NeighborCandidate::operator()(Neighborhood &candidates,
+									   Vecd &displacement, size_t i_index, size_t j_index) const
+	{
+		if (displacement.norm() < search_radius_ && (!is_inner_ || i_index != j_index))
+		{
+			size_t current_size = candidates.current_size_;
+			if (current_size >= candidates.allocated_size_)
+			{
+				candidates.j_.push_back(j_index);
+				candidates.allocated_size_++;
+			}
+			else
+			{
+				candidates.j_[current_size] = j_index;
+			}
+			candidates.current_size_++;
+		}
+	}
+	//=================================================================================================//
 }
 //=================================================================================================//
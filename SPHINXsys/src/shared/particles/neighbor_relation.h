@@ -62,6 +62,28 @@ namespace SPH
 		void removeANeighbor(size_t neighbor_n);
 	};
 
+	/**
+	 * @struct NeighborStoragePolicy
+	 * @brief Choosing the pair fields stored in the neighborhoods of a relation.
+	 * The indexes of the neighbors are always stored.
+	 * The fields not stored are evaluated on the fly by the dynamics,
+	 * which is often cheaper than streaming them from memory on bandwidth-bound hardware.
+	 */
+	struct NeighborStoragePolicy
+	{
+		bool store_W_ij_;
+		bool store_dW_ij_;
+		bool store_r_ij_;
+		bool store_e_ij_;
+
+		explicit NeighborStoragePolicy(bool store_W_ij = true, bool store_dW_ij = true,
+									   bool store_r_ij = true, bool store_e_ij = true)
+			: store_W_ij_(store_W_ij), store_dW_ij_(store_dW_ij),
+			  store_r_ij_(store_r_ij), store_e_ij_(store_e_ij){};
+
+		bool isStoringAll() const { return store_W_ij_ && store_dW_ij_ && store_r_ij_ && store_e_ij_; };
+	};
+
 	/** Inner neighborhoods for all particles in a body for a inner body relation. */
 	using ParticleConfiguration = StdLargeVec<Neighborhood>;
 	/** All contact neighborhoods for all particles in a body for a contact body relation. */
@@ -75,6 +97,7 @@ namespace SPH
 	{
 	protected:
 		Kernel *kernel_;
+		NeighborStoragePolicy storage_policy_; /**< only applied for constant smoothing length */
 		//----------------------------------------------------------------------
 		//	Below are for constant smoothing length.
 		//----------------------------------------------------------------------
@@ -93,6 +116,8 @@ namespace SPH
 	public:
 		NeighborRelation() : kernel_(nullptr){};
 		virtual ~NeighborRelation(){};
+
+		void setStoragePolicy(const NeighborStoragePolicy &storage_policy) { storage_policy_ = storage_policy; };
 	};
 
 	/**
@@ -180,5 +205,24 @@ namespace SPH
 	protected:
 		StdLargeVec<int> part_indicator_; /**< indicator of the body part */
 	};
+
+	/**
+	 * @class NeighborCandidate
+	 * @brief A functor for collecting the neighbor candidates of a particle within a search radius,
+	 * which is the cutoff radius plus a skin. Only the indexes of the candidates are saved.
+	 */
+	class NeighborCandidate
+	{
+	public:
+		NeighborCandidate(Real search_radius, bool is_inner)
+			: search_radius_(search_radius), is_inner_(is_inner){};
+		virtual ~NeighborCandidate(){};
+		void operator()(Neighborhood &candidates,
+						Vecd &displacement, size_t i_index, size_t j_index) const;
+
+	protected:
+		Real search_radius_;
+		bool is_inner_; /**< whether the particle itself is excluded */
+	};
 }
 #endif //NEIGHBOR_RELATION_H
\ No newline at end of file
@@ -37,32 +37,70 @@ namespace SPH
 	//=================================================================================================//
 	template<class ObserveMethodType>
 	StdVec<Real> RegressionTestDynamicTimeWarping<ObserveMethodType>::calculateDTWDistance
-	(DoubleVec<VariableType> dataset_a_, DoubleVec<VariableType> dataset_b_)
+	(const DoubleVec<VariableType> &dataset_a_, const DoubleVec<VariableType> &dataset_b_)
 	{
 		/* define the container to hold the dtw distance.*/
-		StdVec<Real> dtw_distance;
-		for (int n = 0; n != this->j_; ++n)
+		StdVec<Real> dtw_distance(this->j_, 0);
+		parallel_for(blocked_range<int>(0, this->j_),
+			[&](const blocked_range<int> &r) {
+				for (int n = r.begin(); n != r.end(); ++n)
+					dtw_distance[n] = calculateBandedDTWDistance(dataset_a_[n], dataset_b_[n]);
+			});
+		return dtw_distance;
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	Real RegressionTestDynamicTimeWarping<ObserveMethodType>::calculateBandedDTWDistance
+	(const StdVec<VariableType> &line_a, const StdVec<VariableType> &line_b)
+	{
+		int a_length = line_a.size();
+		int b_length = line_b.size();
+		/** add locality constraint. */
+		int window_size = SMAX(5, ABS(a_length - b_length));
+
+		/** the first row is accumulated without constraint. */
+		int first_row_length = SMIN(b_length, window_size + 1);
+		StdVec<Real> previous_row(first_row_length, 0), current_row;
+		previous_row[0] = calculatePNorm(line_a[0], line_b[0]);
+		for (int j = 1; j < first_row_length; ++j)
+			previous_row[j] = previous_row[j - 1] + calculatePNorm(line_a[0], line_b[j]);
+		if (a_length == 1)
+		{
+			Real distance = previous_row.back();
+			for (int j = first_row_length; j < b_length; ++j)
+				distance += calculatePNorm(line_a[0], line_b[j]);
+			return distance;
+		}
+
+		/** each row keeps its first column and the values in [lower, upper), others are zero. */
+		int previous_lower = 0;
+		int previous_upper = first_row_length;
+		Real previous_first = previous_row[0];
+		auto previousValue = [&](int j) -> Real
 		{
-			int window_size_ = 5;
-			int a_length = dataset_a_[n].size();
-			int b_length = dataset_b_[n].size();
-			/** create a 2D vector with [a_length, b_length] to contain the local DTW distance value. */
-			DoubleVec<Real> local_dtw_distance(a_length, StdVec<Real>(b_length, 0));
-			local_dtw_distance[0][0] = calculatePNorm(dataset_a_[n][0], dataset_b_[n][0]);
-			for (int i = 1; i < a_length; ++i)
-				local_dtw_distance[i][0] = local_dtw_distance[i - 1][0] + calculatePNorm(dataset_a_[n][i], dataset_b_[n][0]);
-			for (int j = 1; j < b_length; ++j)
-				local_dtw_distance[0][j] = local_dtw_distance[0][j - 1] + calculatePNorm(dataset_a_[n][0], dataset_b_[n][j]);
+			if (j == 0)
+				return previous_first;
+			return j >= previous_lower && j < previous_upper ? previous_row[j - previous_lower] : 0.0;
+		};
 
-			/** add locality constraint */
-			window_size_ = SMAX(window_size_, ABS(a_length - b_length));
-			for (int i = 1; i != a_length; ++i)
-				for (int j = SMAX(1, i - window_size_); j != SMIN(b_length, i + window_size_); ++j)
-					local_dtw_distance[i][j] = calculatePNorm(dataset_a_[n][i], dataset_b_[n][j]) +
-						SMIN(local_dtw_distance[i - 1][j], local_dtw_distance[i][j - 1], local_dtw_distance[i - 1][j - 1]);
-			dtw_distance.push_back(local_dtw_distance[a_length - 1][b_length - 1]);
+		for (int i = 1; i != a_length; ++i)
+		{
+			Real current_first = previous_first + calculatePNorm(line_a[i], line_b[0]);
+			int lower = SMAX(1, i - window_size);
+			int upper = SMIN(b_length, i + window_size);
+			current_row.assign(SMAX(upper - lower, 0), 0);
+			for (int j = lower; j < upper; ++j)
+			{
+				Real left = j - 1 >= lower ? current_row[j - 1 - lower] : (j == 1 ? current_first : 0.0);
+				current_row[j - lower] = calculatePNorm(line_a[i], line_b[j]) +
+					SMIN(previousValue(j), left, previousValue(j - 1));
+			}
+			previous_row.swap(current_row);
+			previous_lower = lower;
+			previous_upper = upper;
+			previous_first = current_first;
 		}
-		return dtw_distance;
+		return previousValue(b_length - 1);
 	};
 	//=================================================================================================//
 	template<class ObserveMethodType>
@@ -56,8 +56,11 @@ namespace SPH
 		Real calculatePNorm(Vecd variable_a, Vecd variable_b);
 		Real calculatePNorm(Matd variable_a, Matd variable_b);
 
-		/** the local constrained method used for calculating the dtw distance between two lines. */
-		StdVec<Real> calculateDTWDistance(DoubleVec<VariableType> dataset_a_, DoubleVec<VariableType> dataset_b_);
+		/** the local constrained method used for calculating the dtw distance between two lines, 
+		  * the observation points are computed in parallel. */
+		StdVec<Real> calculateDTWDistance(const DoubleVec<VariableType> &dataset_a_, const DoubleVec<VariableType> &dataset_b_);
+		/** the dtw distance of a single observation point, only the rows within the window are kept. */
+		Real calculateBandedDTWDistance(const StdVec<VariableType> &line_a, const StdVec<VariableType> &line_b);
 
 	public:
 		template<typename... ConstructorArgs>
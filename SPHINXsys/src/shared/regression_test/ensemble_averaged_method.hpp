@@ -197,7 +197,7 @@ namespace SPH
 					std::cout << __FILE__ << ':' << __LINE__ << std::endl;
 					exit(1);
 				}
-				else
+				else if (!this->isBinaryUpToDate(this->result_filefullpath_))
 					this->result_xml_engine_in_.loadXmlFile(this->result_filefullpath_);
 			}
 
@@ -62,13 +62,15 @@ namespace SPH
 		 int number_of_run_;                         /* the times of run. */
 		 int label_for_repeat_;                      /* the label for stable convergence. */
 		 int number_of_snapshot_old_;                /* the snapshot size of existed result. */
+		 bool is_binary_result_read_;                /* whether the last result was read from the binary store. */
 		 
 	 public:
 		 template<typename... ConstructorArgs>
 		 explicit RegressionTestBase(ConstructorArgs &&...args) :
 			 ObserveMethodType(std::forward<ConstructorArgs>(args)...), xmlmemory_io_(),
 			 result_xml_engine_in_("result_xml_engine_in", "result"),
-			 result_xml_engine_out_("result_xml_engine_out", "result")
+			 result_xml_engine_out_("result_xml_engine_out", "result"),
+			 is_binary_result_read_(false)
 		 {
 			 input_folder_path_ = this->in_output_.input_folder_;
 			 result_filefullpath_ = input_folder_path_ + "/" + this->body_name_
@@ -99,6 +101,20 @@ namespace SPH
 		 void readResultFromXml(int index_of_run_); /* read the result from the .xml file with the index. */
 		 void writeResultToXml(int index_of_run_); /* write the result to the .xml file with the index. */
 
+		 /** 
+		  * the compact binary store written after the .xml result file, and read instead when it is up to date.
+		  * The store begins with a stamp of the format and of the size and content hash of the .xml file,
+		  * so that an edited or replaced .xml file is read again.
+		  */
+		 std::string binaryFilePath(const std::string &xml_filefullpath);
+		 bool isBinaryUpToDate(const std::string &xml_filefullpath);
+		 bool isBinaryResultRead() { return is_binary_result_read_; };
+		 uint64_t hashXmlFile(const std::string &xml_filefullpath);
+		 void writeBinaryStamp(std::ofstream &out_file, const std::string &xml_filefullpath);
+		 bool readBinaryStamp(std::ifstream &in_file, const std::string &xml_filefullpath);
+		 void writeBlockToBinary(std::ofstream &out_file, const DoubleVec<VariableType> &block, int rows, int columns);
+		 void readBlockFromBinary(std::ifstream &in_file, DoubleVec<VariableType> &block);
+
 		 /** the interface to write observed quantity into xml memory. */
 		 void writeToFile(size_t iteration = 0) override
 		 {
@@ -109,7 +125,7 @@ namespace SPH
 		 /** the interface to write xml memory into Xml file. */
 		 void writeXmlToXmlFile()
 		 {
-			 this->observe_xml_engine_.writeToXmlFile(this->filefullpath_input_);
+			 ObserveMethodType::writeXmlToXmlFile();
 		 };
 
 		 /** read current result from Xml file from Xml memory. */
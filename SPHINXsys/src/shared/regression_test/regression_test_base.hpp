@@ -26,6 +26,23 @@ namespace SPH
 	{
 		if (number_of_run_ > 1)
 		{
+			std::ifstream in_file(binaryFilePath(result_filefullpath_), std::ios::in | std::ios::binary);
+			is_binary_result_read_ = readBinaryStamp(in_file, result_filefullpath_);
+			if (is_binary_result_read_)
+			{
+				for (int run_n_ = 0; run_n_ != number_of_run_ - 1; ++run_n_)
+				{
+					DoubleVec<VariableType> result_temp_;
+					readBlockFromBinary(in_file, result_temp_);
+					result_temp_.resize(SMIN(i_, number_of_snapshot_old_)); /* Unify the length of all results. (number of snapshots)*/
+					result_.push_back(result_temp_);
+				}
+				in_file.close();
+				result_.push_back(this->current_result_);
+				return;
+			}
+			in_file.close();
+
 			DoubleVec<VariableType> result_in_(SMAX(i_, number_of_snapshot_old_), StdVec<VariableType>(j_));
 			for (int run_n_ = 0; run_n_ != number_of_run_ - 1; ++run_n_)
 			{
@@ -55,6 +72,12 @@ namespace SPH
 				SMIN(i_, number_of_snapshot_old_), j_, this->quantity_name_, this->element_tag_);
 		}
 		result_xml_engine_out_.writeToXmlFile(result_filefullpath_);
+
+		std::ofstream out_file(binaryFilePath(result_filefullpath_), std::ios::out | std::ios::binary);
+		writeBinaryStamp(out_file, result_filefullpath_);
+		for (int run_n_ = 0; run_n_ != number_of_run_; ++run_n_)
+			writeBlockToBinary(out_file, result_[run_n_], SMIN(i_, number_of_snapshot_old_), j_);
+		out_file.close();
 	};
 	//=================================================================================================//
 	template<class ObserveMethodType>
@@ -76,6 +99,17 @@ namespace SPH
 				}
 			}
 
+			std::ifstream in_file(binaryFilePath(result_filefullpath_), std::ios::in | std::ios::binary);
+			is_binary_result_read_ = readBinaryStamp(in_file, result_filefullpath_);
+			if (is_binary_result_read_)
+			{
+				readBlockFromBinary(in_file, result_in_);
+				in_file.close();
+				i_ = result_in_[0].size();
+				return;
+			}
+			in_file.close();
+
 			result_xml_engine_in_.loadXmlFile(result_filefullpath_);
 			SimTK::Xml::Element snapshot_element_ = result_xml_engine_in_.getChildElement("Snapshot_Element");
 			SimTK::Xml::element_iterator ele_ite = snapshot_element_.element_begin();
@@ -105,6 +139,7 @@ namespace SPH
 		int total_snapshot_ = current_result_ji_[0].size();
 		result_filefullpath_ = input_folder_path_ + "/" + this->body_name_ + "_" + this->quantity_name_ +
 			"_Run_" + std::to_string(index_of_run_) + "_result.xml";
+
 		result_xml_engine_out_.addElementToXmlDoc("Snapshot_Element");
 		SimTK::Xml::Element snapshot_element_ = result_xml_engine_out_.getChildElement("Snapshot_Element");
 		result_xml_engine_out_.addChildToElement(snapshot_element_, "Snapshot");
@@ -125,6 +160,97 @@ namespace SPH
 			}
 		}
 		result_xml_engine_out_.writeToXmlFile(result_filefullpath_);
+
+		std::ofstream out_file(binaryFilePath(result_filefullpath_), std::ios::out | std::ios::binary);
+		writeBinaryStamp(out_file, result_filefullpath_);
+		writeBlockToBinary(out_file, current_result_ji_, j_, total_snapshot_);
+		out_file.close();
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	std::string RegressionTestBase<ObserveMethodType>::binaryFilePath(const std::string &xml_filefullpath)
+	{
+		return xml_filefullpath.substr(0, xml_filefullpath.find_last_of('.')) + ".dat";
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	bool RegressionTestBase<ObserveMethodType>::isBinaryUpToDate(const std::string &xml_filefullpath)
+	{
+		std::ifstream in_file(binaryFilePath(xml_filefullpath), std::ios::in | std::ios::binary);
+		bool is_up_to_date = readBinaryStamp(in_file, xml_filefullpath);
+		in_file.close();
+		return is_up_to_date;
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	uint64_t RegressionTestBase<ObserveMethodType>::hashXmlFile(const std::string &xml_filefullpath)
+	{
+		/** FNV-1a hash of the bytes, much cheaper than parsing the .xml file. */
+		uint64_t hash = 14695981039346656037ULL;
+		std::ifstream in_file(xml_filefullpath, std::ios::in | std::ios::binary);
+		char buffer[4096];
+		while (in_file.read(buffer, sizeof(buffer)) || in_file.gcount() > 0)
+		{
+			for (std::streamsize n = 0; n != in_file.gcount(); ++n)
+			{
+				hash ^= (unsigned char)buffer[n];
+				hash *= 1099511628211ULL;
+			}
+		}
+		return hash;
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestBase<ObserveMethodType>::
+		writeBinaryStamp(std::ofstream &out_file, const std::string &xml_filefullpath)
+	{
+		uint32_t format[3] = {0x53504852, 1, sizeof(VariableType)}; /* "SPHR", version and value size. */
+		uint64_t xml_size = fs::file_size(xml_filefullpath);
+		uint64_t xml_hash = hashXmlFile(xml_filefullpath);
+		out_file.write((const char *)format, sizeof(format));
+		out_file.write((const char *)&xml_size, sizeof(uint64_t));
+		out_file.write((const char *)&xml_hash, sizeof(uint64_t));
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	bool RegressionTestBase<ObserveMethodType>::
+		readBinaryStamp(std::ifstream &in_file, const std::string &xml_filefullpath)
+	{
+		if (!in_file.is_open() || !fs::exists(xml_filefullpath))
+			return false;
+
+		uint32_t format[3] = {0, 0, 0};
+		uint64_t xml_size = 0;
+		uint64_t xml_hash = 0;
+		in_file.read((char *)format, sizeof(format));
+		in_file.read((char *)&xml_size, sizeof(uint64_t));
+		in_file.read((char *)&xml_hash, sizeof(uint64_t));
+		if (!in_file || format[0] != 0x53504852 || format[1] != 1 || format[2] != sizeof(VariableType))
+			return false;
+		/** the .xml file may have been replaced, e.g. by updating the reference data. */
+		return xml_size == uint64_t(fs::file_size(xml_filefullpath)) && xml_hash == hashXmlFile(xml_filefullpath);
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestBase<ObserveMethodType>::
+		writeBlockToBinary(std::ofstream &out_file, const DoubleVec<VariableType> &block, int rows, int columns)
+	{
+		out_file.write((const char *)&rows, sizeof(int));
+		out_file.write((const char *)&columns, sizeof(int));
+		for (int row = 0; row != rows; ++row)
+			out_file.write((const char *)block[row].data(), sizeof(VariableType) * columns);
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestBase<ObserveMethodType>::readBlockFromBinary(std::ifstream &in_file, DoubleVec<VariableType> &block)
+	{
+		int rows = 0;
+		int columns = 0;
+		in_file.read((char *)&rows, sizeof(int));
+		in_file.read((char *)&columns, sizeof(int));
+		block.assign(rows, StdVec<VariableType>(columns));
+		for (int row = 0; row != rows; ++row)
+			in_file.read((char *)block[row].data(), sizeof(VariableType) * columns);
 	};
 	//=================================================================================================//
 	template<class ObserveMethodType>
@@ -9,6 +9,7 @@
 #include "base_body.h"
 #include "body_relation.h"
 #include "solid_dynamics.h"
+#include "general_dynamics.h"
 
 namespace SPH
 {
@@ -16,9 +17,19 @@ namespace SPH
 	SPHSystem::SPHSystem(BoundingBox system_domain_bounds, Real resolution_ref, size_t number_of_threads)
 		: system_domain_bounds_(system_domain_bounds),
 		  resolution_ref_(resolution_ref),
-		  tbb_global_control_(tbb::global_control::max_allowed_parallelism, number_of_threads),
+		  tbb_global_control_(makeUnique<tbb::global_control>(tbb::global_control::max_allowed_parallelism, number_of_threads)),
+		  task_arena_(int(number_of_threads)),
+		  physical_time_(&GlobalStaticVariables::physical_time_), own_physical_time_(0.0),
+		  random_seed_(0), random_streams_(0), numa_aware_(false), tune_execution_policies_(false),
 		  in_output_(nullptr), restart_step_(0), run_particle_relaxation_(false),
-		  reload_particles_(false), generate_regression_data_(false) {}
+		  reload_particles_(false), generate_regression_data_(false),
+		  broad_phase_culling_(false), broad_phase_margin_(0.0) {}
+	//=================================================================================================//
+	SPHSystem::~SPHSystem()
+	{
+		if (tune_execution_policies_)
+			ExecutionPolicy::writeTunedPolicies(tuned_policies_file_);
+	}
 	//=================================================================================================//
 	void SPHSystem::addABody(SPHBody *sph_body)
 	{
@@ -27,6 +38,7 @@ namespace SPH
 	//=================================================================================================//
 	void SPHSystem::addARealBody(RealBody *real_body)
 	{
+		real_body->real_body_index_ = real_bodies_.size();
 		real_bodies_.push_back(real_body);
 	}
 	//=================================================================================================//
@@ -50,6 +62,9 @@ namespace SPH
 	//=================================================================================================//
 	void SPHSystem::initializeSystemConfigurations()
 	{
+		if (broad_phase_culling_)
+			updateBroadPhase();
+
 		for (auto &body : bodies_)
 		{
 			for (size_t i = 0; i < body->body_relations_.size(); i++)
@@ -71,7 +86,160 @@ namespace SPH
 		}
 		return dt;
 	}
-//=================================================================================================//
+	//=================================================================================================//
+	void SPHSystem::useOwnPhysicalTime(Real initial_time)
+	{
+		own_physical_time_ = initial_time;
+		physical_time_ = &own_physical_time_;
+		tbb_global_control_.reset();
+	}
+	//=================================================================================================//
+	void SPHSystem::useExecutionPolicyTuning(const std::string &filefullpath)
+	{
+		tune_execution_policies_ = true;
+		tuned_policies_file_ = filefullpath;
+		ExecutionPolicy::readTunedPolicies(tuned_policies_file_);
+	}
+	//=================================================================================================//
+	void SPHSystem::useNumaAwareExecution()
+	{
+		numa_aware_ = true;
+		parallelFirstTouch() = true;
+		thread_pinning_ = makeUnique<ThreadPinningObserver>(task_arena_);
+	}
+	//=================================================================================================//
+	void SPHSystem::useHugePages(HugePageMode huge_page_mode)
+	{
+		hugePageMode() = huge_page_mode;
+		/** the small neighbor lists of the configurations are from the TBB scalable allocator */
+		scalable_allocation_mode(TBBMALLOC_USE_HUGE_PAGES, huge_page_mode == HugePageMode::None ? 0 : 1);
+		if (huge_page_mode != HugePageMode::None && !isScalableAllocatorHugePageCapable())
+			std::cout << "\n Huge pages: only the large particle data are backed, "
+					  << "the neighbor lists of the configurations need transparent huge pages always on "
+					  << "or reserved explicit huge pages." << std::endl;
+	}
+	//=================================================================================================//
+	void SPHSystem::reportParticleDataPlacement()
+	{
+		for (auto &body : real_bodies_)
+		{
+			/** measured by the threads iterating the particles, which are pinned in the task arena */
+			Real local_fraction = 0.0;
+			task_arena_.execute([&]()
+								{ local_fraction = localPageFraction(body->base_particles_->pos_n_); });
+			std::cout << "Particle positions of " << body->getBodyName() << ": ";
+			if (local_fraction < 0.0)
+				std::cout << "memory placement not available." << std::endl;
+			else
+				std::cout << 100.0 * local_fraction << "% local and "
+						  << 100.0 * (1.0 - local_fraction) << "% remote pages." << std::endl;
+		}
+	}
+	//=================================================================================================//
+	void SPHSystem::useBroadPhaseCulling(Real margin)
+	{
+		broad_phase_culling_ = true;
+		broad_phase_margin_ = margin;
+	}
+	//=================================================================================================//
+	void SPHSystem::updateBroadPhase()
+	{
+		size_t number_of_bodies = real_bodies_.size();
+		real_body_bounds_.resize(number_of_bodies);
+		broad_phase_cell_linked_list_updates_.resize(number_of_bodies);
+		for (size_t i = 0; i != number_of_bodies; ++i)
+		{
+			broad_phase_cell_linked_list_updates_[i] = DynamicCast<RealBody>(this, real_bodies_[i])->cell_linked_list_updates_;
+			BodyLowerBound body_lower_bound(*real_bodies_[i]);
+			BodyUpperBound body_upper_bound(*real_bodies_[i]);
+			Real enlargement = real_bodies_[i]->sph_adaptation_->getKernel()->CutOffRadius() + broad_phase_margin_;
+			real_body_bounds_[i].first = body_lower_bound.parallel_exec() - Vecd(enlargement);
+			real_body_bounds_[i].second = body_upper_bound.parallel_exec() + Vecd(enlargement);
+		}
+
+		/** sweep along the first axis over the bodies sorted by their lower bounds */
+		IndexVector sorted_bodies(number_of_bodies);
+		for (size_t i = 0; i != number_of_bodies; ++i)
+			sorted_bodies[i] = i;
+		std::sort(sorted_bodies.begin(), sorted_bodies.end(),
+				  [&](size_t a, size_t b)
+				  { return real_body_bounds_[a].first[0] < real_body_bounds_[b].first[0]; });
+
+		overlapping_body_pairs_.clear();
+		IndexVector active_bodies;
+		for (size_t body_i : sorted_bodies)
+		{
+			BoundingBox &bounds_i = real_body_bounds_[body_i];
+			IndexVector still_active;
+			for (size_t body_j : active_bodies)
+			{
+				BoundingBox &bounds_j = real_body_bounds_[body_j];
+				if (bounds_j.second[0] < bounds_i.first[0])
+					continue;
+				still_active.push_back(body_j);
+
+				bool is_overlapping = true;
+				for (int axis = 1; axis != Dimensions; ++axis)
+				{
+					if (bounds_i.first[axis] > bounds_j.second[axis] || bounds_j.first[axis] > bounds_i.second[axis])
+						is_overlapping = false;
+				}
+				if (is_overlapping)
+					overlapping_body_pairs_.insert(std::make_pair(SMIN(body_i, body_j), SMAX(body_i, body_j)));
+			}
+			still_active.push_back(body_i);
+			active_bodies = still_active;
+		}
+	}
+	//=================================================================================================//
+	void SPHSystem::updateBroadPhaseIfOutdated()
+	{
+		bool is_outdated = broad_phase_cell_linked_list_updates_.size() != real_bodies_.size();
+		for (size_t i = 0; !is_outdated && i != real_bodies_.size(); ++i)
+		{
+			is_outdated = broad_phase_cell_linked_list_updates_[i] !=
+						  DynamicCast<RealBody>(this, real_bodies_[i])->cell_linked_list_updates_;
+		}
+		if (is_outdated)
+			updateBroadPhase();
+	}
+	//=================================================================================================//
+	bool SPHSystem::isOverlapping(SPHBody *body_a, SPHBody *body_b)
+	{
+		if (!broad_phase_culling_ || real_body_bounds_.size() != real_bodies_.size())
+			return true;
+
+		RealBody *real_body_a = dynamic_cast<RealBody *>(body_a);
+		RealBody *real_body_b = dynamic_cast<RealBody *>(body_b);
+		if (real_body_a == nullptr || real_body_b == nullptr)
+			return true;
+
+		size_t index_a = real_body_a->real_body_index_;
+		size_t index_b = real_body_b->real_body_index_;
+		return overlapping_body_pairs_.count(std::make_pair(SMIN(index_a, index_b), SMAX(index_a, index_b))) != 0;
+	}
+	//=================================================================================================//
+	BoundingBox SPHSystem::OverlapRegion(SPHBody *body_a, SPHBody *body_b)
+	{
+		BoundingBox overlap_region(Vecd(-Infinity), Vecd(Infinity));
+		if (!broad_phase_culling_ || real_body_bounds_.size() != real_bodies_.size())
+			return overlap_region;
+
+		RealBody *real_body_a = dynamic_cast<RealBody *>(body_a);
+		RealBody *real_body_b = dynamic_cast<RealBody *>(body_b);
+		if (real_body_a == nullptr || real_body_b == nullptr)
+			return overlap_region;
+
+		BoundingBox &bounds_a = real_body_bounds_[real_body_a->real_body_index_];
+		BoundingBox &bounds_b = real_body_bounds_[real_body_b->real_body_index_];
+		for (int axis = 0; axis != Dimensions; ++axis)
+		{
+			overlap_region.first[axis] = SMAX(bounds_a.first[axis], bounds_b.first[axis]);
+			overlap_region.second[axis] = SMIN(bounds_a.second[axis], bounds_b.second[axis]);
+		}
+		return overlap_region;
+	}
+	//=================================================================================================//
 #ifdef BOOST_AVAILABLE
 	void SPHSystem::handleCommandlineOptions(int ac, char *av[])
 	{
@@ -12,6 +12,7 @@
 
 #define TBB_PREVIEW_GLOBAL_CONTROL 1
 #include <tbb/global_control.h>
+#include <tbb/task_arena.h>
 #ifdef BOOST_AVAILABLE
 #include "boost/program_options.hpp"
 namespace po = boost::program_options;
@@ -19,9 +20,11 @@ namespace po = boost::program_options;
 
 #include "base_data_package.h"
 #include "sph_data_containers.h"
+#include "numa_placement.h"
 
 #include <thread>
 #include <fstream>
+#include <set>
 /** Macro for APPLE compilers*/
 #ifdef __APPLE__
 #include <boost/filesystem.hpp>
@@ -48,11 +51,21 @@ namespace SPH
 	public:
 		SPHSystem(BoundingBox system_domain_bounds, Real resolution_ref,
 				  size_t number_of_threads = std::thread::hardware_concurrency());
-		virtual ~SPHSystem(){};
+		virtual ~SPHSystem();
 
 		BoundingBox system_domain_bounds_;		 /**< Lower and Upper domain bounds. */
 		Real resolution_ref_;					 /**< reference resolution of the SPH system */
-		tbb::global_control tbb_global_control_; /**< global controlling on the total number parallel threads */
+		/** process-wide limit on the number of parallel threads, released by useOwnPhysicalTime() */
+		UniquePtr<tbb::global_control> tbb_global_control_;
+		tbb::task_arena task_arena_;			 /**< the threads for running this system concurrently with others */
+		Real *physical_time_;					 /**< by default, the global GlobalStaticVariables::physical_time_ */
+		Real own_physical_time_;				 /**< the physical time used if owned by this system */
+		size_t random_seed_;					 /**< the seed of the counter-based random numbers of this system */
+		size_t random_streams_;					 /**< the number of random streams assigned to particle dynamics */
+		bool numa_aware_;						 /**< parallel first touch, thread pinning and static partitioning */
+		UniquePtr<ThreadPinningObserver> thread_pinning_; /**< pins the threads to cores in NUMA-aware execution */
+		bool tune_execution_policies_;			 /**< autotune the execution policies of the particle dynamics */
+		std::string tuned_policies_file_;		 /**< the file keeping the tuned execution policies between runs */
 
 		In_Output *in_output_;			/**< in_output setup */
 		size_t restart_step_;			/**< restart step */
@@ -65,6 +78,12 @@ namespace SPH
 		SPHBodyVector real_bodies_;		  /**< The bodies with inner particle configuration. */
 		SolidBodyVector solid_bodies_;	  /**< The bodies with inner particle configuration and acoustic time steps . */
 
+		bool broad_phase_culling_;		 /**< cull contact body pairs with non-overlapping bounds. */
+		Real broad_phase_margin_;		 /**< extra margin on the body bounds for particles moving between updates. */
+		StdVec<BoundingBox> real_body_bounds_; /**< bounds of the real bodies enlarged by cut-off radius and margin. */
+		std::set<std::pair<size_t, size_t>> overlapping_body_pairs_; /**< index pairs of real bodies with overlapping bounds. */
+		IndexVector broad_phase_cell_linked_list_updates_; /**< the cell linked list updates of the real bodies seen by the broad phase. */
+
 		void addABody(SPHBody *sph_body);
 		void addARealBody(RealBody *real_body);
 		void addASolidBody(SolidBody *solid_body);
@@ -72,6 +91,49 @@ namespace SPH
 		void initializeSystemCellLinkedLists();
 		void initializeSystemConfigurations();
 		Real getSmallestTimeStepAmongSolidBodies(Real CFL = 0.6);
+		/** the physical time of the system */
+		Real &PhysicalTime() { return *physical_time_; };
+		/** use a physical time owned by this system, so that several systems can run concurrently.
+		 *  The process-wide thread limit of this system is released as well, since the task arena limits its threads,
+		 *  otherwise the smallest limit among concurrent systems would throttle all of them.
+		 *  Therefore, call it for each of the concurrent systems before any of them is executed. */
+		void useOwnPhysicalTime(Real initial_time = 0.0);
+		/** a new random stream, so that different particle dynamics draw independent random numbers */
+		size_t newRandomStream() { return random_streams_++; };
+		/** run a function, e.g. the time stepping of a simulation, within the task arena of this system.
+		 *  The arena limits the threads of this system only, see useOwnPhysicalTime() for concurrent systems. */
+		template <typename FunctionType>
+		void execute(const FunctionType &function)
+		{
+			task_arena_.execute(function);
+		};
+		/** autotune the execution policies of the particle dynamics created afterwards,
+		 *  starting from the policies tuned in earlier runs and saved in the file,
+		 *  the file is updated with the newly tuned ones when the system is destroyed. */
+		void useExecutionPolicyTuning(const std::string &filefullpath);
+		/** switch on NUMA-aware execution, should be called before the particles are generated.
+		 *  The threads are pinned when they run in the task arena of the system, see execute().
+		 *  The particle data are placed by these threads once the particles are generated. */
+		void useNumaAwareExecution();
+		/** back the large particle and configuration data by huge pages,
+		 *  should be called before the particles are generated.
+		 *  The neighbor lists of the configurations are backed only if the scalable allocator can get huge pages,
+		 *  otherwise a note is printed. */
+		void useHugePages(HugePageMode huge_page_mode = HugePageMode::Transparent);
+		/** print the fraction of the particle position pages local to the iterating threads,
+		 *  measured by the pinned threads of the task arena */
+		void reportParticleDataPlacement();
+		/** switch on the broad-phase culling of contact body pairs */
+		void useBroadPhaseCulling(Real margin = 0.0);
+		/** refresh the body bounds and find the overlapping body pairs by sweep and prune */
+		void updateBroadPhase();
+		/** refresh the broad phase if the cell linked list of any real body has been updated since, 
+		 *  called by the contact relations before their configurations are updated */
+		void updateBroadPhaseIfOutdated();
+		/** whether two bodies may have particles in contact, always true if not culled */
+		bool isOverlapping(SPHBody *body_a, SPHBody *body_b);
+		/** the region in which the particles of the two bodies may be in contact */
+		BoundingBox OverlapRegion(SPHBody *body_a, SPHBody *body_b);
 #ifdef BOOST_AVAILABLE
 		void handleCommandlineOptions(int ac, char *av[]);
 #endif
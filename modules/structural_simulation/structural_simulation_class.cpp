@@ -174,6 +174,7 @@ StructuralSimulationInput::StructuralSimulationInput(
 	translation_solid_body_tuple_ = {};
 	translation_solid_body_part_tuple_ = {};
 	surface_particles_only_to_vtu_ = false;
+	broad_phase_culling_ = false;
 };
 
 ///////////////////////////////////////
@@ -214,6 +215,7 @@ StructuralSimulation::StructuralSimulation(StructuralSimulationInput &input)
 	  translation_solid_body_tuple_(input.translation_solid_body_tuple_),
 	  translation_solid_body_part_tuple_(input.translation_solid_body_part_tuple_),
 	  surface_particles_only_to_vtu_(input.surface_particles_only_to_vtu_),
+	  broad_phase_culling_(input.broad_phase_culling_),
 
 	  // iterators
 	  iteration_(0),
@@ -234,24 +236,16 @@ StructuralSimulation::StructuralSimulation(StructuralSimulationInput &input)
 	// set up the system
 	calculateSystemBoundaries();
 	system_.run_particle_relaxation_ = true;
+	system_.useOwnPhysicalTime();
+	if (broad_phase_culling_)
+		system_.useBroadPhaseCulling();
 	// initialize solid bodies with their properties
 	initializeElasticSolidBodies();
 	// contacts
 	initializeAllContacts();
 
 	// boundary conditions
-	initializeGravity();
-	initializeAccelerationForBodyPartInBoundingBox();
-	initializeForceInBodyRegion();
-	initializeSurfacePressure();
-	initializeSpringDamperConstraintParticleWise();
-	initializeSpringNormalOnSurfaceParticles();
-	initializeConstrainSolidBody();
-	initializeConstrainSolidBodyRegion();
-	initializePositionSolidBody();
-	initializePositionScaleSolidBody();
-	initializeTranslateSolidBody();
-	initializeTranslateSolidBodyPart();
+	initializeBoundaryConditions();
 
 	// initialize simulation
 	initializeSimulation();
@@ -416,7 +410,7 @@ void StructuralSimulation::initializeGravity()
 		// check if i is in indices_gravity
 		if (count(gravity_indices.begin(), gravity_indices.end(), i))
 		{
-			Gravity *gravity = gravity_ptr_keeper_.createPtr<Gravity>(non_zero_gravity_[gravity_index_i].second);
+			Gravity *gravity = boundary_condition_objects_->gravity_ptr_keeper_.createPtr<Gravity>(non_zero_gravity_[gravity_index_i].second);
 			initialize_gravity_.emplace_back(make_shared<TimeStepInitialization>(*solid_body_list_[i]->getImportedModel(), *gravity));
 			gravity_index_i++;
 		}
@@ -458,8 +452,8 @@ void StructuralSimulation::initializeForceInBodyRegion()
 		// SimTK geometric modeling resolution
 		int resolution(20);
 		// create the triangle mesh of the box
-		TriangleMeshShape *tri_mesh = tri_mesh_shape_ptr_keeper_.createPtr<TriangleMeshShapeBrick>(halfsize_bbox, resolution, center);
-		BodyPartByParticleTriMesh *bp = body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *tri_mesh);
+		TriangleMeshShape *tri_mesh = boundary_condition_objects_->tri_mesh_shape_ptr_keeper_.createPtr<TriangleMeshShapeBrick>(halfsize_bbox, resolution, center);
+		BodyPartByParticleTriMesh *bp = boundary_condition_objects_->body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *tri_mesh);
 		force_in_body_region_.emplace_back(make_shared<solid_dynamics::ForceInBodyRegion>(*solid_body_list_[body_index]->getImportedModel(), *bp, force, end_time));
 	}
 }
@@ -474,7 +468,7 @@ void StructuralSimulation::initializeSurfacePressure()
 		Vec3d point = get<2>(surface_pressure_tuple_[i]);
 		StdVec<array<Real, 2>> pressure_over_time = get<3>(surface_pressure_tuple_[i]);
 
-		BodyPartByParticle *bp = body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *tri_mesh);
+		BodyPartByParticle *bp = boundary_condition_objects_->body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *tri_mesh);
 		surface_pressure_.emplace_back(make_shared<solid_dynamics::SurfacePressureFromSource>(*solid_body_list_[body_index]->getImportedModel(), *bp, point, pressure_over_time));
 	}
 }
@@ -501,7 +495,7 @@ void StructuralSimulation::initializeSpringNormalOnSurfaceParticles()
 		Real spring_stiffness = get<4>(surface_spring_tuple_[i]);
 		Real damping_coefficient = get<5>(surface_spring_tuple_[i]);
 
-		BodyPartByParticle *bp = body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *tri_mesh);
+		BodyPartByParticle *bp = boundary_condition_objects_->body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *tri_mesh);
 		surface_spring_.emplace_back(make_shared<solid_dynamics::SpringNormalOnSurfaceParticles>(*solid_body_list_[body_index]->getImportedModel(), *bp, inner_outer, point, spring_stiffness, damping_coefficient));
 	}
 }
@@ -512,7 +506,7 @@ void StructuralSimulation::initializeConstrainSolidBody()
 	for (size_t i = 0; i < body_indices_fixed_constraint_.size(); i++)
 	{
 		int body_index = body_indices_fixed_constraint_[i];
-		BodyPartByParticleTriMesh *bp = body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *body_mesh_list_[body_index]);
+		BodyPartByParticleTriMesh *bp = getWholeBodyPart(body_index);
 		fixed_constraint_body_.emplace_back(make_shared<solid_dynamics::ConstrainSolidBodyRegion>(*solid_body_list_[body_index]->getImportedModel(), *bp));
 	}
 }
@@ -535,9 +529,9 @@ void StructuralSimulation::initializeConstrainSolidBodyRegion()
 		// SimTK geometric modeling resolution
 		int resolution(20);
 		// create the triangle mesh of the box
-		TriangleMeshShape *tri_mesh = tri_mesh_shape_ptr_keeper_.createPtr<TriangleMeshShapeBrick>(halfsize_bbox, resolution, center);
+		TriangleMeshShape *tri_mesh = boundary_condition_objects_->tri_mesh_shape_ptr_keeper_.createPtr<TriangleMeshShapeBrick>(halfsize_bbox, resolution, center);
 
-		BodyPartByParticleTriMesh *bp = body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *tri_mesh);
+		BodyPartByParticleTriMesh *bp = boundary_condition_objects_->body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *tri_mesh);
 		fixed_constraint_region_.emplace_back(make_shared<solid_dynamics::ConstrainSolidBodyRegion>(*solid_body_list_[body_index]->getImportedModel(), *bp));
 	}
 }
@@ -551,7 +545,7 @@ void StructuralSimulation::initializePositionSolidBody()
 		Real start_time = get<1>(position_solid_body_tuple_[i]);
 		Real end_time = get<2>(position_solid_body_tuple_[i]);
 		Vecd pos_end_center = get<3>(position_solid_body_tuple_[i]);
-		BodyPartByParticleTriMesh *bp = body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *body_mesh_list_[body_index]);
+		BodyPartByParticleTriMesh *bp = getWholeBodyPart(body_index);
 
 		position_solid_body_.emplace_back(make_shared<solid_dynamics::PositionSolidBody>(*solid_body_list_[body_index]->getImportedModel(), *bp, start_time, end_time, pos_end_center));
 	}
@@ -566,7 +560,7 @@ void StructuralSimulation::initializePositionScaleSolidBody()
 		Real start_time = get<1>(position_scale_solid_body_tuple_[i]);
 		Real end_time = get<2>(position_scale_solid_body_tuple_[i]);
 		Real scale = get<3>(position_scale_solid_body_tuple_[i]);
-		BodyPartByParticleTriMesh *bp = body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *body_mesh_list_[body_index]);
+		BodyPartByParticleTriMesh *bp = getWholeBodyPart(body_index);
 
 		position_scale_solid_body_.emplace_back(make_shared<solid_dynamics::PositionScaleSolidBody>(*solid_body_list_[body_index]->getImportedModel(), *bp, start_time, end_time, scale));
 	}
@@ -581,8 +575,7 @@ void StructuralSimulation::initializeTranslateSolidBody()
 		Real start_time = get<1>(translation_solid_body_tuple_[i]);
 		Real end_time = get<2>(translation_solid_body_tuple_[i]);
 		Vecd translation = get<3>(translation_solid_body_tuple_[i]);
-		BodyPartByParticleTriMesh *bp = body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(
-			*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *body_mesh_list_[body_index]);
+		BodyPartByParticleTriMesh *bp = getWholeBodyPart(body_index);
 
 		translation_solid_body_.emplace_back(make_shared<solid_dynamics::TranslateSolidBody>(
 			*solid_body_list_[body_index]->getImportedModel(), *bp, start_time, end_time, translation));
@@ -599,8 +592,7 @@ void StructuralSimulation::initializeTranslateSolidBodyPart()
 		Real end_time = get<2>(translation_solid_body_part_tuple_[i]);
 		Vecd translation = get<3>(translation_solid_body_part_tuple_[i]);
 		BoundingBox bbox = get<4>(translation_solid_body_part_tuple_[i]);
-		BodyPartByParticleTriMesh *bp = body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(
-			*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *body_mesh_list_[body_index]);
+		BodyPartByParticleTriMesh *bp = getWholeBodyPart(body_index);
 
 		translation_solid_body_part_.emplace_back(make_shared<solid_dynamics::TranslateSolidBodyPart>(
 			*solid_body_list_[body_index]->getImportedModel(), *bp, start_time, end_time, translation, bbox));
@@ -688,7 +680,7 @@ void StructuralSimulation::executeContactDensitySummation()
 			int index = (i - number_of_general_contacts) / 2;
 			Real start_time = time_dep_contacting_body_pairs_list_[index].second[0];
 			Real end_time = time_dep_contacting_body_pairs_list_[index].second[1];
-			if (GlobalStaticVariables::physical_time_ >= start_time && GlobalStaticVariables::physical_time_ <= end_time)
+			if (system_.PhysicalTime() >= start_time && system_.PhysicalTime() <= end_time)
 			{
 				contact_density_list_[i]->parallel_exec();
 			}
@@ -713,7 +705,7 @@ void StructuralSimulation::executeContactForce()
 			int index = (i - number_of_general_contacts) / 2;
 			Real start_time = time_dep_contacting_body_pairs_list_[index].second[0];
 			Real end_time = time_dep_contacting_body_pairs_list_[index].second[1];
-			if (GlobalStaticVariables::physical_time_ >= start_time && GlobalStaticVariables::physical_time_ <= end_time)
+			if (system_.PhysicalTime() >= start_time && system_.PhysicalTime() <= end_time)
 			{
 				contact_force_list_[i]->parallel_exec();
 			}
@@ -805,6 +797,10 @@ void StructuralSimulation::executeContactUpdateConfiguration()
 {
 	// number of contacts that are not time dependent: contact pairs * 2
 	size_t number_of_general_contacts = contacting_body_pairs_list_.size();
+	if (broad_phase_culling_)
+	{
+		system_.updateBroadPhase();
+	}
 	for (size_t i = 0; i < contact_list_.size(); i++)
 	{
 		// general contacts = contacting_bodies * 2
@@ -820,7 +816,7 @@ void StructuralSimulation::executeContactUpdateConfiguration()
 			int index = (i - number_of_general_contacts) / 2;
 			Real start_time = time_dep_contacting_body_pairs_list_[index].second[0];
 			Real end_time = time_dep_contacting_body_pairs_list_[index].second[1];
-			if (GlobalStaticVariables::physical_time_ >= start_time && GlobalStaticVariables::physical_time_ <= end_time)
+			if (system_.PhysicalTime() >= start_time && system_.PhysicalTime() <= end_time)
 			{
 				contact_list_[i]->updateConfiguration();
 			}
@@ -830,7 +826,7 @@ void StructuralSimulation::executeContactUpdateConfiguration()
 
 void StructuralSimulation::initializeSimulation()
 {
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system_.PhysicalTime() = 0.0;
 
 	/** INITIALALIZE SYSTEM */
 	system_.initializeSystemCellLinkedLists();
@@ -840,10 +836,105 @@ void StructuralSimulation::initializeSimulation()
 	executeCorrectConfiguration();
 }
 
+BodyPartByParticleTriMesh *StructuralSimulation::getWholeBodyPart(int body_index)
+{
+	// the whole body parts are tagged from the initial particle positions, so they hold for all load cases
+	whole_body_part_list_.resize(solid_body_list_.size(), nullptr);
+	if (whole_body_part_list_[body_index] == nullptr)
+	{
+		whole_body_part_list_[body_index] = body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartByParticleTriMesh>(
+			*solid_body_list_[body_index]->getImportedModel(), imported_stl_list_[body_index], *body_mesh_list_[body_index]);
+	}
+	return whole_body_part_list_[body_index];
+}
+
+void StructuralSimulation::clearBoundaryConditions()
+{
+	// the dynamics are released before the shapes and body parts they refer to
+	initialize_gravity_ = {};
+	acceleration_bounding_box_ = {};
+	force_in_body_region_ = {};
+	surface_pressure_ = {};
+	spring_damper_constraint_ = {};
+	surface_spring_ = {};
+	fixed_constraint_body_ = {};
+	fixed_constraint_region_ = {};
+	position_solid_body_ = {};
+	position_scale_solid_body_ = {};
+	translation_solid_body_ = {};
+	translation_solid_body_part_ = {};
+	boundary_condition_objects_ = makeUnique<BoundaryConditionObjects>();
+}
+
+void StructuralSimulation::initializeBoundaryConditions()
+{
+	clearBoundaryConditions();
+	initializeGravity();
+	initializeAccelerationForBodyPartInBoundingBox();
+	initializeForceInBodyRegion();
+	initializeSurfacePressure();
+	initializeSpringDamperConstraintParticleWise();
+	initializeSpringNormalOnSurfaceParticles();
+	initializeConstrainSolidBody();
+	initializeConstrainSolidBodyRegion();
+	initializePositionSolidBody();
+	initializePositionScaleSolidBody();
+	initializeTranslateSolidBody();
+	initializeTranslateSolidBodyPart();
+}
+
+void StructuralSimulation::saveInitialState()
+{
+	ParticleDataOperation<saveParticleDataCopy> save_particle_data;
+	initial_particle_data_.resize(solid_body_list_.size());
+	for (size_t i = 0; i < solid_body_list_.size(); i++)
+	{
+		ElasticSolidParticles *particles = solid_body_list_[i]->getElasticSolidParticles();
+		save_particle_data(particles->all_particle_data_, &initial_particle_data_[i]);
+	}
+}
+
+void StructuralSimulation::resetToInitialState()
+{
+	ParticleDataOperation<restoreParticleDataCopy> restore_particle_data;
+	for (size_t i = 0; i < initial_particle_data_.size(); i++)
+	{
+		ElasticSolidParticles *particles = solid_body_list_[i]->getElasticSolidParticles();
+		restore_particle_data(particles->all_particle_data_, &initial_particle_data_[i]);
+	}
+	system_.PhysicalTime() = 0.0;
+	iteration_ = 0;
+	von_mises_stress_max_ = {};
+	von_mises_stress_particles_ = {};
+	von_mises_strain_max_ = {};
+	von_mises_strain_particles_ = {};
+
+	// the cell linked lists and configurations follow the restored positions
+	system_.initializeSystemCellLinkedLists();
+	system_.initializeSystemConfigurations();
+}
+
+void StructuralSimulation::resetBoundaryConditions(StructuralSimulationInput &load_case)
+{
+	non_zero_gravity_ = load_case.non_zero_gravity_;
+	acceleration_bounding_box_tuple_ = load_case.acceleration_bounding_box_tuple_;
+	force_in_body_region_tuple_ = load_case.force_in_body_region_tuple_;
+	surface_pressure_tuple_ = load_case.surface_pressure_tuple_;
+	spring_damper_tuple_ = load_case.spring_damper_tuple_;
+	surface_spring_tuple_ = load_case.surface_spring_tuple_;
+	body_indices_fixed_constraint_ = load_case.body_indices_fixed_constraint_;
+	body_indices_fixed_constraint_region_ = load_case.body_indices_fixed_constraint_region_;
+	position_solid_body_tuple_ = load_case.position_solid_body_tuple_;
+	position_scale_solid_body_tuple_ = load_case.position_scale_solid_body_tuple_;
+	translation_solid_body_tuple_ = load_case.translation_solid_body_tuple_;
+	translation_solid_body_part_tuple_ = load_case.translation_solid_body_part_tuple_;
+	initializeBoundaryConditions();
+}
+
 void StructuralSimulation::runSimulationStep(Real &dt, Real &integration_time)
 {
 	if (iteration_ % 100 == 0)
-		cout << "N=" << iteration_ << " Time: " << GlobalStaticVariables::physical_time_ << "	dt: " << dt << "\n";
+		cout << "N=" << iteration_ << " Time: " << system_.PhysicalTime() << "	dt: " << dt << "\n";
 
 	/** UPDATE NORMAL DIRECTIONS */
 	executeUpdateElasticNormalDirection();
@@ -888,7 +979,7 @@ void StructuralSimulation::runSimulationStep(Real &dt, Real &integration_time)
 	iteration_++;
 	dt = system_.getSmallestTimeStepAmongSolidBodies();
 	integration_time += dt;
-	GlobalStaticVariables::physical_time_ += dt;
+	system_.PhysicalTime() += dt;
 
 	/** UPDATE BODIES CELL LINKED LISTS */
 	executeUpdateCellLinkedList();
@@ -897,22 +988,25 @@ void StructuralSimulation::runSimulationStep(Real &dt, Real &integration_time)
 	executeContactUpdateConfiguration();
 }
 
-void StructuralSimulation::runSimulation(Real end_time)
+void StructuralSimulation::runSimulation(Real end_time, bool write_states)
 {
-	BodyStatesRecordingToVtp write_states(in_output_, system_.real_bodies_);
+	BodyStatesRecordingToVtp write_states_vtp(in_output_, system_.real_bodies_);
 	SurfaceOnlyBodyStatesRecordingToVtu write_states_surface(in_output_, system_.real_bodies_);
 
 	/** Statistics for computing time. */
-	if (surface_particles_only_to_vtu_)
-		write_states_surface.writeToFile(0);
-	else
-		write_states.writeToFile(0);
+	if (write_states)
+	{
+		if (surface_particles_only_to_vtu_)
+			write_states_surface.writeToFile(0);
+		else
+			write_states_vtp.writeToFile(0);
+	}
 	Real output_period = end_time / 100.0;
 	Real dt = 0.0;
 	tick_count t1 = tick_count::now();
 	tick_count::interval_t interval;
 	/** Main loop */
-	while (GlobalStaticVariables::physical_time_ < end_time)
+	while (system_.PhysicalTime() < end_time)
 	{
 		Real integration_time = 0.0;
 		while (integration_time < output_period)
@@ -927,10 +1021,13 @@ void StructuralSimulation::runSimulation(Real end_time)
 		von_mises_strain_max_.push_back(solid_body_list_[0].get()->getElasticSolidParticles()->getMaxVonMisesStrain());
 		von_mises_strain_particles_.push_back(solid_body_list_[0].get()->getElasticSolidParticles()->getVonMisesStrain());
 		// write data to file
-		if (surface_particles_only_to_vtu_)
-			write_states_surface.writeToFile();
-		else
-			write_states.writeToFile();
+		if (write_states)
+		{
+			if (surface_particles_only_to_vtu_)
+				write_states_surface.writeToFile();
+			else
+				write_states_vtp.writeToFile();
+		}
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -943,7 +1040,7 @@ void StructuralSimulation::runSimulation(Real end_time)
 double StructuralSimulation::runSimulationFixedDurationJS(int number_of_steps)
 {
 	BodyStatesRecordingToVtp write_states(in_output_, system_.real_bodies_);
-	GlobalStaticVariables::physical_time_ = 0.0;
+	system_.PhysicalTime() = 0.0;
 
 	/** Statistics for computing time. */
 	write_states.writeToFile(0);
@@ -984,4 +1081,88 @@ Real StructuralSimulation::getMaxDisplacement(int body_index)
 			displ_max = displ;
 	}
 	return displ_max;
-}
\ No newline at end of file
+}
+
+///////////////////////////////////////
+/* StructuralSimulationSweep members */
+///////////////////////////////////////
+
+StructuralSimulationSweep::StructuralSimulationSweep(StructuralSimulationInput &base_input)
+	: base_input_(base_input), simulation_(base_input_), summary_({})
+{
+	simulation_.saveInitialState();
+}
+
+void StructuralSimulationSweep::checkGeometryAndMaterials(StructuralSimulationInput &load_case)
+{
+	if (load_case.imported_stl_list_ != base_input_.imported_stl_list_ ||
+		load_case.scale_stl_ != base_input_.scale_stl_ ||
+		load_case.resolution_list_ != base_input_.resolution_list_ ||
+		load_case.material_model_list_ != base_input_.material_model_list_ ||
+		load_case.physical_viscosity_ != base_input_.physical_viscosity_ ||
+		load_case.contacting_body_pairs_list_ != base_input_.contacting_body_pairs_list_)
+	{
+		std::cout << "\n Error: a load case changes the geometry, materials or contacts of the sweep!" << std::endl;
+		std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+		exit(1);
+	}
+}
+
+LoadCaseSummary StructuralSimulationSweep::runLoadCase(const string &case_name, StructuralSimulationInput &load_case, Real end_time, bool write_states)
+{
+	checkGeometryAndMaterials(load_case);
+	simulation_.resetToInitialState();
+	simulation_.resetBoundaryConditions(load_case);
+
+	tick_count t1 = tick_count::now();
+	simulation_.runSimulation(end_time, write_states);
+	tick_count t2 = tick_count::now();
+
+	LoadCaseSummary load_case_summary;
+	load_case_summary.case_name_ = case_name;
+	for (size_t i = 0; i < simulation_.solid_body_list_.size(); i++)
+	{
+		load_case_summary.max_displacement_.push_back(simulation_.getMaxDisplacement(i));
+	}
+	vector<Real> &stress_max = simulation_.von_mises_stress_max_;
+	vector<Real> &strain_max = simulation_.von_mises_strain_max_;
+	load_case_summary.max_von_mises_stress_ = stress_max.empty() ? 0.0 : *std::max_element(stress_max.begin(), stress_max.end());
+	load_case_summary.max_von_mises_strain_ = strain_max.empty() ? 0.0 : *std::max_element(strain_max.begin(), strain_max.end());
+	load_case_summary.wall_time_ = (t2 - t1).seconds();
+
+	summary_.push_back(load_case_summary);
+	return load_case_summary;
+}
+
+void StructuralSimulationSweep::runLoadCases(StdVec<pair<string, StructuralSimulationInput>> &load_cases, Real end_time)
+{
+	for (size_t i = 0; i < load_cases.size(); i++)
+	{
+		cout << "Load case " << i + 1 << " of " << load_cases.size() << ": " << load_cases[i].first << endl;
+		runLoadCase(load_cases[i].first, load_cases[i].second, end_time);
+	}
+}
+
+void StructuralSimulationSweep::writeSummary(const string &file_name)
+{
+	string filefullpath = simulation_.in_output_.output_folder_ + "/" + file_name;
+	std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+	out_file << "\"case_name\"   ";
+	for (size_t i = 0; i < simulation_.solid_body_list_.size(); i++)
+	{
+		out_file << "\"max_displacement[" << i << "]\"   ";
+	}
+	out_file << "\"max_von_mises_stress\"   \"max_von_mises_strain\"   \"wall_time\"\n";
+	for (const LoadCaseSummary &load_case_summary : summary_)
+	{
+		out_file << load_case_summary.case_name_ << "   ";
+		for (const Real &displacement : load_case_summary.max_displacement_)
+		{
+			out_file << std::fixed << std::setprecision(9) << displacement << "   ";
+		}
+		out_file << load_case_summary.max_von_mises_stress_ << "   "
+				 << load_case_summary.max_von_mises_strain_ << "   "
+				 << load_case_summary.wall_time_ << "\n";
+	}
+	out_file.close();
+}
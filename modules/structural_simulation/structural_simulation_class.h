@@ -37,6 +37,36 @@ using PositionScaleSolidBodyTuple = tuple<int, Real, Real, Real>;
 using TranslateSolidBodyTuple = tuple<int, Real, Real, Vec3d>;
 using TranslateSolidBodyPartTuple = tuple<int, Real, Real, Vec3d, BoundingBox>;
 
+/** copies of the particle variables of a body, used to reset a simulation to its initial state */
+typedef std::tuple<StdVec<StdLargeVec<Real>>, StdVec<StdLargeVec<Vecd>>, StdVec<StdLargeVec<Matd>>,
+				   StdVec<StdLargeVec<int>>>
+	ParticleDataCopy;
+
+template <int DataTypeIndex, typename VariableType>
+struct saveParticleDataCopy
+{
+	void operator()(ParticleData &particle_data, ParticleDataCopy *data_copy) const
+	{
+		StdVec<StdLargeVec<VariableType> *> &variables = std::get<DataTypeIndex>(particle_data);
+		StdVec<StdLargeVec<VariableType>> &copies = std::get<DataTypeIndex>(*data_copy);
+		copies.resize(variables.size());
+		for (size_t i = 0; i != variables.size(); ++i)
+			copies[i] = *variables[i];
+	};
+};
+
+template <int DataTypeIndex, typename VariableType>
+struct restoreParticleDataCopy
+{
+	void operator()(ParticleData &particle_data, ParticleDataCopy *data_copy) const
+	{
+		StdVec<StdLargeVec<VariableType> *> &variables = std::get<DataTypeIndex>(particle_data);
+		StdVec<StdLargeVec<VariableType>> &copies = std::get<DataTypeIndex>(*data_copy);
+		for (size_t i = 0; i != copies.size(); ++i)
+			*variables[i] = copies[i];
+	};
+};
+
 class BodyPartByParticleTriMesh : public BodyRegionByParticle
 {
 public:
@@ -44,6 +74,18 @@ public:
 	~BodyPartByParticleTriMesh(){};
 };
 
+/**
+* @brief BoundaryConditionObjects
+* the shapes, body parts and gravities created for the boundary conditions of a load case,
+* released when the boundary conditions are reset for the next load case
+*/
+struct BoundaryConditionObjects
+{
+	UniquePtrVectorKeeper<Gravity> gravity_ptr_keeper_;
+	UniquePtrVectorKeeper<TriangleMeshShape> tri_mesh_shape_ptr_keeper_;
+	UniquePtrVectorKeeper<BodyPartByParticleTriMesh> body_part_tri_mesh_ptr_keeper_;
+};
+
 class ImportedModel : public SolidBody
 {
 public:
@@ -132,6 +174,8 @@ public:
 	vector<TranslateSolidBodyPartTuple> translation_solid_body_part_tuple_;
 	//option to only write surface particles into vtu
 	bool surface_particles_only_to_vtu_;
+	//option to skip the contact searches between bodies with non-overlapping bounds
+	bool broad_phase_culling_;
 
 	StructuralSimulationInput(
 		const string &relative_input_path,
@@ -146,11 +190,13 @@ public:
 
 class StructuralSimulation
 {
+	friend class StructuralSimulationSweep;
+
 private:
 	UniquePtrVectorKeeper<SolidBodyRelationContact> contact_relation_ptr_keeper_;
-	UniquePtrVectorKeeper<Gravity> gravity_ptr_keeper_;
 	UniquePtrVectorKeeper<TriangleMeshShape> tri_mesh_shape_ptr_keeper_;
 	UniquePtrVectorKeeper<BodyPartByParticleTriMesh> body_part_tri_mesh_ptr_keeper_;
+	UniquePtr<BoundaryConditionObjects> boundary_condition_objects_;
 
 protected:
 	// mandatory input
@@ -173,6 +219,7 @@ protected:
 	In_Output in_output_;
 
 	vector<TriangleMeshShape*> body_mesh_list_;
+	vector<BodyPartByParticleTriMesh*> whole_body_part_list_; // created once and shared by the load cases
 	vector<SharedPtr<SPHAdaptation>> particle_adaptation_list_;
 	vector<shared_ptr<SolidBodyForSimulation>> solid_body_list_;
 	vector<shared_ptr<solid_dynamics::UpdateElasticNormalDirection>> particle_normal_update_;
@@ -219,6 +266,8 @@ protected:
 	vector<TranslateSolidBodyPartTuple> translation_solid_body_part_tuple_;
 	//option to only write surface particles into vtu
 	bool surface_particles_only_to_vtu_;
+	//option to skip the contact searches between bodies with non-overlapping bounds
+	bool broad_phase_culling_;
 
 	// iterators
 	int iteration_;
@@ -230,6 +279,9 @@ protected:
 	vector<Real> von_mises_strain_max_;
 	StdLargeVec<StdLargeVec<Real>> von_mises_strain_particles_;
 
+	// initial particle state for running several load cases
+	StdVec<ParticleDataCopy> initial_particle_data_;
+
 	// for constructor, the order is important
 	void scaleTranslationAndResolution();
 	void setSystemResolutionMax();
@@ -279,6 +331,14 @@ protected:
 
 	void initializeSimulation();
 
+	// for running several load cases with the same geometry and materials
+	BodyPartByParticleTriMesh *getWholeBodyPart(int body_index);
+	void clearBoundaryConditions();
+	void initializeBoundaryConditions();
+	void saveInitialState();
+	void resetToInitialState();
+	void resetBoundaryConditions(StructuralSimulationInput &load_case);
+
 	void runSimulationStep(Real &dt, Real &integration_time);
 
 public:
@@ -289,10 +349,49 @@ public:
 	Real getMaxDisplacement(int body_index);
 
 	//For c++
-	void runSimulation(Real end_time);
+	void runSimulation(Real end_time, bool write_states = true);
 
 	//For JS
 	double runSimulationFixedDurationJS(int number_of_steps);
 };
 
+/**
+* @brief LoadCaseSummary
+* the results of a load case run by StructuralSimulationSweep
+*/
+struct LoadCaseSummary
+{
+	string case_name_;
+	StdVec<Real> max_displacement_; // for each body at the end time
+	Real max_von_mises_stress_;		// of the first body over all output periods
+	Real max_von_mises_strain_;		// of the first body over all output periods
+	Real wall_time_;
+};
+
+/**
+* @brief StructuralSimulationSweep
+* Runs many load cases on the same geometry. The triangle meshes, (relaxed) particles,
+* materials, relations and contacts are set up once from the base input, and the particle state
+* is reset in memory before each load case. Only the boundary conditions, i.e. gravity, forces,
+* pressures, springs, constraints and prescribed motions, are taken from the load case input.
+*/
+class StructuralSimulationSweep
+{
+protected:
+	StructuralSimulationInput base_input_;
+	StructuralSimulation simulation_;
+	StdVec<LoadCaseSummary> summary_;
+
+	void checkGeometryAndMaterials(StructuralSimulationInput &load_case);
+
+public:
+	explicit StructuralSimulationSweep(StructuralSimulationInput &base_input);
+	~StructuralSimulationSweep(){};
+
+	LoadCaseSummary runLoadCase(const string &case_name, StructuralSimulationInput &load_case, Real end_time, bool write_states = false);
+	void runLoadCases(StdVec<pair<string, StructuralSimulationInput>> &load_cases, Real end_time);
+	StdVec<LoadCaseSummary> &getSummary() { return summary_; };
+	void writeSummary(const string &file_name = "load_case_summary.dat");
+};
+
 #endif //SOLID_STRUCTURAL_SIMULATION_CLASS_H
\ No newline at end of file
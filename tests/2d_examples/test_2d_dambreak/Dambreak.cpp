@@ -125,6 +125,11 @@ int main(int ac, char *av[])
 		write_water_mechanical_energy(in_output, water_block, gravity);
 	RegressionTestDynamicTimeWarping<ObservedQuantityRecording<indexScalar, Real>>
 		write_recorded_water_pressure("Pressure", in_output, fluid_observer_contact);
+	/** The observer configuration is only updated when the pressure is recorded. */
+	write_recorded_water_pressure.updateConfigurationOnDemand();
+	/** The snapshots for the regression test are recorded in compact binary files. */
+	write_water_mechanical_energy.useBinarySnapshots();
+	write_recorded_water_pressure.useBinarySnapshots();
 	//----------------------------------------------------------------------
 	//	Prepare the simulation with cell linked list, configuration
 	//	and case specified initial condition if necessary.
@@ -218,7 +223,6 @@ int main(int ac, char *av[])
 			time_instance = tick_count::now();
 			water_block.updateCellLinkedList();
 			water_block_complex.updateConfiguration();
-			fluid_observer_contact.updateConfiguration();
 			interval_updating_configuration += tick_count::now() - time_instance;
 		}
 
@@ -0,0 +1,112 @@
+/**
+ * @file 	lazy_neighbor_fields.cpp
+ * @brief 	Benchmark for stored and lazily evaluated neighbor pair fields.
+ * @details A free-surface water block is computed twice with the same inner dynamics.
+ *			First, all pair fields are stored in the inner configuration.
+ *			Then, only the neighbor indexes are stored and the kernel values,
+ *			kernel gradients and directions are evaluated on the fly.
+ *			The wall times are compared and the densities should be identical.
+ * @author 	Chi Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h" //SPHinXsys Library.
+using namespace SPH;   //Namespace cite here.
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real LL = 2.0;						/**< Liquid column length. */
+Real LH = 1.0;						/**< Liquid column height. */
+Real particle_spacing_ref = 0.01;	/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; /**< Extending width of the domain. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(LL + BW, LH + BW));
+size_t number_of_steps = 50;	 /**< Number of outer time steps. */
+size_t number_of_sub_steps = 10; /**< Number of acoustic time steps within a outer step. */
+//----------------------------------------------------------------------
+//	Material properties of the fluid.
+//----------------------------------------------------------------------
+Real rho0_f = 1.0; /**< Reference density of fluid. */
+Real c_f = 10.0;   /**< Reference sound speed. */
+//----------------------------------------------------------------------
+//	Geometric shapes used in this case.
+//----------------------------------------------------------------------
+std::vector<Vecd> water_block_shape{
+	Vecd(0.0, 0.0), Vecd(0.0, LH), Vecd(LL, LH), Vecd(LL, 0.0), Vecd(0.0, 0.0)};
+//----------------------------------------------------------------------
+//	Fluid body with cases-dependent geometries (ComplexShape).
+//----------------------------------------------------------------------
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &sph_system, const std::string &body_name)
+		: FluidBody(sph_system, body_name)
+	{
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(water_block_shape, ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+//----------------------------------------------------------------------
+//	Run the case with a given storage policy and return the wall time.
+//----------------------------------------------------------------------
+Real runWithStoragePolicy(const NeighborStoragePolicy &storage_policy, StdLargeVec<Real> &density)
+{
+	SPHSystem sph_system(system_domain_bounds, particle_spacing_ref);
+	WaterBlock water_block(sph_system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+
+	BodyRelationInner water_block_inner(water_block);
+	water_block_inner.setStoragePolicy(storage_policy);
+
+	fluid_dynamics::DensitySummationFreeSurfaceInner fluid_density_by_summation(water_block_inner);
+	fluid_dynamics::AcousticTimeStepSize fluid_acoustic_time_step(water_block);
+	fluid_dynamics::PressureRelaxationRiemannInner fluid_pressure_relaxation(water_block_inner);
+	fluid_dynamics::DensityRelaxationRiemannInner fluid_density_relaxation(water_block_inner);
+
+	sph_system.initializeSystemCellLinkedLists();
+	sph_system.initializeSystemConfigurations();
+
+	Real dt = 0.0;
+	tick_count t1 = tick_count::now();
+	for (size_t step = 0; step != number_of_steps; ++step)
+	{
+		fluid_density_by_summation.parallel_exec();
+		for (size_t sub_step = 0; sub_step != number_of_sub_steps; ++sub_step)
+		{
+			fluid_pressure_relaxation.parallel_exec(dt);
+			fluid_density_relaxation.parallel_exec(dt);
+			dt = fluid_acoustic_time_step.parallel_exec();
+		}
+		water_block.updateCellLinkedList();
+		water_block_inner.updateConfiguration();
+	}
+	tick_count t2 = tick_count::now();
+
+	density = fluid_particles.rho_n_;
+	return (t2 - t1).seconds();
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main()
+{
+	StdLargeVec<Real> density_stored, density_lazy;
+	Real time_stored = runWithStoragePolicy(NeighborStoragePolicy(), density_stored);
+	Real time_lazy = runWithStoragePolicy(NeighborStoragePolicy(false, false, false, false), density_lazy);
+
+	std::cout << std::fixed << std::setprecision(9)
+			  << "Wall time with stored pair fields = " << time_stored << " seconds.\n"
+			  << "Wall time with lazily evaluated pair fields = " << time_lazy << " seconds.\n";
+
+	Real difference_max = 0.0;
+	for (size_t i = 0; i != density_stored.size(); ++i)
+	{
+		difference_max = SMAX(difference_max, ABS(density_stored[i] - density_lazy[i]));
+	}
+	std::cout << "Maximum density difference = " << difference_max << "\n";
+
+	if (density_stored.size() != density_lazy.size() || difference_max > 1.0e-8)
+	{
+		std::cout << "\n Error: the stored and lazily evaluated pair fields give different results!" << std::endl;
+		return 1;
+	}
+	return 0;
+}
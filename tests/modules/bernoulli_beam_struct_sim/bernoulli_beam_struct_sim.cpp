@@ -55,6 +55,70 @@ TEST(BernoulliBeam20x, Pressure)
 	std::cout << "displ_max: " << displ_max << std::endl;
 }
 
+TEST(BernoulliBeam20x, PressureSweep)
+{
+	Real scale_stl = 0.001;
+	Real end_time = 0.15;
+
+	Real rho_0 = 6.45e3; // Nitinol
+	Real poisson = 0.3;
+	Real Youngs_modulus = 5e8;
+	Real physical_viscosity = Youngs_modulus / 100;
+	Real pressure = 1e3;
+
+	/** STL IMPORT PARAMETERS */
+	std::string relative_input_path = "./input/"; //path definition for linux
+	std::vector<std::string> imported_stl_list = { "bernoulli_beam_20x.stl" };
+	std::vector<Vec3d> translation_list = { Vec3d(0) };
+	std::vector<Real> resolution_list = { 10.0 / 6.0 };
+	SharedPtr<LinearElasticSolid> material = makeShared<LinearElasticSolid>(rho_0, Youngs_modulus, poisson);
+	std::vector<SharedPtr<LinearElasticSolid>> material_model_list = { material };
+
+	TriangleMeshShapeSTL specimen("./input/bernoulli_beam_20x.stl", Vec3d(0), scale_stl);
+	BoundingBox fixation = specimen.findBounds();
+	fixation.second[0] = fixation.first[0] + 0.01;
+
+	StructuralSimulationInput input
+	{
+		relative_input_path,
+		imported_stl_list,
+		scale_stl,
+		translation_list,
+		resolution_list,
+		material_model_list,
+		{physical_viscosity},
+		{}
+	};
+	input.body_indices_fixed_constraint_region_ = StdVec<ConstrainedRegionPair>{ ConstrainedRegionPair(0, fixation) };
+	input.particle_relaxation_list_ = { true };
+
+	/** the load cases only differ in the pressure magnitude */
+	StdVec<Real> pressure_factors = { 1.0, 2.0 };
+	StdVec<pair<string, StructuralSimulationInput>> load_cases;
+	for (Real factor : pressure_factors)
+	{
+		StructuralSimulationInput load_case = input;
+		StdVec<array<Real, 2>> pressure_over_time = {
+			{0.0, 0.0},
+			{end_time * 0.1, pressure * factor},
+			{end_time, pressure * factor }
+		};
+		load_case.surface_pressure_tuple_ = StdVec<PressureTuple>{ PressureTuple(0, &specimen, Vec3d(0.1, 0.0, 0.1), pressure_over_time) };
+		load_cases.push_back(pair<string, StructuralSimulationInput>("pressure_x" + std::to_string(int(factor)), load_case));
+	}
+
+	//=================================================================================================//
+	StructuralSimulationSweep sweep(input);
+	sweep.runLoadCases(load_cases, end_time);
+	sweep.writeSummary();
+
+	StdVec<LoadCaseSummary> &summary = sweep.getSummary();
+	Real displ_max_analytical = 4.8e-3; // in mm, absolute max displacement
+	EXPECT_NEAR(summary[0].max_displacement_[0], displ_max_analytical, displ_max_analytical * 0.1);
+	// linear response: the second case starts from the same initial state with twice the pressure
+	EXPECT_NEAR(summary[1].max_displacement_[0], 2.0 * summary[0].max_displacement_[0], summary[0].max_displacement_[0] * 0.1);
+}
+
 int main(int argc, char* argv[])
 {	
 	testing::InitGoogleTest(&argc, argv);
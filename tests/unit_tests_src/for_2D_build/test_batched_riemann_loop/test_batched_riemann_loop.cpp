@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real DL = 2.0;					 /**< Tank length. */
+Real DH = 1.2;					 /**< Tank height. */
+Real LL = 0.8;					 /**< Water column length. */
+Real LH = 0.8;					 /**< Water column height. */
+Real resolution_ref = LH / 20.0; /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;	 /**< Extending width for the wall. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+Real rho0_f = 1.0;
+Real gravity_g = 1.0;
+Real U_max = 2.0 * sqrt(gravity_g * LH);
+Real c_f = 10.0 * U_max;
+
+std::vector<Vecd> createRectangleShape(Vecd lower_bound, Vecd upper_bound)
+{
+	std::vector<Vecd> rectangle_shape;
+	rectangle_shape.push_back(lower_bound);
+	rectangle_shape.push_back(Vecd(lower_bound[0], upper_bound[1]));
+	rectangle_shape.push_back(upper_bound);
+	rectangle_shape.push_back(Vecd(upper_bound[0], lower_bound[1]));
+	rectangle_shape.push_back(lower_bound);
+	return rectangle_shape;
+}
+
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &system, const std::string &body_name)
+		: FluidBody(system, body_name)
+	{
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(createRectangleShape(Vecd(0.0, 0.0), Vecd(LL, LH)), ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+class WallBoundary : public SolidBody
+{
+public:
+	WallBoundary(SPHSystem &system, const std::string &body_name)
+		: SolidBody(system, body_name)
+	{
+		MultiPolygon outer_wall_polygon;
+		outer_wall_polygon.addAPolygon(createRectangleShape(Vecd(-BW, -BW), Vecd(DL + BW, DH + BW)), ShapeBooleanOps::add);
+		MultiPolygon inner_wall_polygon;
+		inner_wall_polygon.addAPolygon(createRectangleShape(Vecd(0.0, 0.0), Vecd(DL, DH)), ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(outer_wall_polygon, "OuterWall");
+		body_shape_.substract<MultiPolygonShape>(inner_wall_polygon, "InnerWall");
+	}
+};
+
+/** velocities and densities of a collapsing water column after a few acoustic time steps */
+void runDambreakSteps(bool use_batches, StdLargeVec<Vecd> &vel_n, StdLargeVec<Real> &rho_n)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles water_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	WallBoundary wall_boundary(system, "Wall");
+	SolidParticles wall_particles(wall_boundary);
+	ComplexBodyRelation water_block_complex(water_block, {&wall_boundary});
+
+	Gravity gravity(Vecd(0.0, -gravity_g));
+	TimeStepInitialization initialize_a_fluid_step(water_block, gravity);
+	fluid_dynamics::DensitySummationFreeSurfaceComplex update_density_by_summation(water_block_complex);
+	fluid_dynamics::AcousticTimeStepSize get_fluid_time_step_size(water_block);
+	fluid_dynamics::PressureRelaxationRiemannWithWall pressure_relaxation(water_block_complex);
+	fluid_dynamics::DensityRelaxationRiemannWithWall density_relaxation(water_block_complex);
+	pressure_relaxation.useBatchedNeighborLoop(use_batches);
+	density_relaxation.useBatchedNeighborLoop(use_batches);
+
+	system.initializeSystemCellLinkedLists();
+	system.initializeSystemConfigurations();
+	wall_particles.initializeNormalDirectionFromBodyShape();
+
+	for (size_t step = 0; step != 10; ++step)
+	{
+		initialize_a_fluid_step.parallel_exec();
+		update_density_by_summation.parallel_exec();
+		Real dt = get_fluid_time_step_size.parallel_exec();
+		pressure_relaxation.parallel_exec(dt);
+		density_relaxation.parallel_exec(dt);
+		water_block.updateCellLinkedList();
+		water_block_complex.updateConfiguration();
+	}
+
+	vel_n = water_particles.vel_n_;
+	rho_n = water_particles.rho_n_;
+}
+
+/** the batched neighbor loops give the same bits as the neighbor-by-neighbor loops */
+TEST(test_batched_riemann_loop, test_dambreak_steps)
+{
+	StdLargeVec<Vecd> scalar_vel, batched_vel;
+	StdLargeVec<Real> scalar_rho, batched_rho;
+	runDambreakSteps(false, scalar_vel, scalar_rho);
+	runDambreakSteps(true, batched_vel, batched_rho);
+
+	ASSERT_EQ(scalar_vel.size(), batched_vel.size());
+	for (size_t index_i = 0; index_i != scalar_vel.size(); ++index_i)
+	{
+		EXPECT_EQ(scalar_rho[index_i], batched_rho[index_i]);
+		for (int k = 0; k != Dimensions; ++k)
+			EXPECT_EQ(scalar_vel[index_i][k], batched_vel[index_i][k]);
+	}
+	//- the column has started to collapse, so the comparison is not trivial
+	Real max_speed = 0.0;
+	for (size_t index_i = 0; index_i != scalar_vel.size(); ++index_i)
+		max_speed = SMAX(max_speed, scalar_vel[index_i].norm());
+	EXPECT_GT(max_speed, 0.0);
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
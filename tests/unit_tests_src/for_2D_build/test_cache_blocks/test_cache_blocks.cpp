@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real DL = 0.4;					 /**< Water block length. */
+Real DH = 1.0;					 /**< Water block height, so that the sweep is along the second axis. */
+Real resolution_ref = DL / 10.0; /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;	 /**< Extending width of the system domain. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &system, const std::string &body_name)
+		: FluidBody(system, body_name)
+	{
+		std::vector<Vecd> water_block_shape;
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		water_block_shape.push_back(Vecd(0.0, DH));
+		water_block_shape.push_back(Vecd(DL, DH));
+		water_block_shape.push_back(Vecd(DL, 0.0));
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(water_block_shape, ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+enum class ExecutionMode
+{
+	StepByStep,
+	BlocksSequential,
+	BlocksParallel
+};
+
+/** velocities and densities of a perturbed water block after a few relaxation steps */
+void runRelaxationSteps(ExecutionMode execution_mode, StdLargeVec<Vecd> &vel_n, StdLargeVec<Real> &rho_n)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	BodyRelationInner water_block_inner(water_block);
+	fluid_dynamics::PressureRelaxationRiemannInner pressure_relaxation(water_block_inner);
+	fluid_dynamics::DensityRelaxationRiemannInner density_relaxation(water_block_inner);
+	//- a block of a single cell, so that most of the neighbors are in other blocks and layers
+	CacheBlocks cache_blocks(water_block, 1);
+
+	system.initializeSystemCellLinkedLists();
+	system.initializeSystemConfigurations();
+	cache_blocks.updateBlocks();
+
+	//- the binned particles are complete and in the order of their indexes
+	size_t total_real_particles = fluid_particles.total_real_particles_;
+	EXPECT_GT(cache_blocks.TotalLayers(), cache_blocks.BlocksPerLayer());
+	size_t binned_particles = 0;
+	for (size_t block = 0; block != cache_blocks.block_particles_.size(); ++block)
+	{
+		IndexVector &block_particles = cache_blocks.block_particles_[block];
+		for (size_t k = 1; k < block_particles.size(); ++k)
+			EXPECT_LT(block_particles[k - 1], block_particles[k]);
+		binned_particles += block_particles.size();
+	}
+	EXPECT_EQ(binned_particles, total_real_particles);
+
+	StdLargeVec<Vecd> &pos_n = fluid_particles.pos_n_;
+	for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+	{
+		fluid_particles.rho_n_[index_i] = rho0_f * (1.0 + 0.01 * sin(2.0 * Pi * pos_n[index_i][1] / DH));
+		fluid_particles.vel_n_[index_i] = Vecd(0.1 * sin(2.0 * Pi * pos_n[index_i][1] / DH), 0.0);
+	}
+
+	Real dt = 0.25 * resolution_ref / c_f;
+	for (size_t step = 0; step != 10; ++step)
+	{
+		switch (execution_mode)
+		{
+		case ExecutionMode::StepByStep:
+			pressure_relaxation.parallel_exec(dt);
+			density_relaxation.parallel_exec(dt);
+			break;
+		case ExecutionMode::BlocksSequential:
+			pressure_relaxation.exec_by_blocks(cache_blocks, dt);
+			density_relaxation.exec_by_blocks(cache_blocks, dt);
+			break;
+		case ExecutionMode::BlocksParallel:
+			pressure_relaxation.parallel_exec_by_blocks(cache_blocks, dt);
+			density_relaxation.parallel_exec_by_blocks(cache_blocks, dt);
+			break;
+		}
+		water_block.updateCellLinkedList();
+		water_block_inner.updateConfiguration();
+		cache_blocks.updateBlocks();
+	}
+
+	vel_n = fluid_particles.vel_n_;
+	rho_n = fluid_particles.rho_n_;
+}
+
+/** the wavefront sweep over the blocks gives the same bits as the step-by-step execution */
+TEST(test_cache_blocks, test_against_step_by_step)
+{
+	StdLargeVec<Vecd> reference_vel, sequential_vel, parallel_vel;
+	StdLargeVec<Real> reference_rho, sequential_rho, parallel_rho;
+	runRelaxationSteps(ExecutionMode::StepByStep, reference_vel, reference_rho);
+	runRelaxationSteps(ExecutionMode::BlocksSequential, sequential_vel, sequential_rho);
+	runRelaxationSteps(ExecutionMode::BlocksParallel, parallel_vel, parallel_rho);
+
+	ASSERT_EQ(reference_vel.size(), sequential_vel.size());
+	ASSERT_EQ(reference_vel.size(), parallel_vel.size());
+	for (size_t index_i = 0; index_i != reference_vel.size(); ++index_i)
+	{
+		EXPECT_EQ(reference_rho[index_i], sequential_rho[index_i]);
+		EXPECT_EQ(reference_rho[index_i], parallel_rho[index_i]);
+		for (int k = 0; k != Dimensions; ++k)
+		{
+			EXPECT_EQ(reference_vel[index_i][k], sequential_vel[index_i][k]);
+			EXPECT_EQ(reference_vel[index_i][k], parallel_vel[index_i][k]);
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real DL = 1.0;					 /**< Tank length. */
+Real DH = 0.4;					 /**< Tank height. */
+Real resolution_ref = DH / 10.0; /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;	 /**< Extending width of the system domain. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &system, const std::string &body_name)
+		: FluidBody(system, body_name)
+	{
+		std::vector<Vecd> water_block_shape;
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		water_block_shape.push_back(Vecd(0.0, DH));
+		water_block_shape.push_back(Vecd(DL, DH));
+		water_block_shape.push_back(Vecd(DL, 0.0));
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(water_block_shape, ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+/** a registered component-major variable follows the particles, and its bulk update equals the one particle by particle */
+TEST(test_component_major_data, test_registered_variable)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	size_t total_real_particles = fluid_particles.total_real_particles_;
+	fluid_particles.addBufferParticles(total_real_particles);
+
+	ComponentMajorVariable<Vecd> displacement;
+	ComponentMajorVariable<Vecd> velocity;
+	fluid_particles.registerAVariable(displacement, "Displacement");
+	fluid_particles.registerAVariable(velocity, "ComponentMajorVelocity", Vecd(1.0, -1.0));
+	ASSERT_EQ(displacement.size(), fluid_particles.real_particles_bound_);
+	EXPECT_EQ(velocity.get(total_real_particles - 1), Vecd(1.0, -1.0));
+
+	for (size_t i = 0; i != total_real_particles; ++i)
+	{
+		Vecd pos_i = fluid_particles.pos_n_[i];
+		displacement[i] = pos_i;
+		velocity[i] += Vecd(pos_i[1], 0.0);
+	}
+
+	//- the bulk update in parallel
+	Real dt = 0.01;
+	addScaledComponents_parallel(displacement, dt, velocity, total_real_particles);
+	for (size_t i = 0; i != total_real_particles; ++i)
+	{
+		Vecd pos_i = fluid_particles.pos_n_[i];
+		Vecd expected = pos_i + dt * (Vecd(1.0, -1.0) + Vecd(pos_i[1], 0.0));
+		Vecd displacement_i = displacement[i];
+		EXPECT_EQ(displacement_i, expected);
+	}
+
+	//- the components are copied and moved with the particles
+	fluid_particles.requestToSpawnParticle(3);
+	fluid_particles.spawnRequestedParticles();
+	EXPECT_EQ(displacement.get(total_real_particles), displacement.get(3));
+	EXPECT_EQ(velocity.get(total_real_particles), velocity.get(3));
+
+	Vecd last_displacement = displacement.get(total_real_particles);
+	fluid_particles.requestToDeleteParticle(0);
+	fluid_particles.deleteRequestedParticles();
+	EXPECT_EQ(displacement.get(0), last_displacement);
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
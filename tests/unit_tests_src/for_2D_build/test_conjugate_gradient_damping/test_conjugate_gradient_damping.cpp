@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real PL = 0.2;					 /**< Beam length. */
+Real PH = 0.02;					 /**< Beam thickness. */
+Real resolution_ref = PH / 10.0; /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;	 /**< Extending width of the system domain and the wall. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -PL), Vec2d(PL + BW, PL));
+Real rho0_s = 1.0e3;
+Real Youngs_modulus = 2.0e6;
+Real poisson = 0.3975;
+Real dt = 1.0e-5;
+/** a mild damping, the pair coefficients sum up to a few percent of the particle mass */
+Real physical_viscosity = 0.01 * rho0_s * resolution_ref * resolution_ref / dt;
+
+std::vector<Vecd> createRectangleShape(Vecd lower_bound, Vecd upper_bound)
+{
+	std::vector<Vecd> rectangle_shape;
+	rectangle_shape.push_back(lower_bound);
+	rectangle_shape.push_back(Vecd(lower_bound[0], upper_bound[1]));
+	rectangle_shape.push_back(upper_bound);
+	rectangle_shape.push_back(Vecd(upper_bound[0], lower_bound[1]));
+	rectangle_shape.push_back(lower_bound);
+	return rectangle_shape;
+}
+
+class Beam : public SolidBody
+{
+public:
+	Beam(SPHSystem &system, const std::string &body_name)
+		: SolidBody(system, body_name)
+	{
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(createRectangleShape(Vecd(0.0, -PH / 2), Vecd(PL, PH / 2)), ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+class Holder : public SolidBody
+{
+public:
+	Holder(SPHSystem &system, const std::string &body_name)
+		: SolidBody(system, body_name)
+	{
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(createRectangleShape(Vecd(-BW, -PH / 2), Vecd(0.0, PH / 2)), ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+/** a rough velocity field with zero mean, so that the damping has something to smooth */
+void setRoughVelocity(ElasticSolidParticles &particles)
+{
+	for (size_t index_i = 0; index_i != particles.total_real_particles_; ++index_i)
+	{
+		Vecd &pos = particles.pos_n_[index_i];
+		particles.vel_n_[index_i] = Vecd(sin(40.0 * Pi * pos[1] / PH), cos(17.0 * Pi * pos[0] / PL));
+	}
+}
+
+Real kineticEnergy(ElasticSolidParticles &particles)
+{
+	Real kinetic_energy = 0.0;
+	for (size_t index_i = 0; index_i != particles.total_real_particles_; ++index_i)
+		kinetic_energy += 0.5 * particles.mass_[index_i] * particles.vel_n_[index_i].normSqr();
+	return kinetic_energy;
+}
+
+Vecd totalMomentum(ElasticSolidParticles &particles)
+{
+	Vecd total_momentum(0);
+	for (size_t index_i = 0; index_i != particles.total_real_particles_; ++index_i)
+		total_momentum += particles.mass_[index_i] * particles.vel_n_[index_i];
+	return total_momentum;
+}
+
+/** the pair terms sum_j b_ij (v_i - v_j) of the implicit damping operator of the particle i */
+Vecd implicitPairTerms(const Neighborhood &neighborhood, Real Vol_i, const Vecd &vel_i,
+					   StdLargeVec<Real> &Vol_j, StdLargeVec<Vecd> &vel_j)
+{
+	Vecd pair_terms(0);
+	for (size_t n = 0; n != neighborhood.current_size_; ++n)
+	{
+		size_t index_j = neighborhood.j_[n];
+		Real parameter_b = -2.0 * physical_viscosity * neighborhood.dW_ij_[n] * Vol_i * Vol_j[index_j] * dt / neighborhood.r_ij_[n];
+		pair_terms += parameter_b * (vel_i - vel_j[index_j]);
+	}
+	return pair_terms;
+}
+
+/** the conjugate gradient solves the same implicit damping as the splitting sweeps approximate */
+TEST(test_conjugate_gradient_damping, test_inner_against_splitting)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	Beam splitting_beam(system, "SplittingBeam");
+	ElasticSolidParticles splitting_particles(splitting_beam, makeShared<LinearElasticSolid>(rho0_s, Youngs_modulus, poisson));
+	Beam conjugate_gradient_beam(system, "ConjugateGradientBeam");
+	ElasticSolidParticles conjugate_gradient_particles(conjugate_gradient_beam,
+													   makeShared<LinearElasticSolid>(rho0_s, Youngs_modulus, poisson));
+	BodyRelationInner splitting_beam_inner(splitting_beam);
+	BodyRelationInner conjugate_gradient_beam_inner(conjugate_gradient_beam);
+
+	DampingWithRandomChoice<DampingBySplittingInner<indexVector, Vecd>>
+		splitting_damping(splitting_beam_inner, 1.0, "Velocity", physical_viscosity);
+	DampingWithRandomChoice<DampingByConjugateGradientInner<indexVector, Vecd>>
+		conjugate_gradient_damping(conjugate_gradient_beam_inner, 1.0, "Velocity", physical_viscosity);
+	conjugate_gradient_damping.setSolverParameters(1.0e-10, 200);
+
+	system.initializeSystemCellLinkedLists();
+	system.initializeSystemConfigurations();
+
+	size_t total_real_particles = splitting_particles.total_real_particles_;
+	ASSERT_EQ(total_real_particles, conjugate_gradient_particles.total_real_particles_);
+	setRoughVelocity(splitting_particles);
+	setRoughVelocity(conjugate_gradient_particles);
+	StdLargeVec<Vecd> initial_vel = conjugate_gradient_particles.vel_n_;
+	Real initial_energy = kineticEnergy(conjugate_gradient_particles);
+	Vecd initial_momentum = totalMomentum(conjugate_gradient_particles);
+
+	splitting_damping.parallel_exec(dt);
+	conjugate_gradient_damping.parallel_exec(dt);
+	EXPECT_GT(conjugate_gradient_damping.NumberOfIterations(), size_t(0));
+	EXPECT_LT(conjugate_gradient_damping.NumberOfIterations(), size_t(200));
+
+	//- the conjugate gradient result satisfies the implicit system
+	StdLargeVec<Vecd> &vel_n = conjugate_gradient_particles.vel_n_;
+	StdLargeVec<Real> &Vol = conjugate_gradient_particles.Vol_;
+	StdLargeVec<Real> &mass = conjugate_gradient_particles.mass_;
+	Real residual_square = 0.0;
+	Real source_square = 0.0;
+	for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+	{
+		Vecd residual = mass[index_i] * (vel_n[index_i] - initial_vel[index_i]) +
+						implicitPairTerms(conjugate_gradient_beam_inner.inner_configuration_[index_i],
+										  Vol[index_i], vel_n[index_i], Vol, vel_n);
+		residual_square += residual.normSqr();
+		source_square += (mass[index_i] * initial_vel[index_i]).normSqr();
+	}
+	EXPECT_LT(residual_square, 1.0e-16 * source_square);
+
+	//- both dissipate, the conservative operator keeps the momentum, and they are close for the mild damping
+	EXPECT_LT(kineticEnergy(splitting_particles), initial_energy);
+	EXPECT_LT(kineticEnergy(conjugate_gradient_particles), initial_energy);
+	Real momentum_scale = sqrt(2.0 * initial_energy * rho0_s * PL * PH);
+	EXPECT_LT((totalMomentum(conjugate_gradient_particles) - initial_momentum).norm(), 1.0e-6 * momentum_scale);
+
+	Real difference_square = 0.0;
+	Real change_square = 0.0;
+	for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+	{
+		difference_square += (splitting_particles.vel_n_[index_i] - vel_n[index_i]).normSqr();
+		change_square += (vel_n[index_i] - initial_vel[index_i]).normSqr();
+	}
+	EXPECT_GT(change_square, 0.0);
+	EXPECT_LT(difference_square, 0.04 * change_square);
+}
+
+/** the fixed wall enters the diagonal and the source of the conjugate gradient damping */
+TEST(test_conjugate_gradient_damping, test_with_wall)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	Beam beam(system, "Beam");
+	ElasticSolidParticles beam_particles(beam, makeShared<LinearElasticSolid>(rho0_s, Youngs_modulus, poisson));
+	Holder holder(system, "Holder");
+	SolidParticles holder_particles(holder);
+	ComplexBodyRelation beam_complex(beam, {&holder});
+
+	DampingWithRandomChoice<DampingByConjugateGradientWithWall<indexVector, Vecd>>
+		beam_damping(beam_complex, 1.0, "Velocity", physical_viscosity);
+	beam_damping.setSolverParameters(1.0e-10, 200);
+
+	system.initializeSystemCellLinkedLists();
+	system.initializeSystemConfigurations();
+
+	size_t total_real_particles = beam_particles.total_real_particles_;
+	setRoughVelocity(beam_particles);
+	StdLargeVec<Vecd> initial_vel = beam_particles.vel_n_;
+	Real initial_energy = kineticEnergy(beam_particles);
+
+	beam_damping.parallel_exec(dt);
+	EXPECT_LT(kineticEnergy(beam_particles), initial_energy);
+
+	//- the implicit system with the resting holder particles as fixed neighbors
+	StdLargeVec<Vecd> &vel_n = beam_particles.vel_n_;
+	StdLargeVec<Real> &Vol = beam_particles.Vol_;
+	StdLargeVec<Real> &mass = beam_particles.mass_;
+	Real residual_square = 0.0;
+	Real source_square = 0.0;
+	size_t particles_near_holder = 0;
+	for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+	{
+		Neighborhood &wall_neighborhood = beam_complex.contact_configuration_[0][index_i];
+		Vecd residual = mass[index_i] * (vel_n[index_i] - initial_vel[index_i]) +
+						implicitPairTerms(beam_complex.inner_configuration_[index_i], Vol[index_i], vel_n[index_i], Vol, vel_n) +
+						implicitPairTerms(wall_neighborhood, Vol[index_i], vel_n[index_i], holder_particles.Vol_, holder_particles.vel_n_);
+		residual_square += residual.normSqr();
+		source_square += (mass[index_i] * initial_vel[index_i]).normSqr();
+		if (wall_neighborhood.current_size_ != 0)
+			++particles_near_holder;
+	}
+	EXPECT_GT(particles_near_holder, size_t(0));
+	EXPECT_LT(residual_square, 1.0e-16 * source_square);
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
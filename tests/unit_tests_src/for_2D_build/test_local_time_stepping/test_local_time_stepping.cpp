@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real DL = 1.0;					 /**< Water block length. */
+Real DH = 0.4;					 /**< Water block height. */
+Real resolution_ref = DH / 10.0; /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;	 /**< Extending width of the system domain. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+Real dt_min = 0.001;
+
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &system, const std::string &body_name)
+		: FluidBody(system, body_name)
+	{
+		std::vector<Vecd> water_block_shape;
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		water_block_shape.push_back(Vecd(0.0, DH));
+		water_block_shape.push_back(Vecd(DL, DH));
+		water_block_shape.push_back(Vecd(DL, 0.0));
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(water_block_shape, ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+/** total momentum of a perturbed water block after a few coarsest time steps with three levels */
+Vecd totalMomentumAfterLocalTimeStepping(bool use_interface_register)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	BodyRelationInner water_block_inner(water_block);
+	LocalTimeStepLevels time_step_levels(water_block_inner, 3);
+	LevelInterfaceMomentumRegister momentum_register(time_step_levels, water_block_inner);
+	fluid_dynamics::PressureRelaxationRiemannInner pressure_relaxation(water_block_inner);
+	fluid_dynamics::DensityRelaxationRiemannInner density_relaxation(water_block_inner);
+	if (use_interface_register)
+		pressure_relaxation.useLevelInterfaceRegister(momentum_register);
+
+	system.initializeSystemCellLinkedLists();
+	system.initializeSystemConfigurations();
+
+	StdLargeVec<Vecd> &pos_n = fluid_particles.pos_n_;
+	StdLargeVec<Vecd> &vel_n = fluid_particles.vel_n_;
+	StdLargeVec<Real> &mass = fluid_particles.mass_;
+	size_t total_real_particles = fluid_particles.total_real_particles_;
+	for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+	{
+		fluid_particles.rho_n_[index_i] = rho0_f * (1.0 + 0.01 * sin(2.0 * Pi * pos_n[index_i][0]));
+		time_step_levels.local_dt_[index_i] = pos_n[index_i][0] < 0.5 * DL ? dt_min : 4.0 * dt_min;
+	}
+	time_step_levels.updateLevels(dt_min);
+
+	//- the binned particles are complete and in the order of their indexes
+	size_t binned_particles = 0;
+	for (size_t l = 0; l != time_step_levels.TotalLevels(); ++l)
+	{
+		IndexVector &level_particles = time_step_levels.level_particles_[l];
+		EXPECT_FALSE(level_particles.empty());
+		for (size_t k = 0; k != level_particles.size(); ++k)
+		{
+			EXPECT_EQ(time_step_levels.time_step_level_[level_particles[k]], int(l));
+			if (k != 0)
+				EXPECT_LT(level_particles[k - 1], level_particles[k]);
+		}
+		binned_particles += level_particles.size();
+	}
+	EXPECT_EQ(binned_particles, total_real_particles);
+
+	for (size_t coarsest_step = 0; coarsest_step != 4; ++coarsest_step)
+	{
+		for (size_t sub_step = 0; sub_step != time_step_levels.SubStepsInCoarsestStep(); ++sub_step)
+		{
+			pressure_relaxation.parallel_exec_by_level(time_step_levels, sub_step);
+			density_relaxation.parallel_exec_by_level(time_step_levels, sub_step);
+		}
+		momentum_register.correctCoarseMomenta();
+	}
+
+	Vecd total_momentum(0);
+	for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+		total_momentum += mass[index_i] * vel_n[index_i];
+	return total_momentum;
+}
+
+/** the momentum exchanged across the level interfaces is conserved only with the register */
+TEST(test_local_time_stepping, test_momentum_conservation)
+{
+	Vecd momentum_without_register = totalMomentumAfterLocalTimeStepping(false);
+	Vecd momentum_with_register = totalMomentumAfterLocalTimeStepping(true);
+
+	EXPECT_GT(momentum_without_register.norm(), 1.0e-10);
+	EXPECT_LT(momentum_with_register.norm(), 1.0e-6 * momentum_without_register.norm());
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
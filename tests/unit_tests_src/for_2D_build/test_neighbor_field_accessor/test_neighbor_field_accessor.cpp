@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real DL = 1.0;					 /**< Channel length. */
+Real DH = 0.4;					 /**< Channel height. */
+Real resolution_ref = DH / 10.0; /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;	 /**< Extending width of the system domain. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &system, const std::string &body_name)
+		: FluidBody(system, body_name)
+	{
+		std::vector<Vecd> water_block_shape;
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		water_block_shape.push_back(Vecd(0.0, DH));
+		water_block_shape.push_back(Vecd(DL, DH));
+		water_block_shape.push_back(Vecd(DL, 0.0));
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(water_block_shape, ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+/** the pair fields evaluated on the fly agree with the stored ones, also across the periodic bounds */
+TEST(test_neighbor_field_accessor, test_periodic_channel)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	BodyRelationInner stored_inner(water_block);
+	BodyRelationInner lazy_inner(water_block);
+	lazy_inner.setStoragePolicy(NeighborStoragePolicy(false, false, false, false));
+	PeriodicConditionInAxisDirectionUsingCellLinkedList periodic_condition(water_block, xAxis);
+
+	system.initializeSystemCellLinkedLists();
+	periodic_condition.update_cell_linked_list_.parallel_exec();
+	system.initializeSystemConfigurations();
+
+	NeighborFieldAccessor lazy_fields(lazy_inner);
+	StdLargeVec<Vecd> &pos_n = fluid_particles.pos_n_;
+	size_t periodic_pairs = 0;
+	for (size_t index_i = 0; index_i != fluid_particles.total_real_particles_; ++index_i)
+	{
+		const Neighborhood &stored = stored_inner.inner_configuration_[index_i];
+		const Neighborhood &lazy = lazy_inner.inner_configuration_[index_i];
+		ASSERT_EQ(stored.current_size_, lazy.current_size_);
+		for (size_t n = 0; n != stored.current_size_; ++n)
+		{
+			ASSERT_EQ(stored.j_[n], lazy.j_[n]);
+			if (fabs(pos_n[index_i][0] - pos_n[stored.j_[n]][0]) > 0.5 * DL)
+				periodic_pairs++;
+			EXPECT_NEAR(stored.W_ij_[n], lazy_fields.W(lazy, index_i, n), 1.0e-9);
+			EXPECT_NEAR(stored.dW_ij_[n], lazy_fields.dW(lazy, index_i, n), 1.0e-9);
+			EXPECT_NEAR(stored.r_ij_[n], lazy_fields.r(lazy, index_i, n), 1.0e-12);
+			EXPECT_NEAR((stored.e_ij_[n] - lazy_fields.e(lazy, index_i, n)).norm(), 0.0, 1.0e-9);
+		}
+	}
+	EXPECT_GT(periodic_pairs, size_t(0));
+}
+
+/** a dynamics reading the stored pair fields directly is refused with a reduced storage policy */
+TEST(test_neighbor_field_accessor, test_direct_reader_refused)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	BodyRelationInner water_block_inner(water_block);
+	water_block_inner.setStoragePolicy(NeighborStoragePolicy(false, false, false, false));
+	fluid_dynamics::DensitySummationInner density_summation(water_block_inner);
+	fluid_dynamics::ViscousAccelerationInner viscous_acceleration(water_block_inner);
+	fluid_dynamics::TransportVelocityCorrectionInner transport_velocity_correction(water_block_inner);
+	system.initializeSystemCellLinkedLists();
+	system.initializeSystemConfigurations();
+	EXPECT_EQ(water_block_inner.DirectPairFieldReaders(), size_t(0));
+
+	fluid_dynamics::VorticityInner vorticity(water_block_inner);
+	EXPECT_EXIT(water_block_inner.updateConfiguration(), ::testing::ExitedWithCode(1), "");
+}
+
+/** an accessor not owned by a direct reader does not hide it, and a destroyed direct reader is not counted */
+TEST(test_neighbor_field_accessor, test_direct_reader_with_standalone_accessor)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	BodyRelationInner water_block_inner(water_block);
+	water_block_inner.setStoragePolicy(NeighborStoragePolicy(false, false, false, false));
+	fluid_dynamics::DensitySummationInner density_summation(water_block_inner);
+	system.initializeSystemCellLinkedLists();
+	system.initializeSystemConfigurations();
+
+	{
+		fluid_dynamics::VorticityInner vorticity(water_block_inner);
+		EXPECT_EQ(water_block_inner.DirectPairFieldReaders(), size_t(1));
+	}
+	EXPECT_EQ(water_block_inner.DirectPairFieldReaders(), size_t(0));
+	water_block_inner.updateConfiguration();
+
+	fluid_dynamics::VorticityInner vorticity(water_block_inner);
+	NeighborFieldAccessor standalone_fields(water_block_inner);
+	NeighborFieldAccessor another_standalone_fields(water_block_inner);
+	EXPECT_EQ(water_block_inner.DirectPairFieldReaders(), size_t(1));
+	EXPECT_EXIT(water_block_inner.updateConfiguration(), ::testing::ExitedWithCode(1), "");
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	testing::FLAGS_gtest_death_test_style = "threadsafe";
+	return RUN_ALL_TESTS();
+}
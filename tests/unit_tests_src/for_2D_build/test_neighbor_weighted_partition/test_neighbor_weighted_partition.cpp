@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real DL = 1.0;					 /**< Water block length. */
+Real DH = 0.4;					 /**< Water block height. */
+Real resolution_ref = DH / 10.0; /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;	 /**< Extending width of the system domain. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+Real mu_f = 0.01;
+
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &system, const std::string &body_name)
+		: FluidBody(system, body_name)
+	{
+		std::vector<Vecd> water_block_shape;
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		water_block_shape.push_back(Vecd(0.0, DH));
+		water_block_shape.push_back(Vecd(DL, DH));
+		water_block_shape.push_back(Vecd(DL, 0.0));
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(water_block_shape, ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+/** the balanced loop gives the same results, and its ranges are rebuilt only after configuration updates */
+TEST(test_neighbor_weighted_partition, test_viscous_acceleration)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f, mu_f));
+	BodyRelationInner water_block_inner(water_block);
+	fluid_dynamics::ViscousAccelerationInner viscous_acceleration(water_block_inner);
+	fluid_dynamics::ViscousAccelerationInner balanced_viscous_acceleration(water_block_inner);
+	balanced_viscous_acceleration.balanceWorkloadByNeighbors(water_block_inner);
+
+	system.initializeSystemCellLinkedLists();
+	system.initializeSystemConfigurations();
+
+	StdLargeVec<Vecd> &pos_n = fluid_particles.pos_n_;
+	StdLargeVec<Vecd> &vel_n = fluid_particles.vel_n_;
+	StdLargeVec<Vecd> &dvel_dt_prior = fluid_particles.dvel_dt_prior_;
+	size_t total_real_particles = fluid_particles.total_real_particles_;
+	for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+		vel_n[index_i] = Vecd(sin(Pi * pos_n[index_i][1] / DH), cos(2.0 * Pi * pos_n[index_i][0]));
+
+	viscous_acceleration.parallel_exec();
+	StdLargeVec<Vecd> reference_acceleration = dvel_dt_prior;
+	balanced_viscous_acceleration.parallel_exec();
+	for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+	{
+		EXPECT_EQ(reference_acceleration[index_i][0], dvel_dt_prior[index_i][0]);
+		EXPECT_EQ(reference_acceleration[index_i][1], dvel_dt_prior[index_i][1]);
+	}
+
+	IndexVector range_bounds = balanced_viscous_acceleration.WorkloadRangeBounds();
+	ASSERT_GT(range_bounds.size(), size_t(1));
+	EXPECT_EQ(size_t(0), range_bounds.front());
+	EXPECT_EQ(total_real_particles, range_bounds.back());
+	for (size_t k = 1; k != range_bounds.size(); ++k)
+		EXPECT_LE(range_bounds[k - 1], range_bounds[k]);
+
+	//- neighbor counts changed without a configuration update do not rebuild the ranges
+	ParticleConfiguration &inner_configuration = water_block_inner.inner_configuration_;
+	for (size_t index_i = 0; index_i != total_real_particles / 2; ++index_i)
+		inner_configuration[index_i].current_size_ = 0;
+	balanced_viscous_acceleration.parallel_exec();
+	EXPECT_EQ(range_bounds, balanced_viscous_acceleration.WorkloadRangeBounds());
+
+	water_block_inner.configuration_updates_++;
+	balanced_viscous_acceleration.parallel_exec();
+	EXPECT_NE(range_bounds, balanced_viscous_acceleration.WorkloadRangeBounds());
+
+	water_block_inner.updateConfiguration();
+	balanced_viscous_acceleration.parallel_exec();
+	EXPECT_EQ(range_bounds, balanced_viscous_acceleration.WorkloadRangeBounds());
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
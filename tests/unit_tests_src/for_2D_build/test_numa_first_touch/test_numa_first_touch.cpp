@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real DL = 1.0;					  /**< Tank length. */
+Real DH = 0.4;					  /**< Tank height. */
+Real resolution_ref = DH / 100.0; /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;	  /**< Extending width of the system domain. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &system, const std::string &body_name)
+		: FluidBody(system, body_name)
+	{
+		std::vector<Vecd> water_block_shape;
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		water_block_shape.push_back(Vecd(0.0, DH));
+		water_block_shape.push_back(Vecd(DL, DH));
+		water_block_shape.push_back(Vecd(DL, 0.0));
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(water_block_shape, ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+/** The pages of a variable are on the memory nodes of the pinned threads iterating them,
+ *  except at most two pages at the boundaries of the particle range of each thread.
+ *  On a single memory node all pages are local. Skipped if the placement is not available. */
+template <typename VariableType>
+void checkPlacement(SPHSystem &system, StdLargeVec<VariableType> &variable)
+{
+	Real local_fraction = 0.0;
+	system.task_arena_.execute([&]()
+							   { local_fraction = localPageFraction(variable); });
+	if (local_fraction < 0.0)
+		return;
+
+	Real number_of_pages = Real(variable.size() * sizeof(VariableType)) / 4096.0;
+	Real number_of_threads = Real(system.task_arena_.max_concurrency());
+	EXPECT_GE(local_fraction, 1.0 - 2.0 * number_of_threads / number_of_pages);
+}
+
+/** the base particle data filled while generating particles are placed by the threads of the system */
+TEST(test_numa_first_touch, test_base_particle_data_placed)
+{
+	SPHSystem reference_system(system_domain_bounds, resolution_ref);
+	WaterBlock reference_block(reference_system, "ReferenceBody");
+	FluidParticles reference_particles(reference_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	system.useNumaAwareExecution();
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	fluid_particles.addBufferParticles(fluid_particles.total_real_particles_ / 10);
+
+	//- the data are kept when moved to the placed pages
+	ASSERT_EQ(fluid_particles.total_real_particles_, reference_particles.total_real_particles_);
+	for (size_t i = 0; i != fluid_particles.total_real_particles_; ++i)
+	{
+		EXPECT_EQ(fluid_particles.pos_n_[i], reference_particles.pos_n_[i]);
+		EXPECT_EQ(fluid_particles.Vol_[i], reference_particles.Vol_[i]);
+		EXPECT_EQ(fluid_particles.mass_[i], reference_particles.mass_[i]);
+		EXPECT_EQ(fluid_particles.rho_n_[i], reference_particles.rho_n_[i]);
+		EXPECT_EQ(fluid_particles.sorted_id_[i], i);
+		EXPECT_EQ(fluid_particles.unsorted_id_[i], i);
+	}
+	for (size_t i = 0; i != fluid_particles.real_particles_bound_; ++i)
+		EXPECT_EQ(fluid_particles.unsorted_id_[i], i);
+
+	checkPlacement(system, fluid_particles.pos_n_);
+	checkPlacement(system, fluid_particles.vel_n_);
+	checkPlacement(system, fluid_particles.dvel_dt_);
+	checkPlacement(system, fluid_particles.dvel_dt_prior_);
+	checkPlacement(system, fluid_particles.Vol_);
+	checkPlacement(system, fluid_particles.rho_n_);
+	checkPlacement(system, fluid_particles.mass_);
+	checkPlacement(system, fluid_particles.sorted_id_);
+	checkPlacement(system, fluid_particles.unsorted_id_);
+}
+
+int main(int argc, char *argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
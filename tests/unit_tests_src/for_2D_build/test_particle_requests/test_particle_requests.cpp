@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real DL = 1.0;					 /**< Tank length. */
+Real DH = 0.4;					 /**< Tank height. */
+Real resolution_ref = DH / 10.0; /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;	 /**< Extending width of the system domain. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &system, const std::string &body_name)
+		: FluidBody(system, body_name)
+	{
+		std::vector<Vecd> water_block_shape;
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		water_block_shape.push_back(Vecd(0.0, DH));
+		water_block_shape.push_back(Vecd(DL, DH));
+		water_block_shape.push_back(Vecd(DL, 0.0));
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(water_block_shape, ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+/** the sorted and unsorted ids of all real particles are inverse to each other */
+void checkSortedIds(BaseParticles &particles)
+{
+	for (size_t i = 0; i != particles.total_real_particles_; ++i)
+		ASSERT_EQ(particles.sorted_id_[particles.unsorted_id_[i]], i);
+}
+
+/** spawn and delete requests issued concurrently, some of them twice, are realized once each */
+TEST(test_particle_requests, test_concurrent_spawn_and_delete)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	size_t initial_real_particles = fluid_particles.total_real_particles_;
+	fluid_particles.addBufferParticles(initial_real_particles / 4);
+	StdLargeVec<Vecd> &pos_n = fluid_particles.pos_n_;
+	for (size_t i = 0; i != initial_real_particles; ++i)
+		fluid_particles.vel_n_[i] = Vecd(Real(fluid_particles.unsorted_id_[i]), 0.0);
+
+	//- every fifth particle is spawned and every tenth is requested twice
+	parallel_for(
+		blocked_range<size_t>(0, initial_real_particles),
+		[&](const blocked_range<size_t> &r)
+		{
+			for (size_t i = r.begin(); i != r.end(); ++i)
+			{
+				if (i % 5 == 0)
+					fluid_particles.requestToSpawnParticle(i);
+				if (i % 10 == 0)
+					fluid_particles.requestToSpawnParticle(i);
+			}
+		},
+		ap);
+	const IndexVector &spawned_particles = fluid_particles.spawnRequestedParticles();
+
+	size_t number_of_spawned = (initial_real_particles + 4) / 5;
+	ASSERT_EQ(spawned_particles.size(), number_of_spawned);
+	ASSERT_EQ(fluid_particles.total_real_particles_, initial_real_particles + number_of_spawned);
+	for (size_t k = 0; k != number_of_spawned; ++k)
+	{
+		EXPECT_EQ(spawned_particles[k], 5 * k);
+		size_t new_particle_index = initial_real_particles + k;
+		EXPECT_EQ(pos_n[new_particle_index], pos_n[5 * k]);
+		EXPECT_EQ(fluid_particles.vel_n_[new_particle_index], fluid_particles.vel_n_[5 * k]);
+		//- a spawned particle has its own identity
+		EXPECT_EQ(fluid_particles.unsorted_id_[new_particle_index], new_particle_index);
+	}
+	checkSortedIds(fluid_particles);
+
+	//- the velocity of each particle records its original identity, spawned ones record their source
+	size_t total_real_particles = fluid_particles.total_real_particles_;
+	std::map<size_t, Vecd> remaining_velocities;
+	for (size_t i = 0; i != total_real_particles; ++i)
+		if (i % 3 != 0)
+			remaining_velocities[fluid_particles.unsorted_id_[i]] = fluid_particles.vel_n_[i];
+
+	//- every third particle is deleted, including those spawned just before and with repeated requests
+	parallel_for(
+		blocked_range<size_t>(0, total_real_particles),
+		[&](const blocked_range<size_t> &r)
+		{
+			for (size_t i = r.begin(); i != r.end(); ++i)
+			{
+				if (i % 3 == 0)
+					fluid_particles.requestToDeleteParticle(i);
+				if (i % 6 == 0)
+					fluid_particles.requestToDeleteParticle(i);
+			}
+		},
+		ap);
+	fluid_particles.deleteRequestedParticles();
+
+	ASSERT_EQ(fluid_particles.total_real_particles_, remaining_velocities.size());
+	std::set<size_t> compacted_ids;
+	for (size_t i = 0; i != fluid_particles.total_real_particles_; ++i)
+	{
+		size_t unsorted_id = fluid_particles.unsorted_id_[i];
+		ASSERT_EQ(remaining_velocities.count(unsorted_id), size_t(1));
+		EXPECT_EQ(fluid_particles.vel_n_[i], remaining_velocities[unsorted_id]);
+		compacted_ids.insert(unsorted_id);
+	}
+	EXPECT_EQ(compacted_ids.size(), remaining_velocities.size());
+	checkSortedIds(fluid_particles);
+
+	//- the deleted particles become buffer particles to be spawned again
+	fluid_particles.requestToSpawnParticle(0);
+	fluid_particles.spawnRequestedParticles();
+	EXPECT_EQ(fluid_particles.total_real_particles_, remaining_velocities.size() + 1);
+	checkSortedIds(fluid_particles);
+}
+
+/** more spawn requests than buffer particles are refused */
+TEST(test_particle_requests, test_spawn_without_enough_buffer)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	fluid_particles.addBufferParticles(2);
+	for (size_t i = 0; i != 3; ++i)
+		fluid_particles.requestToSpawnParticle(i);
+	EXPECT_EXIT(fluid_particles.spawnRequestedParticles(), ::testing::ExitedWithCode(1), "");
+}
+
+int main(int argc, char *argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	testing::FLAGS_gtest_death_test_style = "threadsafe";
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real DL = 1.0;					 /**< Water block length. */
+Real DH = 0.6;					 /**< Water block height. */
+Real resolution_ref = DH / 20.0; /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;	 /**< Extending width of the system domain. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+Real rho0_f = 1.0;
+Real gravity_g = 1.0;
+Real c_f = 10.0;
+
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &system, const std::string &body_name)
+		: FluidBody(system, body_name)
+	{
+		std::vector<Vecd> water_block_shape;
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		water_block_shape.push_back(Vecd(0.0, DH));
+		water_block_shape.push_back(Vecd(DL, DH));
+		water_block_shape.push_back(Vecd(DL, 0.0));
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(water_block_shape, ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+enum class ExecutionMode
+{
+	OneAfterAnother,
+	TaskGraphSequential,
+	TaskGraphParallel
+};
+
+/** velocities and densities of a perturbed free-surface water block after a few steps */
+void runFluidSteps(ExecutionMode execution_mode, StdLargeVec<Vecd> &vel_n, StdLargeVec<Real> &rho_n)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	BodyRelationInner water_block_inner(water_block);
+
+	Gravity gravity(Vecd(0.0, -gravity_g));
+	TimeStepInitialization initialize_a_fluid_step(water_block, gravity);
+	fluid_dynamics::DensitySummationFreeSurfaceInner update_density_by_summation(water_block_inner);
+	fluid_dynamics::AcousticTimeStepSize get_fluid_time_step_size(water_block);
+	fluid_dynamics::PressureRelaxationRiemannInner pressure_relaxation(water_block_inner);
+	fluid_dynamics::DensityRelaxationRiemannInner density_relaxation(water_block_inner);
+	//- a tile of a single cell, so that most of the dependencies are across tiles
+	SpatialTaskGraph fluid_step(water_block, 1);
+	fluid_step.addDynamics(update_density_by_summation);
+	fluid_step.addDynamics(pressure_relaxation, false);
+	fluid_step.addDynamics(density_relaxation, false);
+
+	system.initializeSystemCellLinkedLists();
+	system.initializeSystemConfigurations();
+	fluid_step.updateTiles();
+
+	StdLargeVec<Vecd> &pos_n = fluid_particles.pos_n_;
+	for (size_t index_i = 0; index_i != fluid_particles.total_real_particles_; ++index_i)
+		fluid_particles.vel_n_[index_i] = Vecd(0.1 * sin(2.0 * Pi * pos_n[index_i][1] / DH), 0.0);
+
+	for (size_t step = 0; step != 10; ++step)
+	{
+		initialize_a_fluid_step.parallel_exec();
+		Real dt = get_fluid_time_step_size.parallel_exec();
+		switch (execution_mode)
+		{
+		case ExecutionMode::OneAfterAnother:
+			update_density_by_summation.parallel_exec();
+			pressure_relaxation.parallel_exec(dt);
+			density_relaxation.parallel_exec(dt);
+			break;
+		case ExecutionMode::TaskGraphSequential:
+			fluid_step.exec(dt);
+			break;
+		case ExecutionMode::TaskGraphParallel:
+			fluid_step.parallel_exec(dt);
+			break;
+		}
+		water_block.updateCellLinkedList();
+		water_block_inner.updateConfiguration();
+		fluid_step.updateTiles();
+	}
+
+	vel_n = fluid_particles.vel_n_;
+	rho_n = fluid_particles.rho_n_;
+}
+
+/** the task graph gives the same bits as the dynamics executed one after another */
+TEST(test_spatial_task_graph, test_against_one_after_another)
+{
+	StdLargeVec<Vecd> reference_vel, sequential_vel, parallel_vel;
+	StdLargeVec<Real> reference_rho, sequential_rho, parallel_rho;
+	runFluidSteps(ExecutionMode::OneAfterAnother, reference_vel, reference_rho);
+	runFluidSteps(ExecutionMode::TaskGraphSequential, sequential_vel, sequential_rho);
+	runFluidSteps(ExecutionMode::TaskGraphParallel, parallel_vel, parallel_rho);
+
+	ASSERT_EQ(reference_vel.size(), sequential_vel.size());
+	ASSERT_EQ(reference_vel.size(), parallel_vel.size());
+	for (size_t index_i = 0; index_i != reference_vel.size(); ++index_i)
+	{
+		EXPECT_EQ(reference_rho[index_i], sequential_rho[index_i]);
+		EXPECT_EQ(reference_rho[index_i], parallel_rho[index_i]);
+		for (int k = 0; k != Dimensions; ++k)
+		{
+			EXPECT_EQ(reference_vel[index_i][k], sequential_vel[index_i][k]);
+			EXPECT_EQ(reference_vel[index_i][k], parallel_vel[index_i][k]);
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real DL = 1.0;					 /**< Channel length. */
+Real DH = 0.4;					 /**< Channel height. */
+Real resolution_ref = DH / 10.0; /**< Initial reference particle spacing. */
+Real BW = resolution_ref * 4;	 /**< Extending width of the system domain. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem &system, const std::string &body_name)
+		: FluidBody(system, body_name)
+	{
+		std::vector<Vecd> water_block_shape;
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		water_block_shape.push_back(Vecd(0.0, DH));
+		water_block_shape.push_back(Vecd(DL, DH));
+		water_block_shape.push_back(Vecd(DL, 0.0));
+		water_block_shape.push_back(Vecd(0.0, 0.0));
+		MultiPolygon multi_polygon;
+		multi_polygon.addAPolygon(water_block_shape, ShapeBooleanOps::add);
+		body_shape_.add<MultiPolygonShape>(multi_polygon);
+	}
+};
+
+/** the neighbors of a particle with their kernel values, sorted by the neighbor index */
+StdVec<std::pair<size_t, Real>> sortedNeighbors(const Neighborhood &neighborhood)
+{
+	StdVec<std::pair<size_t, Real>> neighbors;
+	for (size_t n = 0; n != neighborhood.current_size_; ++n)
+		neighbors.push_back(std::make_pair(neighborhood.j_[n], neighborhood.W_ij_[n]));
+	std::sort(neighbors.begin(), neighbors.end());
+	return neighbors;
+}
+
+/** the neighbor lists reused with a skin are the same as those searched at each step */
+TEST(test_verlet_skin, test_channel_with_and_without_skin)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	BodyRelationInner searched_inner(water_block);
+	BodyRelationInner skinned_inner(water_block);
+	skinned_inner.useVerletSkin(0.5 * resolution_ref);
+
+	system.initializeSystemCellLinkedLists();
+	system.initializeSystemConfigurations();
+
+	//- a shear flow moving the particles by at most a tenth of the spacing per step
+	StdLargeVec<Vecd> &pos_n = fluid_particles.pos_n_;
+	size_t total_real_particles = fluid_particles.total_real_particles_;
+	for (size_t step = 0; step != 20; ++step)
+	{
+		for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+			pos_n[index_i][0] += 0.1 * resolution_ref * sin(Pi * pos_n[index_i][1] / DH);
+		water_block.updateCellLinkedList();
+		searched_inner.updateConfiguration();
+		skinned_inner.updateConfiguration();
+
+		for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+		{
+			StdVec<std::pair<size_t, Real>> searched = sortedNeighbors(searched_inner.inner_configuration_[index_i]);
+			StdVec<std::pair<size_t, Real>> skinned = sortedNeighbors(skinned_inner.inner_configuration_[index_i]);
+			ASSERT_EQ(searched.size(), skinned.size());
+			for (size_t n = 0; n != searched.size(); ++n)
+			{
+				EXPECT_EQ(searched[n].first, skinned[n].first);
+				EXPECT_DOUBLE_EQ(searched[n].second, skinned[n].second);
+			}
+		}
+	}
+}
+
+/** a periodic channel without skin, and the refusal of the skin for a periodic body in either order */
+TEST(test_verlet_skin, test_periodic_channel)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	WaterBlock water_block(system, "WaterBody");
+	FluidParticles fluid_particles(water_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	BodyRelationInner water_block_inner(water_block);
+	PeriodicConditionInAxisDirectionUsingCellLinkedList periodic_condition(water_block, xAxis);
+
+	system.initializeSystemCellLinkedLists();
+	periodic_condition.update_cell_linked_list_.parallel_exec();
+	system.initializeSystemConfigurations();
+
+	//- away from the walls, the particles at the periodic bounds have as many neighbors as those in the middle
+	StdLargeVec<Vecd> &pos_n = fluid_particles.pos_n_;
+	size_t total_real_particles = fluid_particles.total_real_particles_;
+	Real y_middle = 0.5 * DH - 0.5 * resolution_ref;
+	StdVec<size_t> neighbor_numbers;
+	for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+		if (fabs(pos_n[index_i][1] - y_middle) < 0.1 * resolution_ref)
+			neighbor_numbers.push_back(water_block_inner.inner_configuration_[index_i].current_size_);
+	ASSERT_EQ(neighbor_numbers.size(), size_t(DL / resolution_ref + 0.5));
+	for (size_t n = 0; n != neighbor_numbers.size(); ++n)
+		EXPECT_EQ(neighbor_numbers[n], neighbor_numbers[0]);
+
+	EXPECT_EXIT(water_block_inner.useVerletSkin(0.5 * resolution_ref), ::testing::ExitedWithCode(1), "");
+
+	WaterBlock skinned_block(system, "SkinnedWaterBody");
+	FluidParticles skinned_particles(skinned_block, makeShared<WeaklyCompressibleFluid>(rho0_f, c_f));
+	BodyRelationInner skinned_inner(skinned_block);
+	skinned_inner.useVerletSkin(0.5 * resolution_ref);
+	EXPECT_EXIT({ PeriodicConditionInAxisDirectionUsingCellLinkedList skinned_periodic_condition(skinned_block, xAxis); },
+				::testing::ExitedWithCode(1), "");
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	testing::FLAGS_gtest_death_test_style = "threadsafe";
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "image_mhd.h"
+
+using namespace SPH;
+
+/** a sphere label image is transformed and compared with the analytic signed distance */
+TEST(test_image_signed_distance, test_sphere_label)
+{
+	int width = 24;
+	int height = 28;
+	int depth = 32;
+	Real spacing = 0.5;
+	Real radius = 4.0;
+	int sphere_label = 3;
+	Vec3d center(0.5 * width * spacing, 0.5 * height * spacing, 0.5 * depth * spacing);
+
+	StdVec<unsigned char> labels(width * height * depth);
+	StdVec<Real> analytic_distance(labels.size());
+	for (int z = 0; z < depth; z++)
+		for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x++)
+			{
+				int index = z * width * height + y * width + x;
+				Real distance = (Vec3d(x, y, z) * spacing - center).norm() - radius;
+				//- another label outside the sphere must not be taken as inside
+				labels[index] = distance < 0.0 ? sphere_label : 1;
+				analytic_distance[index] = distance;
+			}
+
+	std::ofstream header_file("./sphere_label.mhd");
+	header_file << "ObjectType = Image\n"
+				<< "NDims = 3\n"
+				<< "ElementSpacing = " << spacing << " " << spacing << " " << spacing << "\n"
+				<< "DimSize = " << width << " " << height << " " << depth << "\n"
+				<< "ElementType = MET_UCHAR\n"
+				<< "ElementDataFile = sphere_label.raw\n";
+	header_file.close();
+	std::ofstream raw_file("./sphere_label.raw", std::ios::binary);
+	raw_file.write((const char *)labels.data(), labels.size());
+	raw_file.close();
+
+	ImageMHD<float, 3> image("./sphere_label.mhd");
+	image.transformToSignedDistance(sphere_label);
+
+	//- the distance is measured between voxel centers, so the error is bounded by the voxel diagonal
+	Real max_error = 0.0;
+	Real sum_error = 0.0;
+	for (size_t index = 0; index != labels.size(); ++index)
+	{
+		Real error = fabs(Real(image.get_data()[index]) - analytic_distance[index]);
+		max_error = SMAX(max_error, error);
+		sum_error += error;
+		EXPECT_EQ(analytic_distance[index] < 0.0, image.get_data()[index] < 0.0);
+	}
+	EXPECT_LT(max_error, sqrt(3.0) * spacing);
+	EXPECT_LT(sum_error / Real(labels.size()), 0.5 * spacing);
+	EXPECT_NEAR(-radius, image.get_min_value(), spacing);
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
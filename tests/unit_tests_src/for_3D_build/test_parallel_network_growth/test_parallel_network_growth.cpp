@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real sphere_radius = 1.0;
+Real resolution_ref = sphere_radius / 20.0;
+BoundingBox system_domain_bounds(Vec3d(-1.5, -1.5, -1.5), Vec3d(1.5, 1.5, 1.5));
+
+class SphereBody : public SolidBody
+{
+public:
+	SphereBody(SPHSystem &system, const std::string &body_name)
+		: SolidBody(system, body_name, makeShared<SPHAdaptation>(1.15, 1.0))
+	{
+		TriangleMeshShapeShere triangle_mesh_shape(sphere_radius, 100, Vec3d(0));
+		body_shape_.add<LevelSetShape>(this, triangle_mesh_shape);
+	}
+};
+
+/** The positions of a network grown on a sphere, sequentially or with a seed for the parallel growth. */
+struct GrownNetwork
+{
+	StdLargeVec<Vecd> positions_;
+	size_t number_of_branches_;
+};
+
+/**
+ * Check the spacing constraints imposed by the growth:
+ * a point after the first one of a branch is not too close to its predecessor,
+ * and the nearest point grown before the branch, if it is within the cell linked list search range,
+ * is on the parent or a sibling branch or is farther than the collision distance.
+ */
+void checkSpacingConstraints(GenerativeTree &tree, Real segment_length, Real search_range)
+{
+	StdLargeVec<Vecd> &pos_n = tree.pos_n_;
+	for (size_t branch_id = 1; branch_id != tree.branches_.size(); ++branch_id)
+	{
+		IndexVector &inner_particles = tree.branches_[branch_id]->inner_particles_;
+		size_t parent_id = tree.branches_[branch_id]->in_edge_;
+		IndexVector &siblings = tree.branches_[parent_id]->out_edge_;
+		for (size_t i = 0; i != inner_particles.size(); ++i)
+		{
+			size_t index_i = inner_particles[i];
+			if (i != 0)
+				EXPECT_GE((pos_n[index_i] - pos_n[inner_particles[i - 1]]).norm(), 0.5 * segment_length);
+
+			Real min_distance = Infinity;
+			size_t nearest_index = MaxSize_t;
+			for (size_t index_j = 0; index_j != inner_particles.front(); ++index_j)
+			{
+				Real distance = (pos_n[index_i] - pos_n[index_j]).norm();
+				if (distance < min_distance)
+				{
+					min_distance = distance;
+					nearest_index = index_j;
+				}
+			}
+			if (min_distance < search_range)
+			{
+				size_t nearest_branch = tree.BranchLocation(nearest_index);
+				bool is_family = nearest_branch == parent_id ||
+								 std::find(siblings.begin(), siblings.end(), nearest_branch) != siblings.end();
+				EXPECT_TRUE(is_family || min_distance >= 5.0 * segment_length);
+			}
+		}
+	}
+}
+
+GrownNetwork growNetworkOnSphere(bool parallel_growth, unsigned int seed)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	In_Output in_output(system);
+	SphereBody sphere_body(system, "NetworkOnSphere");
+	SharedPtr<ParticleGeneratorNetwork> network_generator =
+		makeShared<ParticleGeneratorNetwork>(Vecd(-1.0, 0.0, 0.0), Vecd(-0.964, 0.0, 0.266), 6, 5.0);
+	if (parallel_growth)
+		network_generator->useParallelGrowth(seed);
+	SolidParticles network_particles(sphere_body, network_generator);
+
+	GenerativeTree *tree = dynamic_cast<GenerativeTree *>(sphere_body.generative_structure_);
+	CellLinkedList *cell_linked_list = dynamic_cast<CellLinkedList *>(sphere_body.cell_linked_list_);
+	checkSpacingConstraints(*tree, sphere_body.sph_adaptation_->ReferenceSpacing(), cell_linked_list->GridSpacing());
+
+	GrownNetwork grown_network;
+	grown_network.positions_ = network_particles.pos_n_;
+	grown_network.positions_.resize(network_particles.total_real_particles_);
+	grown_network.number_of_branches_ = tree->ContainerSize();
+	return grown_network;
+}
+
+TEST(test_parallel_network_growth, test_reproducible_with_seed)
+{
+	GrownNetwork first_network = growNetworkOnSphere(true, 7);
+	GrownNetwork second_network = growNetworkOnSphere(true, 7);
+
+	EXPECT_GT(first_network.number_of_branches_, 4);
+	ASSERT_EQ(first_network.number_of_branches_, second_network.number_of_branches_);
+	ASSERT_EQ(first_network.positions_.size(), second_network.positions_.size());
+	for (size_t i = 0; i != first_network.positions_.size(); ++i)
+	{
+		for (int k = 0; k != Dimensions; ++k)
+			EXPECT_EQ(first_network.positions_[i][k], second_network.positions_[i][k]);
+	}
+}
+
+TEST(test_parallel_network_growth, test_same_constraints_as_sequential_growth)
+{
+	GrownNetwork sequential_network = growNetworkOnSphere(false, 0);
+	GrownNetwork parallel_network = growNetworkOnSphere(true, 0);
+
+	EXPECT_GT(sequential_network.number_of_branches_, 4);
+	EXPECT_GT(parallel_network.number_of_branches_, 4);
+}
+
+int main(int argc, char *argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
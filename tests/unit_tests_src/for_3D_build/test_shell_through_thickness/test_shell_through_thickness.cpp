@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+Real PL = 1.0;									  /** Length of the square plate. */
+Real PT = 0.1;									  /** Thickness of the square plate. */
+int particle_number = 4;						  /** Particle number in the direction of the length */
+Real resolution_ref = PL / (Real)particle_number; /** Initial reference particle spacing. */
+BoundingBox system_domain_bounds(Vec3d(0.0, 0.0, -0.5 * resolution_ref), Vec3d(PL, PL, 0.5 * resolution_ref));
+Real rho0_s = 1.0;
+Real Youngs_modulus = 1.3024653e6;
+Real poisson = 0.3;
+
+class PlateParticleGenerator : public ParticleGeneratorDirect
+{
+public:
+	PlateParticleGenerator() : ParticleGeneratorDirect()
+	{
+		for (int i = 0; i < particle_number; i++)
+			for (int j = 0; j < particle_number; j++)
+			{
+				Vecd position(resolution_ref * (Real(i) + 0.5), resolution_ref * (Real(j) + 0.5), 0.0);
+				positions_volumes_.push_back(std::make_pair(position, resolution_ref * resolution_ref));
+			}
+	}
+};
+
+/** gives access to the first half of the stress relaxation of a single particle */
+class ThroughThicknessIntegration : public thin_structure_dynamics::ShellStressRelaxationFirstHalf
+{
+public:
+	ThroughThicknessIntegration(BaseBodyRelationInner &inner_relation, int number_of_gaussian_points)
+		: ShellStressRelaxationFirstHalf(inner_relation, number_of_gaussian_points){};
+	void integrate(size_t index_i) { Initialization(index_i, 0.0); };
+};
+
+/** the resultants in global coordinates */
+struct ShellResultants
+{
+	Matd stress_;
+	Matd moment_;
+	Vecd shear_stress_;
+};
+
+/** reference integration through the thickness, forming the corrected second Piola-Kirchhoff stress explicitly */
+ShellResultants integrateByReference(ShellParticles &particles, ElasticSolid &material, size_t index_i,
+									 const StdVec<Real> &gaussian_points, const StdVec<Real> &gaussian_weights,
+									 Real smoothing_length)
+{
+	const Real shear_correction_factor = 5.0 / 6.0;
+	Matd &transformation_matrix = particles.transformation_matrix_[index_i];
+	Matd current_transformation_matrix = getTransformationMatrix(particles.n_[index_i]);
+	Real thickness = particles.shell_thickness_[index_i];
+
+	Matd resultant_stress(0);
+	Matd resultant_moment(0);
+	Vecd resultant_shear_stress(0);
+	for (size_t i = 0; i != gaussian_points.size(); ++i)
+	{
+		Matd F_gaussian_point = particles.F_[index_i] + gaussian_points[i] * particles.F_bending_[index_i] * thickness * 0.5;
+		Matd dF_gaussian_point_dt = particles.dF_dt_[index_i] + gaussian_points[i] * particles.dF_bending_dt_[index_i] * thickness * 0.5;
+		Matd stress_PK2_gaussian_point = material.ConstitutiveRelation(F_gaussian_point, index_i) +
+										 material.NumericalDampingRightCauchy(F_gaussian_point, dF_gaussian_point_dt, smoothing_length, index_i);
+
+		Matd cauchy_stress = current_transformation_matrix * (~transformation_matrix) *
+							 F_gaussian_point * stress_PK2_gaussian_point *
+							 (~F_gaussian_point) * transformation_matrix * (~current_transformation_matrix) / det(F_gaussian_point);
+		cauchy_stress.col(Dimensions - 1) *= shear_correction_factor;
+		cauchy_stress.row(Dimensions - 1) *= shear_correction_factor;
+		cauchy_stress[Dimensions - 1][Dimensions - 1] = 0.0;
+
+		stress_PK2_gaussian_point = det(F_gaussian_point) * SimTK::inverse(F_gaussian_point) * transformation_matrix *
+									(~current_transformation_matrix) * cauchy_stress * current_transformation_matrix *
+									(~transformation_matrix) * (~SimTK::inverse(F_gaussian_point));
+		Vecd shear_stress_PK2_gaussian_point = -stress_PK2_gaussian_point.col(Dimensions - 1);
+		Matd moment_PK2_gaussian_point = stress_PK2_gaussian_point * gaussian_points[i] * thickness * 0.5;
+
+		Real weight = 0.5 * thickness * gaussian_weights[i];
+		resultant_stress += weight * F_gaussian_point * stress_PK2_gaussian_point;
+		resultant_moment += weight * F_gaussian_point * moment_PK2_gaussian_point;
+		resultant_shear_stress += weight * F_gaussian_point * shear_stress_PK2_gaussian_point;
+	}
+	resultant_moment.col(Dimensions - 1) = Vecd(0);
+	resultant_moment.row(Dimensions - 1) = ~Vecd(0);
+	resultant_shear_stress[Dimensions - 1] = 0.0;
+
+	ShellResultants resultants;
+	resultants.stress_ = (~transformation_matrix) * resultant_stress * transformation_matrix;
+	resultants.moment_ = (~transformation_matrix) * resultant_moment * transformation_matrix;
+	resultants.shear_stress_ = (~transformation_matrix) * resultant_shear_stress;
+	return resultants;
+}
+
+/** the fused integration gives the same resultants as the reference for a deformed and tilted shell */
+void compareWithReference(int number_of_gaussian_points, const StdVec<Real> &gaussian_points,
+						  const StdVec<Real> &gaussian_weights)
+{
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	ThinStructure plate_body(system, "PlateBody", makeShared<SPHAdaptation>(1.15, 1.0));
+	SharedPtr<LinearElasticSolid> plate_material = makeShared<LinearElasticSolid>(rho0_s, Youngs_modulus, poisson);
+	ShellParticles plate_particles(plate_body, plate_material, makeShared<PlateParticleGenerator>(), PT);
+	BodyRelationInner plate_inner(plate_body);
+	ThroughThicknessIntegration through_thickness_integration(plate_inner, number_of_gaussian_points);
+	Real smoothing_length = plate_body.sph_adaptation_->ReferenceSmoothingLength();
+
+	for (size_t index_i = 0; index_i != plate_particles.total_real_particles_; ++index_i)
+	{
+		//- a distinct tilt, membrane and bending deformation and their rates for each particle
+		Real s = Real(index_i + 1) / Real(plate_particles.total_real_particles_);
+		Vecd initial_normal(0.2 * s, -0.1 * s, 1.0);
+		plate_particles.transformation_matrix_[index_i] = getTransformationMatrix(initial_normal / initial_normal.norm());
+		Matd F(1.0);
+		F[0][0] += 0.02 * s;
+		F[1][1] -= 0.01 * s;
+		F[0][1] = 0.015 * s;
+		F[1][0] = -0.005 * s;
+		F[0][2] = 0.01 * s;
+		F[1][2] = -0.02 * s;
+		plate_particles.F_[index_i] = F;
+		Matd F_bending(0);
+		F_bending[0][0] = 0.3 * s;
+		F_bending[1][1] = -0.2 * s;
+		F_bending[0][1] = 0.1 * s;
+		plate_particles.F_bending_[index_i] = F_bending;
+		plate_particles.dF_dt_[index_i] = 0.5 * s * (F - Matd(1.0));
+		plate_particles.dF_bending_dt_[index_i] = 0.5 * s * F_bending;
+
+		through_thickness_integration.integrate(index_i);
+		ShellResultants reference = integrateByReference(plate_particles, *plate_material, index_i,
+														 gaussian_points, gaussian_weights, smoothing_length);
+
+		Real stress_scale = reference.stress_.norm();
+		Real moment_scale = reference.moment_.norm();
+		Real shear_stress_scale = reference.shear_stress_.norm();
+		ASSERT_GT(stress_scale, 0.0);
+		ASSERT_GT(moment_scale, 0.0);
+		ASSERT_GT(shear_stress_scale, 0.0);
+		EXPECT_LT((plate_particles.global_stress_[index_i] - reference.stress_).norm(), 1.0e-10 * stress_scale);
+		EXPECT_LT((plate_particles.global_moment_[index_i] - reference.moment_).norm(), 1.0e-10 * moment_scale);
+		EXPECT_LT((plate_particles.global_shear_stress_[index_i] - reference.shear_stress_).norm(),
+				  1.0e-10 * shear_stress_scale);
+	}
+}
+
+TEST(test_shell_through_thickness, test_three_gaussian_points)
+{
+	compareWithReference(3, {0.0, 0.77459667, -0.77459667}, {8.0 / 9.0, 5.0 / 9.0, 5.0 / 9.0});
+}
+
+TEST(test_shell_through_thickness, test_five_gaussian_points)
+{
+	compareWithReference(5, {0.0, 0.538469, -0.538469, 0.90618, -0.90618},
+						 {0.568889, 0.478629, 0.478629, 0.236927, 0.236927});
+}
+
+int main(int argc, char *argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "counter_based_random.h"
+#include "sphinxsys.h"
+using namespace SPH;
+
+/** known-answer vectors of Philox4x32-10 from Random123 (kat_vectors) */
+TEST(test_counter_based_random, test_Philox_known_answers)
+{
+	std::array<uint32_t, 4> zero_result = CounterBasedRandom(0, 0).generate({{0, 0, 0, 0}});
+	EXPECT_EQ(0x6627e8d5u, zero_result[0]);
+	EXPECT_EQ(0xe169c58du, zero_result[1]);
+	EXPECT_EQ(0xbc57ac4cu, zero_result[2]);
+	EXPECT_EQ(0x9b00dbd8u, zero_result[3]);
+
+	std::array<uint32_t, 4> full_result = CounterBasedRandom(0xffffffff, 0xffffffff)
+											  .generate({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}});
+	EXPECT_EQ(0x408f276du, full_result[0]);
+	EXPECT_EQ(0x41c83b0eu, full_result[1]);
+	EXPECT_EQ(0xa20bc7c6u, full_result[2]);
+	EXPECT_EQ(0x6d5451fdu, full_result[3]);
+
+	std::array<uint32_t, 4> pi_result = CounterBasedRandom(0xa4093822, 0x299f31d0)
+											.generate({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}});
+	EXPECT_EQ(0xd16cfe09u, pi_result[0]);
+	EXPECT_EQ(0x94fdccebu, pi_result[1]);
+	EXPECT_EQ(0x5001e420u, pi_result[2]);
+	EXPECT_EQ(0x24126ea1u, pi_result[3]);
+}
+
+TEST(test_counter_based_random, test_uniform_range_and_reproducibility)
+{
+	CounterBasedRandom random(7, 3);
+	for (size_t index = 0; index != 1000; ++index)
+		for (size_t draw = 0; draw != 6; ++draw)
+		{
+			Real value = random.uniform(11, index, draw);
+			EXPECT_GT(value, 0.0);
+			EXPECT_LT(value, 1.0);
+			EXPECT_EQ(value, CounterBasedRandom(7, 3).uniform(11, index, draw));
+		}
+	EXPECT_NE(random.uniform(11, 5), random.uniform(12, 5));
+	EXPECT_NE(random.uniform(11, 5), CounterBasedRandom(7, 4).uniform(11, 5));
+}
+
+int main(int argc, char* argv[])
+{	
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
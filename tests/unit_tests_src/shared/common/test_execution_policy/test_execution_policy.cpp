@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "execution_policy.h"
+#include "sphinxsys.h"
+using namespace SPH;
+
+/** during tuning, all loops of an execution use the same candidate and the tuning ends with the fastest one */
+TEST(test_execution_policy, test_one_candidate_per_execution)
+{
+	size_t number_of_candidates = 6;
+	size_t samples_per_candidate = 2;
+	ExecutionPolicy execution_policy;
+	execution_policy.autotune("test_one_candidate_per_execution", samples_per_candidate);
+	EXPECT_TRUE(execution_policy.isTuning());
+
+	StdVec<Real> data(10000, 1.0);
+	size_t executions = 0;
+	while (execution_policy.isTuning())
+	{
+		execution_policy.startExecution();
+		PartitionerType partitioner_type = execution_policy.getPartitionerType();
+		size_t grain_size = execution_policy.getGrainSize();
+		for (size_t loop = 0; loop != 3; ++loop)
+		{
+			execution_policy.parallelFor(data.size(),
+										 [&](const blocked_range<size_t> &r)
+										 {
+											 for (size_t i = r.begin(); i != r.end(); ++i)
+												 data[i] = sqrt(data[i] + 1.0);
+										 });
+			EXPECT_EQ(partitioner_type, execution_policy.getPartitionerType());
+			EXPECT_EQ(grain_size, execution_policy.getGrainSize());
+		}
+		execution_policy.finishExecution();
+		executions++;
+		ASSERT_LE(executions, number_of_candidates * (samples_per_candidate + 1));
+	}
+	EXPECT_EQ(executions, number_of_candidates * (samples_per_candidate + 1));
+}
+
+/** the tuned policies are written to and read from a file, and are used without tuning again */
+TEST(test_execution_policy, test_tuned_policies_file)
+{
+	std::ofstream out_file("./tuned_policies_in.dat", std::ios::trunc);
+	out_file << "test_read_policy " << static_cast<int>(PartitionerType::Simple) << " 64\n";
+	out_file.close();
+	ExecutionPolicy::readTunedPolicies("./tuned_policies_in.dat");
+
+	ExecutionPolicy read_policy;
+	read_policy.autotune("test_read_policy");
+	EXPECT_FALSE(read_policy.isTuning());
+	EXPECT_EQ(PartitionerType::Simple, read_policy.getPartitionerType());
+	EXPECT_EQ(size_t(64), read_policy.getGrainSize());
+
+	ExecutionPolicy::writeTunedPolicies("./tuned_policies_out.dat");
+	std::ifstream in_file("./tuned_policies_out.dat");
+	std::string name;
+	int partitioner_type;
+	size_t grain_size;
+	bool is_found = false;
+	while (in_file >> name >> partitioner_type >> grain_size)
+	{
+		if (name == "test_read_policy")
+		{
+			is_found = true;
+			EXPECT_EQ(static_cast<int>(PartitionerType::Simple), partitioner_type);
+			EXPECT_EQ(size_t(64), grain_size);
+		}
+	}
+	EXPECT_TRUE(is_found);
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+#include <condition_variable>
+#include <mutex>
+
+using namespace SPH;
+
+/** blocks the calling threads until the given number of threads have arrived */
+class ThreadBarrier
+{
+public:
+	explicit ThreadBarrier(size_t number_of_threads) : waiting_threads_(number_of_threads){};
+
+	void arriveAndWait()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (--waiting_threads_ == 0)
+		{
+			all_arrived_.notify_all();
+			return;
+		}
+		all_arrived_.wait(lock, [&]()
+						  { return waiting_threads_ == 0; });
+	};
+
+protected:
+	size_t waiting_threads_;
+	std::mutex mutex_;
+	std::condition_variable all_arrived_;
+};
+
+/** a number of steps summing over a range in parallel, each step advances the physical time of the system,
+ *  the steps start when all concurrent systems are running */
+Real runSteps(SPHSystem &system, size_t number_of_threads, size_t number_of_steps,
+			  ThreadBarrier &all_systems_running, size_t &least_allowed_parallelism)
+{
+	Real sum = 0.0;
+	system.execute([&]()
+				   {
+		all_systems_running.arriveAndWait();
+		for (size_t step = 0; step != number_of_steps; ++step)
+		{
+			least_allowed_parallelism = SMIN(least_allowed_parallelism,
+				tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism));
+			sum += parallel_reduce(
+				blocked_range<size_t>(0, 100000), Real(0),
+				[&](const blocked_range<size_t> &r, Real local_sum) -> Real
+				{
+					for (size_t i = r.begin(); i != r.end(); ++i)
+						local_sum += Real(i % 7);
+					return local_sum;
+				},
+				[](Real x, Real y) -> Real { return x + y; });
+			system.PhysicalTime() += Real(number_of_threads);
+		} });
+	return sum;
+}
+
+TEST(test_concurrent_systems, test_independent_arenas)
+{
+	size_t default_parallelism = tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism);
+	BoundingBox system_domain_bounds(Vecd(0), Vecd(1));
+	size_t threads_a = 1;
+	size_t threads_b = 2;
+	SPHSystem system_a(system_domain_bounds, 0.1, threads_a);
+	SPHSystem system_b(system_domain_bounds, 0.1, threads_b);
+	//- the thread limits of both systems are released before either runs
+	system_a.useOwnPhysicalTime();
+	system_b.useOwnPhysicalTime();
+
+	size_t number_of_steps = 50;
+	size_t least_parallelism_a = std::numeric_limits<size_t>::max();
+	size_t least_parallelism_b = std::numeric_limits<size_t>::max();
+	Real sum_a = 0.0;
+	Real sum_b = 0.0;
+	ThreadBarrier all_systems_running(2);
+	std::thread thread_a([&]()
+						 { sum_a = runSteps(system_a, threads_a, number_of_steps, all_systems_running, least_parallelism_a); });
+	std::thread thread_b([&]()
+						 { sum_b = runSteps(system_b, threads_b, number_of_steps, all_systems_running, least_parallelism_b); });
+	thread_a.join();
+	thread_b.join();
+
+	//- the one-thread system must not throttle the other one
+	size_t expected_parallelism = SMIN(threads_b, default_parallelism);
+	EXPECT_GE(least_parallelism_a, expected_parallelism);
+	EXPECT_GE(least_parallelism_b, expected_parallelism);
+	EXPECT_EQ(sum_a, sum_b);
+	EXPECT_EQ(system_a.PhysicalTime(), Real(threads_a * number_of_steps));
+	EXPECT_EQ(system_b.PhysicalTime(), Real(threads_b * number_of_steps));
+	EXPECT_EQ(GlobalStaticVariables::physical_time_, 0.0);
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
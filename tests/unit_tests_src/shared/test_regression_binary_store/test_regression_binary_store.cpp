@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+/** the members of an observation used by the regression test, without a body to observe */
+struct InputFolderStandIn
+{
+	std::string input_folder_;
+};
+
+class ObservationStandIn
+{
+public:
+	Real type_indicator_;
+	InputFolderStandIn in_output_;
+	std::string body_name_;
+	std::string quantity_name_;
+	DoubleVec<Real> current_result_;
+	StdVec<std::string> element_tag_;
+
+	ObservationStandIn() : type_indicator_(0.0), in_output_{"."},
+						   body_name_("Observer"), quantity_name_("Quantity"){};
+	virtual ~ObservationStandIn(){};
+	virtual void writeToFile(size_t iteration = 0){};
+	void writeXmlToXmlFile(){};
+	void writeToXml(size_t iteration = 0){};
+	void readFromXml(){};
+};
+
+class RegressionTestStandIn : public RegressionTestBase<ObservationStandIn>
+{
+public:
+	RegressionTestStandIn() : RegressionTestBase<ObservationStandIn>(){};
+	virtual ~RegressionTestStandIn(){};
+
+	void setResult(const DoubleVec<Real> &result, int number_of_run)
+	{
+		current_result_ = result;
+		i_ = current_result_.size();
+		j_ = current_result_[0].size();
+		number_of_run_ = number_of_run;
+		transferTheIndex();
+	};
+	DoubleVec<Real> &getResultIn() { return result_in_; };
+};
+
+TEST(test_regression_binary_store, test_second_run_reads_binary)
+{
+	DoubleVec<Real> result = {{0.5, 1.25}, {-2.0, 3.75}, {4.5, -0.125}};
+	std::string xml_file = "./Observer_Quantity_Run_0_result.xml";
+	std::string runtimes_file = "./Observer_Quantity_runtimes.dat";
+	fs::remove(runtimes_file);
+	{
+		RegressionTestStandIn first_run;
+		first_run.setResult(result, 1);
+		first_run.writeResultToXml(0);
+		EXPECT_TRUE(first_run.isBinaryUpToDate(xml_file));
+	}
+	{
+		RegressionTestStandIn second_run;
+		second_run.setResult(result, 2);
+		second_run.readResultFromXml(0);
+		EXPECT_TRUE(second_run.isBinaryResultRead());
+		for (size_t j = 0; j != result[0].size(); ++j)
+			for (size_t i = 0; i != result.size(); ++i)
+				EXPECT_EQ(result[i][j], second_run.getResultIn()[j][i]);
+	}
+
+	//- an edited .xml file must be read again
+	std::ofstream xml_output(xml_file, std::ios::app);
+	xml_output << "\n";
+	xml_output.close();
+	{
+		RegressionTestStandIn third_run;
+		third_run.setResult(result, 2);
+		EXPECT_FALSE(third_run.isBinaryUpToDate(xml_file));
+		third_run.readResultFromXml(0);
+		EXPECT_FALSE(third_run.isBinaryResultRead());
+		for (size_t j = 0; j != result[0].size(); ++j)
+			for (size_t i = 0; i != result.size(); ++i)
+				EXPECT_EQ(result[i][j], third_run.getResultIn()[j][i]);
+	}
+	fs::remove(runtimes_file);
+}
+
+int main(int argc, char* argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}